@@ -0,0 +1,80 @@
+#pragma once
+
+#include "AttendanceRecord.h"
+#include <QByteArray>
+#include <QDate>
+#include <QHash>
+#include <QJsonObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// Teilnahme-Historie pro Spieler mit verzögertem Parsen. Beim Laden wird nur
+// das rohe JSON-Array eines Spielers festgehalten; AttendanceRecords entstehen
+// erst, wenn jemand die Einträge dieses Spielers anfasst. Neue Einträge werden
+// ohne Parsen hinten angehängt und beim ersten Zugriff mit dem Rohbestand
+// vereint. Typ, Name und Karte sind Symbole im StringPool; Vergleiche laufen
+// über die IDs ihrer case-gefalteten Form.
+class AttendanceHistory
+{
+public:
+    using Entries = QVector<AttendanceRecord>;
+
+    void clear();
+    bool isEmpty() const { return m_slots.isEmpty(); }
+    int playerCount() const { return m_slots.size(); }
+    // Spieler, deren Einträge bereits geparst wurden
+    int hydratedCount() const { return m_hydrated; }
+    QStringList keys() const { return m_slots.keys(); }
+    bool contains(const QString &key) const { return m_slots.contains(key); }
+
+    // Rohes JSON-Array übernehmen, geparst wird erst beim Zugriff
+    void setRaw(const QString &key, const QByteArray &jsonArray);
+    void append(const QString &key, const AttendanceRecord &record);
+    void append(const QString &key, const QJsonObject &entry) { append(key, fromJson(entry)); }
+    bool remove(const QString &key);
+
+    const Entries &entries(const QString &key) const;
+    Entries value(const QString &key) const { return entries(key); }
+
+    // Gibt es für den Spieler schon einen Eintrag mit Typ und Datum (und
+    // Name, falls angegeben)? Vergleiche ohne Rücksicht auf Groß-/Kleinschreibung.
+    // Ein Hash-Lookup; der Index eines Spielers entsteht beim Hydrieren.
+    bool hasSession(const QString &key, const QString &type, const QString &name, const QDate &date) const;
+
+    // JSON-Grenze: nur beim Laden und Speichern
+    AttendanceRecord fromJson(const QJsonObject &entry) const;
+    QJsonObject toJson(const AttendanceRecord &record) const;
+
+    // Kompaktes JSON-Array eines Spielers; unberührte Spieler werden nicht geparst
+    QByteArray rawJson(const QString &key) const;
+
+    // Top-Level-Schlüssel eines JSON-Objekts indizieren. Array-Werte landen
+    // ungeparst in der Historie, alle anderen Werte in scalars.
+    bool indexJson(const QByteArray &json, QJsonObject *scalars = nullptr);
+
+private:
+    // (gefalteter Typ, gefalteter Name oder 0, Julianischer Tag)
+    struct SessionKey
+    {
+        quint32 type;
+        quint32 name;
+        qint32 day;
+        bool operator==(const SessionKey &o) const { return type == o.type && name == o.name && day == o.day; }
+        friend size_t qHash(const SessionKey &k, size_t seed = 0) { return qHashMulti(seed, k.type, k.name, k.day); }
+    };
+    struct Slot
+    {
+        QByteArray raw;
+        Entries entries;
+        QSet<SessionKey> sessions; // erst nach dem Hydrieren gefüllt
+        bool hydrated = false;
+    };
+    void indexSession(Slot &slot, const AttendanceRecord &record) const;
+    void hydrate(Slot &slot) const;
+    Entries parseRaw(const QByteArray &raw) const;
+
+    mutable QHash<QString, Slot> m_slots;
+    mutable int m_hydrated = 0;
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "AttendanceHistory.h"
+#include <QFile>
+#include <QJsonObject>
+#include <QString>
+
+// Teilnahme-Historie als Snapshot (clan_attendance_log.json, bisheriges Format)
+// plus Append-only-Journal im JSON-Lines-Format. Jeder neue Eintrag kostet eine
+// angehängte Zeile; compact() schreibt den Snapshot atomar neu und leert das
+// Journal. Einträge tragen eine laufende Nummer, die der Snapshot als
+// "_journalSeq" mitführt, damit ein Absturz zwischen Snapshot und Leeren des
+// Journals beim Replay keine Duplikate erzeugt. Der Snapshot wird beim Laden
+// nur pro Spieler indiziert, geparst wird über AttendanceHistory bei Bedarf.
+class AttendanceJournal
+{
+public:
+    using Records = AttendanceHistory;
+
+    // Ab so vielen Journalzeilen sollte kompaktiert werden
+    static constexpr int CompactThreshold = 1000;
+
+    void setPaths(const QString &snapshotPath, const QString &journalPath);
+
+    // Snapshot laden und Journal darüber abspielen. Eine abgerissene letzte
+    // Zeile wird verworfen und abgeschnitten (nur bei beschreibbarem Journal).
+    // false, wenn Snapshot oder Journal nicht lesbar sind; compact() verweigert
+    // dann, bis load() gelingt.
+    bool load(Records &records);
+    bool append(const QString &playerKey, const QJsonObject &entry);
+    bool compact(const Records &records);
+
+    // Zustand nach dem Laden aus einem Binär-Snapshot übernehmen
+    void restore(qint64 nextSeq, int journalLines);
+    qint64 nextSequence() const { return m_nextSeq; }
+    int journalLength() const { return m_journalLines; }
+    bool needsCompaction() const { return m_journalLines >= CompactThreshold; }
+    int replayedCount() const { return m_replayed; }
+    int droppedLineCount() const { return m_dropped; }
+    QString errorString() const { return m_error; }
+
+private:
+    bool openJournal();
+    bool replayJournal(Records &records, qint64 snapshotSeq);
+
+    QString m_snapshotPath;
+    QString m_journalPath;
+    QFile m_journal;
+    qint64 m_nextSeq = 1;
+    int m_journalLines = 0;
+    int m_replayed = 0;
+    int m_dropped = 0;
+    bool m_journalUnread = false; // Journal vorhanden, aber nicht lesbar
+    QString m_error;
+};
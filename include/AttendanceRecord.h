@@ -0,0 +1,29 @@
+#pragma once
+
+#include "StringPool.h"
+#include <QDate>
+#include <QtGlobal>
+
+// Kompakter Teilnahme-Eintrag. Typ, Name und Karte sind Symbole im
+// StringPool; JSON entsteht nur beim Speichern.
+struct AttendanceRecord
+{
+    // Feste Symbol-IDs der üblichen Typen (vom StringPool vorbelegt)
+    enum Type : quint32
+    {
+        Training = 1,
+        Event = 2,
+        Reserve = 3
+    };
+
+    Symbol type = Symbol::fromId(Training);
+    Symbol name;          // leer = kein Name
+    Symbol map;           // leer = keine Karte
+    qint32 julianDay = 0; // 0 = kein gültiges Datum
+    qint64 timestamp = 0; // ms seit Epoche, 0 = keiner
+
+    bool hasDate() const { return julianDay != 0; }
+    QDate date() const { return hasDate() ? QDate::fromJulianDay(julianDay) : QDate(); }
+    void setDate(const QDate &d) { julianDay = d.isValid() ? qint32(d.toJulianDay()) : 0; }
+};
+Q_DECLARE_TYPEINFO(AttendanceRecord, Q_PRIMITIVE_TYPE);
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "PlayerList.h"
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <functional>
+
+// Streaming-Tokenizer für CSV/TSV-Dateien (UTF-8). Die Datei wird gemappt
+// (Fallback: blockweise gelesen); Felder werden direkt aus dem Bytepuffer
+// dekodiert, es bleibt immer nur der aktuelle Datensatz im Speicher.
+// Anführungszeichen am Feldanfang (sonst wörtlich), "" als Escape und
+// Zeilenumbrüche in Quotes werden unterstützt, Leerzeilen übersprungen.
+class CsvReader
+{
+public:
+    // Liefert false, um das Lesen abzubrechen.
+    using RowCallback = std::function<bool(const QStringList &fields)>;
+    // Fortschritt in Bytes, alle ProgressInterval Datensätze und am Ende
+    using ProgressCallback = std::function<void(qint64 done, qint64 total)>;
+    static constexpr int ProgressInterval = 2048;
+
+    // Trennzeichen; 0 = aus den ersten Zeilen erkennen (Tab, ; , |)
+    void setDelimiter(char delimiter) { m_delimiter = delimiter; }
+    char delimiter() const { return m_delimiter; }
+
+    void setProgressCallback(const ProgressCallback &onProgress) { m_onProgress = onProgress; }
+
+    bool readFile(const QString &path, const RowCallback &onRow);
+
+    QString errorString() const { return m_error; }
+    qint64 rowsRead() const { return m_rows; }
+    bool aborted() const { return m_aborted; }
+
+    static char detectDelimiter(const char *data, qint64 size);
+
+private:
+    // Verarbeitet vollständige Datensätze und liefert die Anzahl verbrauchter Bytes.
+    qint64 parse(const char *data, qint64 size, bool atEnd, const RowCallback &onRow);
+    static QString decodeField(const char *begin, const char *end, bool quoted);
+
+    char m_delimiter = 0;
+    ProgressCallback m_onProgress;
+    qint64 m_offset = 0; // Dateiposition von data[0] in parse()
+    qint64 m_total = 0;
+    QStringList m_fields;
+    QString m_error;
+    qint64 m_rows = 0;
+    bool m_aborted = false;
+};
+
+struct CsvImportResult
+{
+    enum Error
+    {
+        NoError,
+        OpenFailed,
+        NoRows,
+        NoNameColumn,
+        Canceled
+    };
+    Error error = NoError;
+    QString errorString;
+    int imported = 0;
+    int merged = 0;
+    int skipped = 0;
+    QStringList groups; // vorkommende Gruppen, erste Nennung zuerst
+};
+
+// Spieler-Import über CsvReader: Kopfzeile wird einmal aufgelöst, jede
+// Datenzeile sofort per addOrMerge in die Liste übernommen (importFile) oder
+// gesammelt und später gemergt (readFile + mergeInto).
+class PlayerCsvImporter
+{
+public:
+    // Wird pro Zeile abgefragt; true bricht den Import ab (Ergebnis Canceled).
+    void setCancelCheck(const std::function<bool()> &isCanceled) { m_isCanceled = isCanceled; }
+    void setProgressCallback(const CsvReader::ProgressCallback &onProgress) { m_onProgress = onProgress; }
+    // > 0: Zeilen ohne exakten Treffer in den einzigen Spieler mit ähnlichem
+    // Namen/T17-Namen (Levenshtein <= maxDistance) zusammenführen. 0 = aus.
+    void setFuzzyMergeDistance(int maxDistance) { m_fuzzyMergeDistance = maxDistance; }
+
+    bool importFile(const QString &path, PlayerList &list, CsvImportResult &result);
+    // Nur lesen (z. B. im Worker): Zeilen als Spieler sammeln, imported und
+    // merged bleiben 0. Übernahme später mit mergeInto gegen die dann aktuelle Liste.
+    bool readFile(const QString &path, QList<Player> &players, CsvImportResult &result);
+    void mergeInto(const QList<Player> &players, PlayerList &list, CsvImportResult &result) const;
+
+    static QString normalizeToken(const QString &text);
+
+private:
+    // Zeilen vor der Kopfzeile werden nur in diesem Umfang gepuffert; ohne
+    // Kopfzeile in längeren Dateien wird ein zweites Mal gelesen
+    static constexpr int MaxHeaderSearchRows = 20;
+
+    bool looksLikeHeader(const QStringList &cols) const;
+    void resolveColumns(const QStringList &headers);
+    int findColumn(const QStringList &candidates) const;
+    int findColumnByParts(const QStringList &parts) const;
+    bool readRows(const QString &path, CsvImportResult &result);
+    void importRow(const QStringList &cols, CsvImportResult &result);
+    void mergePlayer(const Player &player, PlayerList &list, CsvImportResult &result) const;
+
+    std::function<bool()> m_isCanceled;
+    std::function<void(Player &)> m_onPlayer; // Ziel der gelesenen Zeilen
+    CsvReader::ProgressCallback m_onProgress;
+    int m_fuzzyMergeDistance = 0;
+    QStringList m_normalizedHeaders;
+    QSet<Symbol> m_seenGroups;
+    int m_nameIdx = -1;
+    int m_t17Idx = -1;
+    int m_joinIdx = -1;
+    int m_rankIdx = -1;
+    int m_groupIdx = -1;
+    int m_levelIdx = -1;
+    int m_commentIdx = -1;
+    int m_nextRankIdx = -1;
+    int m_lastPromotionIdx = -1;
+    int m_trainingsTotalIdx = -1;
+    int m_trainingsRankIdx = -1;
+    int m_eventsIdx = -1;
+    int m_reserveIdx = -1;
+};
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "AttendanceHistory.h"
+#include "Player.h"
+#include "Training.h"
+#include <QDataStream>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <vector>
+
+// Versionierter Binär-Snapshot (QDataStream) von Spielern, Teilnahme-Historie
+// und Trainings für einen schnellen Kaltstart. Die Datei wird gemappt und
+// ohne JSON-DOM gelesen; die Teilnahmen liegen als rohes JSON pro Spieler
+// darin und werden erst bei Bedarf geparst. Zu jeder JSON-Quelldatei werden Größe und
+// Änderungszeit festgehalten; weicht eine davon ab, gilt der Snapshot als
+// veraltet und es wird wie bisher aus JSON geladen. JSON bleibt damit das
+// maßgebliche Format, der Snapshot ist nur ein Cache.
+class DataSnapshot
+{
+public:
+    struct Contents
+    {
+        std::vector<Player> players;
+        AttendanceHistory attendance;
+        qint64 attendanceNextSeq = 1;
+        int attendanceJournalLines = 0;
+        QList<Training> trainings;
+    };
+
+    static constexpr quint32 Magic = 0x434d534e; // "CMSN"
+    static constexpr quint32 Version = 2;
+
+    void setPaths(const QString &snapshotPath, const QStringList &sourceFiles);
+
+    bool write(const Contents &contents);
+    // false bei fehlendem, veraltetem oder beschädigtem Snapshot
+    bool read(Contents &contents);
+    bool remove();
+
+    QString errorString() const { return m_error; }
+
+private:
+    struct Stamp
+    {
+        QString fileName;
+        qint64 size = -1;
+        qint64 modified = 0;
+    };
+    QList<Stamp> currentStamps() const;
+    bool readStream(QDataStream &in, qint64 byteCount, Contents &contents);
+
+    QString m_path;
+    QStringList m_sources;
+    QString m_error;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QStringView>
+#include <QVector>
+
+// Levenshtein-Distanz für die Namenserkennung aus OCR-Text. Für Muster bis
+// 64 Zeichen bit-parallel nach Myers (eine Spalte pro Textzeichen), darüber
+// ein DP mit zwei Zeilen. Mit Schwelle wird abgebrochen, sobald sie nicht
+// mehr erreichbar ist; das Ergebnis ist dann maxDistance + 1.
+namespace EditDistance
+{
+    constexpr int NoLimit = -1;
+
+    int distance(QStringView a, QStringView b, int maxDistance = NoLimit);
+    inline bool within(QStringView a, QStringView b, int maxDistance)
+    {
+        return distance(a, b, maxDistance) <= maxDistance;
+    }
+
+    // Vorbereitetes Muster: Zeichenmasken einmal berechnen, dann gegen
+    // beliebig viele Texte vergleichen. Der Mustertext muss so lange leben.
+    class Pattern
+    {
+    public:
+        static constexpr int MaxLength = 64;
+
+        explicit Pattern(QStringView pattern);
+        bool isBitParallel() const { return m_length <= MaxLength; }
+        int length() const { return m_length; }
+        int distanceTo(QStringView text, int maxDistance = NoLimit) const;
+
+    private:
+        quint64 mask(QChar c) const;
+
+        QStringView m_pattern;
+        int m_length = 0;
+        quint64 m_ascii[128] = {};
+        QChar m_otherChars[MaxLength];
+        quint64 m_otherMasks[MaxLength] = {};
+        int m_otherCount = 0;
+    };
+
+    // Namensliste am Stück (ein Puffer, Offsets, Längen), damit ein Kandidat
+    // in einem Durchlauf gegen alle Namen geprüft werden kann. Die Längen-
+    // vorauswahl läuft über ein dichtes Array und lässt sich vektorisieren.
+    class Roster
+    {
+    public:
+        Roster() = default;
+        explicit Roster(const QStringList &names);
+
+        void clear();
+        void append(QStringView name);
+        int size() const { return m_lengths.size(); }
+        QStringView name(int index) const;
+
+        // Distanz zu jedem Namen, bzw. maxDistance + 1 für verworfene Namen
+        void distances(QStringView candidate, int maxDistance, QVector<int> &out) const;
+        // Erster Name (in Einfügereihenfolge) mit Distanz <= maxDistance, sonst -1
+        int firstWithin(QStringView candidate, int maxDistance) const;
+
+    private:
+        QVector<QChar> m_buffer;
+        QVector<int> m_offsets;
+        QVector<int> m_lengths;
+    };
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Player.h"
+#include <QDate>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+
+struct RankRequirement
+{
+    int minMonths = 0;
+    int minLevel = 0;
+    int minCombined = 0;
+};
+
+struct EligibilityResult
+{
+    bool ok = true;              // alle Anforderungen erfüllt
+    bool eligible = false;       // ok und der Rang hat überhaupt Anforderungen
+    QStringList reasons;         // was fehlt, für Tooltip/Status
+};
+
+// Beförderungsprüfung mit Cache pro Spieler. Ein Eintrag wird nur neu berechnet,
+// wenn sich seine Eingaben (Rang, Level, Beitritt, Zähler, Stichtag,
+// Anforderungs-Version) geändert haben oder er explizit als dirty markiert wurde.
+class EligibilityEngine
+{
+public:
+    // Liefert das (ggf. gecachte) Ergebnis; resultChanged meldet, ob sich eligible geändert hat.
+    const EligibilityResult &evaluate(const Player &player, const RankRequirement &req, const QDate &referenceDate, bool *resultChanged = nullptr);
+
+    void markDirty(const QString &playerKey);
+    void markAllDirty();
+    void remove(const QString &playerKey);
+    void clear();
+
+    // Nach jeder Änderung an den Rang-Anforderungen aufrufen
+    void bumpRequirementsVersion() { ++m_requirementsVersion; }
+    quint64 requirementsVersion() const { return m_requirementsVersion; }
+
+    int evaluationCount() const { return m_evaluations; }
+
+    static int monthsBetween(const QDate &joinDate, const QDate &referenceDate);
+
+private:
+    struct Inputs
+    {
+        Symbol rank;
+        int level = 0;
+        QDate joinDate;
+        int attendance = 0;
+        int events = 0;
+        int reserve = 0;
+        QDate referenceDate;
+        quint64 requirementsVersion = 0;
+
+        bool operator==(const Inputs &o) const
+        {
+            return level == o.level && attendance == o.attendance && events == o.events && reserve == o.reserve && requirementsVersion == o.requirementsVersion && joinDate == o.joinDate && referenceDate == o.referenceDate && rank == o.rank;
+        }
+    };
+    struct Entry
+    {
+        Inputs inputs;
+        EligibilityResult result;
+        bool dirty = true;
+    };
+
+    QHash<QString, Entry> m_cache;
+    quint64 m_requirementsVersion = 0;
+    int m_evaluations = 0;
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// BK-Baum über Namensschlüssel für "alle Namen mit Distanz <= k". Jeder
+// Knoten merkt sich seine Kinder nach Levenshtein-Distanz; eine Suche steigt
+// nur in Kinder mit Distanz in [d - k, d + k] ab und vergleicht so nur einen
+// Bruchteil der Namen. Ein Schlüssel kann mehreren Werten (Spielernamen)
+// gehören; entfernte Schlüssel bleiben als leere Knoten im Baum.
+// Schlüssel werden unverändert verglichen, normalisieren muss der Aufrufer.
+class FuzzyNameIndex
+{
+public:
+    struct Match
+    {
+        QString key;
+        QString value; // erster Wert des Schlüssels
+        int distance = 0;
+    };
+
+    void clear();
+    bool isEmpty() const { return m_liveKeys == 0; }
+    int size() const { return m_liveKeys; }
+
+    void insert(const QString &key, const QString &value);
+    void remove(const QString &key, const QString &value);
+    bool contains(const QString &key) const;
+    // Erster Wert zum exakten Schlüssel, sonst leer
+    QString value(const QString &key) const;
+
+    // Nach Distanz, dann Schlüssel sortiert
+    QVector<Match> within(const QString &query, int maxDistance) const;
+    bool nearest(const QString &query, int maxDistance, Match *out = nullptr) const;
+
+    // Für Tests/Messungen: Distanzberechnungen der letzten Suche
+    int lastComparisonCount() const { return m_lastComparisons; }
+
+private:
+    struct Node
+    {
+        QString key;
+        QStringList values;                // leer = entfernt
+        QVector<QPair<int, int>> children; // (Distanz, Knotenindex)
+    };
+
+    QVector<Node> m_nodes;
+    QHash<QString, int> m_byKey;
+    int m_liveKeys = 0;
+    mutable int m_lastComparisons = 0;
+};
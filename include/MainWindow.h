@@ -1,29 +1,34 @@
 #pragma once
 
 #include <QMainWindow>
-#include <QStandardItemModel>
 #include "PlayerList.h"
+#include "PlayerTableModel.h"
+#include "EligibilityEngine.h"
+#include "CsvReader.h"
+#include "PersistenceScheduler.h"
+#include "AttendanceJournal.h"
+#include "SoldbuchLog.h"
+#include "DataSnapshot.h"
+#include "RosterTextParser.h"
 
 #include <QStringList>
 #include <QJsonObject>
 #include "Training.h"
 #include <QLabel>
 #include <QColor>
+#include <QBrush>
 #include <QPixmap>
 #include <QSet>
 #include <QListWidget>
-
-struct RankRequirement
-{
-    int minMonths = 0;
-    int minLevel = 0;
-    int minCombined = 0;
-};
+#include <memory>
 
 class QTableView;
 class QPushButton;
 class QSortFilterProxyModel;
 class QLineEdit;
+class QTimer;
+class OcrService;
+struct OcrResult;
 class QComboBox;
 class QCheckBox;
 class QDateEdit;
@@ -31,6 +36,8 @@ class QLabel;
 class TrainingButtonDelegate;
 class QGroupBox;
 class QTreeWidget;
+template <typename T>
+class QFutureWatcher;
 
 class MainWindow : public QMainWindow
 {
@@ -43,6 +50,7 @@ class MainWindow : public QMainWindow
     friend class CommentDelegate;
     friend class PromotionDelegate;
     friend class ActionButtonDelegate;
+    friend class PlayerTableModel;
 
 public:
     MainWindow(QWidget *parent = nullptr);
@@ -55,6 +63,23 @@ public:
 
     // Test-Hilfen
     bool importCsvFile(const QString &filePath, int *outImported = nullptr, int *outMerged = nullptr, int *outSkipped = nullptr); // nicht interaktiv
+    // Datei wird im Thread-Pool gelesen; die Zeilen werden danach im GUI-Thread in die
+    // dann aktuelle Liste gemergt (Änderungen während des Imports bleiben erhalten).
+    // Liefert false, wenn bereits ein Import läuft. Ende über csvImportFinished.
+    bool importCsvFileAsync(const QString &filePath);
+    void cancelCsvImport();
+    bool isCsvImportRunning() const;
+    const CsvImportResult &lastCsvImportResult() const { return csvImportResult; }
+    PersistenceScheduler &persistenceScheduler() { return persistence; }
+    // Binär-Snapshot für den nächsten Start schreiben (läuft auch bei aboutToQuit)
+    bool writeDataSnapshot();
+    bool startedFromSnapshot() const { return startupFromSnapshot; }
+    qint64 startupLoadMsecs() const { return startupLoadTime; }
+    // Spieler, deren Historie seit dem Start tatsächlich geparst wurde
+    int attendanceHydratedCount() const { return attendanceRecords.hydratedCount(); }
+    int soldbuchHydratedCount() const { return soldbuchLog.hydratedPlayerCount(); }
+    static constexpr const char *PlayersStore = "players";
+    static constexpr const char *AttendanceStore = "attendance";
     bool isPlayerFlaggedNoResponse(const QString &playerName) const;                                                              // rotes X im Status
     QMap<QString, QStringList> groupingSnapshot() const;                                                                          // Gruppe -> Spielernamen
     QString readErrorLogContents() const;                                                                                         // gesamter Log-Inhalt
@@ -64,6 +89,10 @@ public:
     int noResponseThresholdValue() const { return noResponseThreshold; }
     void testRebuildModel();
     void testAppendErrorLog(const QString &source, const QString &message) { appendErrorLog(source, message); }
+    // Suche: Tipp-Pause einstellen, eine anstehende Suche sofort ausführen, Zeilen nach Filter
+    void setSearchDebounceInterval(int msecs);
+    void flushPendingSearch();
+    int visiblePlayerCount() const;
 
     // Validation helpers
     int monthsRequiredForRank(const QString &rank);
@@ -71,6 +100,10 @@ public:
     void validateAllRows();
     bool validateRow(int row, QString *outReason = nullptr);
 
+signals:
+    void csvImportProgress(int percent);
+    void csvImportFinished(bool ok);
+
 private slots:
     void showSettingsDialog();
     void editRankRequirements();
@@ -88,6 +121,7 @@ private slots:
 
 private:
     QMap<QString, RankRequirement> rankRequirements; // configurable requirements per rank
+    EligibilityEngine eligibility;                   // Cache der Beförderungsprüfung pro Spieler
     void loadRankRequirements();
     void saveRankRequirements();
     RankRequirement requirementForRank(const QString &rank) const;
@@ -101,9 +135,11 @@ private slots:
 
 private:
     QTableView *table = nullptr;
-    QStandardItemModel *model = nullptr;
+    PlayerTableModel *model = nullptr;
     QSortFilterProxyModel *proxy = nullptr;
     QLineEdit *searchEdit = nullptr;
+    QTimer *searchDebounce = nullptr; // sammelt Tastendrücke vor dem Filtern
+    static constexpr int SearchDebounceMsecs = 150;
     QComboBox *rankFilterCombo = nullptr;
     QComboBox *filterModeCombo = nullptr;
     QComboBox *groupFilterCombo = nullptr;
@@ -138,9 +174,23 @@ private:
     QString backgroundImagePath;
     QSet<QString> sessionSelectedPlayers;
     // structured attendance records: each entry is an object with at least { date, type, trainingId? }
-    QMap<QString, QList<QJsonObject>> attendanceRecords; // playerKey -> list of attendance objects
+    AttendanceHistory attendanceRecords;                 // playerKey -> Teilnahmen, erst bei Zugriff geparst
+    AttendanceJournal attendanceJournal;                 // Snapshot + Append-Journal für attendanceRecords
     QStringList commentOptions;                          // selectable comment entries saved to attendance log
-    QMap<QString, QList<QJsonObject>> soldbuchRecords;   // playerKey -> list of soldbuch entries
+    SoldbuchLog soldbuchLog;                             // Append-Log + Offset-Index, Einträge bei Bedarf
+    DataSnapshot dataSnapshot;                           // Kaltstart-Cache für Spieler, Teilnahmen, Trainings
+    const DataSnapshot::Contents *startupSnapshot = nullptr; // nur während loadDataFiles gesetzt
+    bool startupFromSnapshot = false;
+    qint64 startupLoadTime = -1;
+    OcrService *ocrService = nullptr; // Texterkennung im Hintergrund, ein Worker-Pool für alle Dialoge
+    quint64 sessionOcrJob = 0;        // laufende Erkennung des Session-Uploads, 0 = keine
+    // Wertet OCR-Text für beide Upload-Dialoge aus, im Worker von ocrService
+    const std::shared_ptr<const RosterTextParser> rosterParser = std::make_shared<const RosterTextParser>(rankOptions());
+    // Startet die Erkennung mit Fortschrittsdialog (abbrechbar) über parent;
+    // mehrere Bilder laufen als ein Stapel mit zusammengeführtem Ergebnis
+    quint64 startOcrJob(QWidget *parent, const QStringList &imagePaths);
+    // Zeigt Fehler an; true, wenn das Ergebnis nicht verwertbar ist
+    bool reportOcrError(QWidget *parent, const OcrResult &result);
 
     // App Settings
     int noResponseThreshold = 10;
@@ -153,6 +203,10 @@ private:
     bool incrementCounterOnNoResponse = true;
     bool resetCounterOnResponse = true;
     bool showCounterInTable = true;
+    bool useBinarySnapshot = true;
+    bool incrementalSearch = true;
+    bool csvFuzzyMerge = false; // CSV-Import mit Fuzzy-Toleranz zusammenführen
+    bool ocrPreprocess = true;  // Screenshots vor der Texterkennung zuschneiden und binarisieren
     QString hintColumnName = "Hinweis";
 
     void loadSettings();
@@ -182,11 +236,22 @@ private:
     void showCreateLineupDialog();
 
     void loadPlayers();
-    void savePlayers();
+    void savePlayers(); // merkt nur vor, siehe persistence
+    void writePlayersFile();
     void loadGroupColors();
     void saveGroupColors();
     void updateGroupDecorations();
     QColor colorForGroup(const QString &groupName) const;
+    bool groupBrushes(const QString &groupName, QBrush &background, QBrush &foreground) const;
+    struct GroupDecoration
+    {
+        QBrush background;
+        QBrush foreground;
+        bool valid = false;
+    };
+    GroupDecoration computeGroupDecoration(const QString &groupName) const;
+    void invalidateGroupDecorationCache();
+    mutable QHash<QString, GroupDecoration> groupDecorationCache; // Gruppe -> Pinsel, gefüllt bei Bedarf
     void applySortSettings();
     void refreshSessionTemplates();
     void applySessionTemplateSelection();
@@ -203,20 +268,31 @@ private:
     bool playerHasSessionRecord(const QString &playerKey, const QString &type, const QString &name, const QDate &date) const;
     void refreshGroupFilterCombo();
     bool ensureGroupRegistered(const QString &groupName, const QString &category = QString());
+    bool runCsvImport(const QString &filePath, const QString &source, CsvImportResult &result);
+    void applyCsvImport(const CsvImportResult &result);
+    void finishCsvImportAsync();
+    void showCsvImportResult(const CsvImportResult &result);
+    struct CsvImportOutcome
+    {
+        CsvImportResult result;
+        QList<Player> players; // gelesene Zeilen, noch nicht gemergt
+    };
+    QFutureWatcher<CsvImportOutcome> *csvImportWatcher = nullptr;
+    CsvImportResult csvImportResult;
     void loadAttendance();
     void saveAttendance();
+    void writeAttendanceFile();
     void recordAttendance();
     void appendAttendanceLog(const QString &playerKey, const QString &type, const QDateTime &when, const QString &trainingId = QString(), const QString &map = QString());
     void appendSoldbuchEntry(const QString &playerKey, const QString &kind, const QJsonObject &data, const QDateTime &when);
     void loadSoldbuch();
-    void saveSoldbuch();
     void saveAttendancePercentToSoldbuch(const QString &playerKey, int percent, const QDateTime &when);
     void showSoldbuchDialogForPlayer(const QString &playerKey, const QString &playerName);
     bool playerContextForRow(int sourceRow, QString &playerKey, QString &playerName) const;
 
     void refreshModelFromList();
     Player playerFromModelRow(int row) const;
-    void addPlayerToModel(const Player &p);
+    int addPlayerToModel(const Player &p); // hängt an list und model an, liefert die Zeile
     QString formatTrainingDisplay(const Player &player) const;
     QString trainingTooltip(const Player &player) const;
     QString formatRankDisplay(const Player &player, bool eligible) const;
@@ -288,4 +364,8 @@ private:
     // Initialization helpers (added to fix startup crash)
     void initializeUI();
     void loadDataFiles();
+
+    // Zuletzt deklariert: wird zuerst zerstört und schreibt offene Änderungen,
+    // solange alle anderen Member noch leben.
+    PersistenceScheduler persistence;
 };
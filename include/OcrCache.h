@@ -0,0 +1,62 @@
+#pragma once
+
+#include "OcrService.h"
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+// Ergebnis-Cache der Texterkennung auf der Platte, eine Datei pro Eintrag
+// (versionierter QDataStream wie DataSnapshot). Der Schlüssel besteht aus dem
+// Hash des Bildinhalts, der Sprache und der Tesseract-Version; ein erneut
+// hochgeladener Screenshot wird damit ohne Tesseract beantwortet. Gespeichert
+// werden Text, Zeilen samt Konfidenz und die Auswertung (OcrResult::roster).
+// Überschreitet der Cache maxBytes, fliegen die am längsten nicht benutzten
+// Einträge raus. Die Methoden sind threadsicher (Aufrufe aus den Workern).
+class OcrCache
+{
+public:
+    static constexpr quint32 Magic = 0x434d4f43; // "CMOC"
+    static constexpr quint32 Version = 3;
+    static constexpr qint64 DefaultMaxBytes = 8 * 1024 * 1024;
+
+    explicit OcrCache(const QString &directory, qint64 maxBytes = DefaultMaxBytes);
+
+    // <AppData>/ocr-cache
+    static QString defaultDirectory();
+    // SHA-256 des Dateiinhalts; leer, wenn die Datei nicht lesbar ist
+    static QByteArray imageHash(const QString &imagePath);
+    static QString key(const QByteArray &imageHash, const QString &language, const QString &engineVersion);
+
+    // Bei Treffer werden Text und Auswertung in result übernommen
+    // (job und imagePath bleiben), fromCache wird gesetzt
+    bool lookup(const QString &key, OcrResult &result);
+    bool store(const QString &key, const OcrResult &result);
+    void clear();
+
+    void setMaxBytes(qint64 maxBytes);
+    qint64 maxBytes() const;
+    qint64 sizeBytes() const;
+    int count() const;
+    QString directory() const { return m_dir; }
+
+private:
+    struct Item
+    {
+        qint64 size = 0;
+        qint64 lastUsed = 0; // ms seit Epoch, streng steigend vergeben
+    };
+    QString filePath(const QString &key) const;
+    void loadIndexLocked() const;
+    void evictLocked();
+    qint64 nextStampLocked();
+
+    mutable QMutex m_mutex;
+    QString m_dir;
+    qint64 m_maxBytes;
+    // Index der Platte, beim ersten Zugriff eingelesen
+    mutable bool m_indexed = false;
+    mutable QHash<QString, Item> m_items;
+    mutable qint64 m_totalBytes = 0;
+    mutable qint64 m_lastStamp = 0;
+};
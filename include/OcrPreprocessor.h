@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QImage>
+#include <QRect>
+
+// Bildvorbereitung vor der Texterkennung: Graustufen, Zuschnitt auf den
+// Bereich mit Text (die Liste statt Fensterrahmen und Seitenleisten),
+// Vergrößern kleiner Schrift und Binarisieren nach Otsu, dunkle Schrift auf
+// hellem Grund. Die Pixel-Kernel arbeiten mit SSE2 bzw. NEON, sonst skalar.
+namespace OcrPreprocessor
+{
+    // Teil des OCR-Cache-Schlüssels; bei Änderungen am Verfahren erhöhen
+    constexpr int Version = 1;
+
+    struct Options
+    {
+        bool crop = true;
+        bool binarize = true;
+        int minTextHeight = 20;    // darunter wird vergrößert ...
+        int targetTextHeight = 32; // ... bis etwa auf diese Zeilenhöhe
+        int maxScale = 4;
+    };
+
+    struct Result
+    {
+        QImage image;       // Format_Grayscale8; leer, wenn die Quelle leer ist
+        QRect region;       // Ausschnitt in Koordinaten der Quelle
+        double scale = 1.0; // Vergrößerung nach dem Zuschnitt
+        int textHeight = 0; // geschätzte Zeilenhöhe in der Quelle, 0 = unbekannt
+        int threshold = -1; // Otsu-Schwelle, -1 ohne Binarisierung
+        bool inverted = false;
+    };
+
+    Result process(const QImage &source, const Options &options = Options());
+
+    // Kernel, einzeln für Tests und Benchmarks
+    // Luma aus ARGB32/RGB32 (BT.601, ganzzahlig: (77 R + 150 G + 29 B + 128) >> 8)
+    void toGray(const quint32 *argb, quint8 *gray, int count);
+    // dst = src > level ? 255 : 0, mit invert umgekehrt
+    void threshold(const quint8 *src, quint8 *dst, int count, quint8 level, bool invert);
+    // mask[x] = 1, wenn |row[x + 1] - row[x]| > minDelta; liefert die Anzahl
+    int edgeMask(const quint8 *row, quint8 *mask, int width, quint8 minDelta);
+    // Zählt zu hist (256 Einträge) hinzu, damit Zeilen einzeln kommen können
+    void histogram(const quint8 *src, int count, quint32 *hist);
+    int otsuThreshold(const quint32 *hist);
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QMetaType>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <memory>
+#include "RosterTextParser.h"
+
+template <typename T>
+class QFutureWatcher;
+struct OcrEnginePool;
+class OcrCache;
+
+struct OcrResult
+{
+    enum Error
+    {
+        NoError,
+        EngineMissing,   // Tesseract nicht gefunden / nicht startbar
+        LanguageMissing, // Sprachdaten für die Sprache fehlen
+        ImageUnreadable,
+        Failed,
+        Canceled
+    };
+    quint64 job = 0;
+    QString imagePath;
+    Error error = NoError;
+    QString errorString;
+    QString text;
+    QStringList lines;      // nicht-leere, getrimmte Zeilen
+    QList<int> confidence;  // je Zeile 0..100, -1 = unbekannt
+    // lines ausgewertet (OcrService::setRosterParser), im Worker und mit gecacht
+    RosterTextParser::Result roster;
+    bool fromCache = false;
+
+    bool ok() const { return error == NoError; }
+};
+Q_DECLARE_METATYPE(OcrResult)
+
+// Texterkennung im Hintergrund. Aufträge laufen auf einem Pool dauerhaft
+// lebender Worker-Threads (einer pro Kern). Jeder Auftrag leiht sich eine
+// Engine (geladene Sprache) aus einem Vorrat und gibt sie danach zurück,
+// damit sie nicht pro Bild neu entsteht. Mit CLANMANAGER_HAVE_TESSERACT läuft
+// Tesseract im Prozess, sonst wird das Kommandozeilenprogramm gestartet.
+// Mit einem OcrCache werden bereits erkannte Bilder ohne Tesseract beantwortet.
+// Ergebnis und Fortschritt kommen im GUI-Thread über Signale an.
+class OcrService : public QObject
+{
+    Q_OBJECT
+public:
+    explicit OcrService(QObject *parent = nullptr);
+    ~OcrService() override;
+
+    void setLanguage(const QString &language);
+    QString language() const { return m_language; }
+    // Nur für den Kommandozeilen-Weg (Standard: "tesseract" aus PATH)
+    void setProgram(const QString &program);
+    static bool hasInProcessEngine();
+    // Bild vor der Erkennung zuschneiden und binarisieren (OcrPreprocessor)
+    void setPreprocessing(bool enabled);
+    bool preprocessing() const { return m_preprocess; }
+    // Ohne Cache (Standard) wird jedes Bild neu erkannt
+    void setCache(const std::shared_ptr<OcrCache> &cache);
+    std::shared_ptr<OcrCache> cache() const { return m_cache; }
+    // Wertet jedes Ergebnis aus (Standard: ohne Ränge); gilt für neue Aufträge
+    void setRosterParser(const std::shared_ptr<const RosterTextParser> &parser);
+    std::shared_ptr<const RosterTextParser> rosterParser() const { return m_roster; }
+
+    // Liefert die Auftragsnummer; das Ergebnis kommt über finished()
+    quint64 recognize(const QString &imagePath);
+    // Mehrere Seiten parallel erkennen; finished() kommt einmal mit dem
+    // zusammengeführten Ergebnis (siehe mergePages) unter der Stapelnummer
+    quint64 recognizeBatch(const QStringList &imagePaths);
+    void cancel(quint64 job);
+    void cancelAll();
+    int pendingCount() const { return m_jobs.size(); }
+    int workerCount() const { return m_pool.maxThreadCount(); }
+
+    // Führt Seiten in Reihenfolge zusammen: Abschnitte (Akzeptiert, Tank,
+    // Abgelehnt) laufen über Seitengrenzen weiter, doppelte Namen werden
+    // entfernt und behalten den Abschnitt mit der höchsten Konfidenz;
+    // roster wird für die zusammengeführten Zeilen neu ausgewertet
+    static OcrResult mergePages(const QList<OcrResult> &pages, const RosterTextParser &parser = RosterTextParser());
+
+signals:
+    void progress(quint64 job, int percent);
+    void finished(const OcrResult &result);
+
+private:
+    struct Batch
+    {
+        QList<quint64> jobs;
+        QList<OcrResult> pages;
+        QList<int> percent;
+        int remaining = 0;
+    };
+
+    quint64 submit(const QString &imagePath);
+    void pageFinished(const OcrResult &page);
+
+    QString m_language = QStringLiteral("deu");
+    QString m_program = QStringLiteral("tesseract");
+    bool m_preprocess = false;
+    quint64 m_nextJob = 1;
+    QThreadPool m_pool;
+    std::shared_ptr<OcrEnginePool> m_engines; // nur in Worker-Threads benutzt
+    std::shared_ptr<OcrCache> m_cache;
+    std::shared_ptr<const RosterTextParser> m_roster;
+    QHash<quint64, QFutureWatcher<OcrResult> *> m_jobs;
+    QHash<quint64, Batch> m_batches;
+    QHash<quint64, quint64> m_batchOfJob; // Seitenauftrag -> Stapel
+};
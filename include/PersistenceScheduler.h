@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <functional>
+
+// Bündelt Schreibzugriffe auf die Datendateien. markDirty() merkt einen
+// Speicher nur vor; geschrieben wird einmal pro Debounce-Fenster (0 ms =
+// nächster Durchlauf der Event-Loop), spätestens bei aboutToQuit bzw. im
+// Destruktor. Flush-Zähler und Schreibdauern sind für Tests abfragbar.
+class PersistenceScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    using Writer = std::function<void()>;
+
+    explicit PersistenceScheduler(QObject *parent = nullptr);
+    ~PersistenceScheduler() override;
+
+    void registerStore(const QString &store, const Writer &writer);
+
+    void markDirty(const QString &store);
+    bool isDirty(const QString &store) const;
+    bool hasPending() const;
+
+    // Schreibt sofort, falls vorgemerkt
+    void flush(const QString &store);
+    void flushAll();
+
+    void setDebounceInterval(int msec);
+    int debounceInterval() const { return m_timer.interval(); }
+
+    int markCount(const QString &store) const;
+    int flushCount(const QString &store) const;
+    qint64 lastFlushNsecs(const QString &store) const;
+    qint64 totalFlushNsecs(const QString &store) const;
+    void resetStats();
+
+signals:
+    void flushed(const QString &store, qint64 nsecs);
+
+private:
+    struct Store
+    {
+        Writer writer;
+        bool dirty = false;
+        int marks = 0;
+        int flushes = 0;
+        qint64 lastNsecs = 0;
+        qint64 totalNsecs = 0;
+    };
+
+    void flushStore(const QString &name, Store &store);
+
+    QHash<QString, Store> m_stores;
+    QTimer m_timer;
+    bool m_flushing = false;
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "StringPool.h"
 #include <QString>
 #include <QDate>
 
@@ -8,7 +9,7 @@ struct Player
     QString name;
     QString t17name;
     int level = 0;
-    QString group;
+    Symbol group;
     int attendance = 0;      // trainings seit letzter Beförderung
     int totalAttendance = 0; // trainings gesamt
     int events = 0;
@@ -17,9 +18,9 @@ struct Player
     int totalReserve = 0;
     QString comment;
     QDate joinDate;
-    QString rank; // Dienstrang, chosen from combo
+    Symbol rank; // Dienstrang, chosen from combo
     QDate lastPromotionDate;
-    QString nextRank;
+    Symbol nextRank;
     int noResponseCounter = 0; // Zählt fehlende An-/Abmeldungen
 
     QString toCsvLine() const;
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <QBitArray>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+// Filterindex über die Tabellenzeilen. Gruppe und Dienstrang liegen als
+// Bitset pro Symbol-ID vor, Name, T17-Name und Gruppe als case-gefaltete
+// Trigramme mit sortierten Zeilenlisten. Eine Textsuche schneidet die Listen
+// der Trigramme der Anfrage und prüft nur die verbleibenden Kandidaten.
+// Zeilen werden einzeln gesetzt; nach Einfügen/Entfernen neu aufbauen.
+class PlayerFilterIndex
+{
+public:
+    struct Row
+    {
+        QString name;
+        QString t17name;
+        QString group;
+        quint32 groupId = 0;
+        quint32 rankId = 0;
+    };
+
+    // Leert den Index und legt rows leere Zeilen an
+    void reset(int rows = 0);
+    int rowCount() const { return m_rows.size(); }
+    void setRow(int row, const Row &data);
+
+    QBitArray all() const { return QBitArray(m_rows.size(), true); }
+    QBitArray matchGroup(quint32 groupId) const;
+    QBitArray matchRanks(const QSet<quint32> &rankIds) const;
+    // Teilstring in Name, T17-Name oder Gruppe, ohne Groß-/Kleinschreibung
+    QBitArray matchText(const QString &query) const;
+    // Wie matchText, prüft aber nur die in within gesetzten Zeilen. Für
+    // Anfragen, die die vorige verlängern: deren Treffer sind eine Obermenge.
+    QBitArray refineText(const QString &query, const QBitArray &within) const;
+
+    // Für Tests/Messungen: wie viele Zeilen die letzte Textsuche direkt prüfen musste
+    int lastCandidateCount() const { return m_lastCandidates; }
+
+private:
+    struct Folded
+    {
+        QString name;
+        QString t17name;
+        QString group;
+        quint32 groupId = 0;
+        quint32 rankId = 0;
+    };
+    static quint64 trigramKey(const QChar *s);
+    static void collectTrigrams(const QString &folded, QSet<quint64> &out);
+    static QSet<quint64> trigramsOf(const Folded &row);
+    void setBit(QHash<quint32, QBitArray> &bits, quint32 id, int row, bool on);
+    void addPosting(quint64 key, int row);
+    void removePosting(quint64 key, int row);
+    bool rowContains(int row, const QString &foldedQuery) const;
+
+    QVector<Folded> m_rows;
+    QHash<quint32, QBitArray> m_groupBits;
+    QHash<quint32, QBitArray> m_rankBits;
+    QHash<quint64, QVector<int>> m_postings;
+    mutable int m_lastCandidates = 0;
+};
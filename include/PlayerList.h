@@ -1,16 +1,67 @@
 #pragma once
 
 #include "Player.h"
+#include "FuzzyNameIndex.h"
 #include <vector>
+#include <QHash>
 #include <QString>
 
+// Spielerliste mit Hash-Indizes auf Name, T17-Name und case-gefaltetem Namen.
+// Lesen über `players` ist frei; Einfügen, Umbenennen und Entfernen muss über
+// die Methoden laufen, damit die Indizes konsistent bleiben. Wer `players`
+// direkt umbaut, ruft danach reindex() auf.
+// Der Fuzzy-Index (BK-Baum über gefaltete Namen und T17-Namen) entsteht erst
+// bei der ersten unscharfen Suche und wird danach pro Änderung nachgeführt.
 class PlayerList
 {
 public:
     std::vector<Player> players;
 
     void clear();
+    void reserve(int count);
     void addOrMerge(const Player &p);
+    // Führt p in den Spieler an index zusammen (Namen bleiben unverändert)
+    void mergeAt(int index, const Player &p);
+    // Hängt ohne Merge an und liefert den neuen Index.
+    int append(const Player &p);
+    // Ersetzt den Spieler an index (auch bei geändertem Namen/T17-Namen).
+    void replace(int index, const Player &p);
+    bool rename(const QString &oldName, const QString &newName);
+    void removeAt(int index);
+    bool removeByName(const QString &name);
+    void reindex();
+
+    // Lookups liefern den ersten Treffer in Listenreihenfolge bzw. -1.
+    int indexOfName(const QString &name) const;
+    int indexOfT17(const QString &t17name) const;
+    // Vergleich auf getrimmtem, case-gefaltetem Namen.
+    int indexOfNameInsensitive(const QString &name) const;
+
+    Player *findByName(const QString &name);
+    const Player *findByName(const QString &name) const;
+    Player *findByT17(const QString &t17name);
+    Player *findByNameInsensitive(const QString &name);
+
+    // Schlüssel sind foldKey(name) bzw. foldKey(t17name), Werte Spielernamen
+    const FuzzyNameIndex &fuzzyIndex() const;
+    // Index des einzigen Spielers mit Name oder T17-Name in Distanz <= maxDistance;
+    // -1 bei keinem oder mehreren Kandidaten
+    int indexOfNameFuzzy(const QString &name, int maxDistance) const;
+
     QString toCsv() const;
     void fromCsv(const QString &text);
+
+    static QString foldKey(const QString &name);
+
+private:
+    void indexPlayer(int index);
+    void rebuildHashes();
+    void addFuzzyKeys(const Player &p) const;
+    void removeFuzzyKeys(const Player &p) const;
+
+    QHash<QString, int> m_byName;
+    QHash<QString, int> m_byT17;
+    QHash<QString, int> m_byFolded;
+    mutable FuzzyNameIndex m_fuzzy;
+    mutable bool m_fuzzyBuilt = false;
 };
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "PlayerList.h"
+#include <QAbstractTableModel>
+#include <QStringList>
+#include <QVector>
+
+class MainWindow;
+
+// Tabellenmodell direkt auf der PlayerList: Zeile == Index in players.
+// Anzeige (Einsätze, Dienstrang, Status, Gruppenfarben) wird erst in data() berechnet.
+// Strukturänderungen an der Liste laufen über appendPlayer/removePlayerAt oder
+// werden nach Massenänderungen mit resetFromList() nachgezogen.
+class PlayerTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+public:
+    enum Column
+    {
+        NameColumn,
+        StatusColumn,
+        T17Column,
+        LevelColumn,
+        GroupColumn,
+        TrainingColumn,
+        CommentColumn,
+        JoinDateColumn,
+        RankColumn,
+        ActionColumn,
+        ColumnCount
+    };
+    static constexpr int PlayerKeyRole = Qt::UserRole + 1;
+    // Symbol-ID von Gruppe bzw. Dienstrang für Vergleiche ohne Strings
+    static constexpr int SymbolRole = Qt::UserRole + 2;
+
+    PlayerTableModel(PlayerList *players, MainWindow *main, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    bool setHeaderData(int section, Qt::Orientation orientation, const QVariant &value, int role = Qt::EditRole) override;
+
+    void resetFromList();
+    int appendPlayer(const Player &p);
+    bool removePlayerAt(int row);
+
+    // Sammelbetrieb: appendPlayer() hängt nur an die Liste an, endBatch()
+    // meldet alle neuen Zeilen mit einem einzigen rowsInserted.
+    void beginBatch();
+    void endBatch();
+
+    // Meldet geänderte Spielerdaten an die Views (Spaltenbereich inklusive).
+    void playerChanged(int row, int firstColumn = 0, int lastColumn = ColumnCount - 1);
+    void columnChanged(int column, const QList<int> &roles = {});
+
+    bool isEligible(int row) const;
+    void setEligible(int row, bool eligible);
+
+signals:
+    // Nach einer Bearbeitung in der Tabelle (z.B. über einen Delegate)
+    void playerEdited(int row);
+
+private:
+    const Player *playerAt(int row) const;
+
+    PlayerList *m_players = nullptr;
+    MainWindow *m_main = nullptr;
+    int m_rowCount = 0;
+    int m_batchDepth = 0;
+    QVector<bool> m_eligible;
+    QStringList m_headers;
+};
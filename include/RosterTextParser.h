@@ -0,0 +1,80 @@
+#pragma once
+
+#include <QDate>
+#include <QList>
+#include <QRegularExpression>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+// Wertet den erkannten Text eines Discord-/Event-Screenshots aus: Abschnitte
+// (Akzeptiert, Tank, Abgelehnt), Event-Name, Datum, Map, Training oder Event
+// und die Namenskandidaten für den Abgleich mit der Spielerliste. Alles in
+// einem Durchlauf über die Zeilen; die regulären Ausdrücke sind statisch bzw.
+// (Ränge) einmal im Konstruktor übersetzt. parse() ist const und threadsicher.
+class RosterTextParser
+{
+public:
+    enum Section
+    {
+        Accepted,
+        Tank,
+        Rejected,
+        SectionCount
+    };
+
+    enum LineKind
+    {
+        Preamble, // vor der ersten Überschrift (Titel, Datum, Map)
+        Header,   // "Akzeptiert (12)" usw.
+        Name,     // unter einer Überschrift, 3..48 Zeichen
+        Noise     // unter einer Überschrift, zu kurz oder zu lang
+    };
+
+    struct Result
+    {
+        QString eventName; // erste Zeile, wenn 5..80 Zeichen
+        QDate date;        // erstes gültiges TT.MM.JJJJ (auch - und /)
+        QString map;       // erste bekannte Map im Text
+        bool training = false;
+        QStringList accepted;   // Zeilen unter Akzeptiert und Tank, ohne Dubletten
+        QStringList rejected;   // Zeilen unter Abgelehnt, ohne Dubletten
+        QStringList candidates; // bereinigte, getrennte Namen in Textreihenfolge; aus
+                                // den Abschnitten, ergeben die nichts, aus allen Zeilen
+        QList<LineKind> kinds;  // je Eingabezeile
+    };
+
+    // Bei geänderter Auswertung erhöhen; Teil des OCR-Cache-Schlüssels
+    static constexpr int Version = 1;
+
+    // Ränge trennen zusammengeklebte Namen ("Gefr Anton Uffz Bert")
+    explicit RosterTextParser(const QStringList &rankPrefixes = QStringList());
+
+    // Version und Ränge; gleiche Signatur heißt gleiches Ergebnis von parse()
+    const QString &signature() const { return m_signature; }
+
+    // lines wie OcrResult::lines (nicht leer, getrimmt)
+    Result parse(const QStringList &lines) const;
+    Result parse(const QString &text) const;
+
+    // Teilt nur an Rängen, wenn mindestens zwei vorkommen; sonst die Zeile
+    QStringList splitAtRanks(const QString &text) const;
+    // Wie splitAtRanks, ohne Ränge dann an Leerzeichen vor Klein-, dann vor
+    // Großbuchstaben ("Buddy Eiben"), wenn kein Teil kürzer als 2 Zeichen ist
+    QStringList splitNames(const QString &text) const;
+
+    // Tabs und Leerraum zu einem Leerzeichen; leer außerhalb von 3..48 Zeichen
+    static QString normalizeName(const QString &name);
+    // Abschnitt, den die Zeile als Überschrift einleitet, sonst -1
+    static int sectionOf(const QString &line);
+    static const QString &sectionHeader(int section);
+    static bool isNameLine(const QString &line) { return line.size() >= 3 && line.size() <= 48; }
+    static const QStringList &knownMaps();
+
+private:
+    QStringList glueRanks(const QStringList &parts) const;
+    void addCandidates(const QString &text, QStringList &out, QSet<QString> &seen) const;
+
+    QRegularExpression m_rankRx; // leer ohne Ränge
+    QString m_signature;
+};
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <QFile>
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// Soldbuch als Append-only-Log (JSON Lines, eine Zeile pro Eintrag) mit
+// binärem Offset-Index pro Spieler. Beim Start wird nur der Index gelesen;
+// die Einträge eines Spielers werden erst bei entriesFor() aus dem Log
+// geholt. Fehlt der Index oder ist er kürzer als das Log, wird der Rest aus
+// dem Log nachindiziert. Ein vorhandenes clan_soldbuch_log.json wird beim
+// ersten Start (noch kein Index) einmalig übernommen und danach in
+// clan_soldbuch_log.json.migrated umbenannt; clear() löscht es ebenfalls.
+class SoldbuchLog
+{
+public:
+    void setPaths(const QString &logPath, const QString &indexPath, const QString &legacyJsonPath = QString());
+
+    bool open();
+    bool append(const QString &playerKey, const QJsonObject &entry);
+    // Einträge in Schreibreihenfolge
+    QList<QJsonObject> entriesFor(const QString &playerKey) const;
+    int entryCount(const QString &playerKey) const;
+    int playerCount() const { return m_offsets.size(); }
+    QStringList players() const { return m_offsets.keys(); }
+    // Spieler, deren Einträge seit open() aus dem Log gelesen wurden
+    int hydratedPlayerCount() const { return m_hydrated.size(); }
+    bool clear();
+
+    QString errorString() const { return m_error; }
+
+private:
+    static constexpr quint32 IndexMagic = 0x53424958; // "SBIX"
+    static constexpr quint32 IndexVersion = 1;
+
+    bool loadIndex(qint64 logSize, qint64 &lastOffset);
+    bool resetIndexFile();
+    bool appendIndex(qint64 offset, const QString &playerKey);
+    bool indexLogFrom(qint64 pos);
+    bool migrateLegacy();
+    bool openWriters();
+
+    QString m_logPath;
+    QString m_indexPath;
+    QString m_legacyPath;
+    QFile m_log;
+    QFile m_index;
+    QHash<QString, QVector<qint64>> m_offsets;
+    mutable QSet<QString> m_hydrated;
+    QString m_error;
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <QHash>
+#include <QReadWriteLock>
+#include <QString>
+#include <QVector>
+#include <deque>
+
+// Interning-Tabelle für Texte mit wenigen verschiedenen Werten (Gruppe, Rang,
+// Karte, Eventname, Session-Typ). Jeder Text bekommt eine feste ID, die bis
+// zum Programmende gültig bleibt; gleiche Texte vergleichen sich damit als
+// Ganzzahlen. Jede ID kennt zusätzlich die ID ihrer case-gefalteten Form.
+// Threadsicher, weil der CSV-Import Spieler im Hintergrund anlegt.
+class StringPool
+{
+public:
+    static constexpr quint32 NotFound = 0xffffffffu;
+
+    static StringPool &instance();
+
+    quint32 intern(const QString &text);
+    // Ohne Anlegen; NotFound, wenn der Text nie interniert wurde
+    quint32 find(const QString &text) const;
+    const QString &text(quint32 id) const;
+    quint32 folded(quint32 id) const;
+    int size() const;
+
+private:
+    StringPool();
+
+    mutable QReadWriteLock m_lock;
+    std::deque<QString> m_strings; // Referenzen bleiben beim Anhängen gültig
+    QVector<quint32> m_folded;
+    QHash<QString, quint32> m_ids;
+};
+
+// ID in den StringPool. Wird wie ein QString gesetzt und gelesen, vergleicht
+// sich untereinander aber über die ID. ID 0 ist der leere Text.
+class Symbol
+{
+public:
+    Symbol() = default;
+    Symbol(const QString &text) : m_id(StringPool::instance().intern(text)) {}
+    Symbol(const char *text) : Symbol(QString::fromUtf8(text)) {}
+    static Symbol fromId(quint32 id)
+    {
+        Symbol s;
+        s.m_id = id;
+        return s;
+    }
+
+    quint32 id() const { return m_id; }
+    bool isEmpty() const { return m_id == 0; }
+    void clear() { m_id = 0; }
+    const QString &toString() const { return StringPool::instance().text(m_id); }
+    operator const QString &() const { return toString(); }
+
+    // Gleichheit ohne Rücksicht auf Groß-/Kleinschreibung
+    bool equalsIgnoreCase(Symbol other) const
+    {
+        return m_id == other.m_id || StringPool::instance().folded(m_id) == StringPool::instance().folded(other.m_id);
+    }
+
+    friend bool operator==(Symbol a, Symbol b) { return a.m_id == b.m_id; }
+    friend bool operator!=(Symbol a, Symbol b) { return a.m_id != b.m_id; }
+    friend size_t qHash(Symbol s, size_t seed = 0) { return qHash(s.m_id, seed); }
+
+private:
+    quint32 m_id = 0;
+};
+Q_DECLARE_TYPEINFO(Symbol, Q_PRIMITIVE_TYPE);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "StringPool.h"
 #include <QString>
 #include <QDate>
 #include <QJsonObject>
@@ -11,7 +12,7 @@ struct Training
     QString id; // arbitrary unique id (e.g. uuid or timestamp-based)
     QDate date;
     QString title;
-    QString type;     // Training, Event, Reserve, ...
+    Symbol type;      // Training, Event, Reserve, ...
     QStringList maps; // rollout list of maps played
     // Optional: stored player lists for templates
     QStringList confirmedPlayers;
@@ -24,7 +25,7 @@ struct Training
         obj.insert("id", id);
         obj.insert("date", date.toString(Qt::ISODate));
         obj.insert("title", title);
-        obj.insert("type", type);
+        obj.insert("type", type.toString());
         QJsonArray a;
         for (const QString &m : maps)
             a.append(m);
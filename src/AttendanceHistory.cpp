@@ -0,0 +1,279 @@
+#include "AttendanceHistory.h"
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+namespace
+{
+    bool isSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    int skipSpace(const QByteArray &json, int pos)
+    {
+        while (pos < json.size() && isSpace(json.at(pos)))
+            ++pos;
+        return pos;
+    }
+
+    // Ende eines Strings ab dem öffnenden Anführungszeichen, -1 bei Abbruch
+    int skipString(const QByteArray &json, int pos)
+    {
+        for (++pos; pos < json.size(); ++pos)
+        {
+            const char c = json.at(pos);
+            if (c == '\\')
+                ++pos;
+            else if (c == '"')
+                return pos + 1;
+        }
+        return -1;
+    }
+
+    // Ende eines beliebigen Werts; nur Klammern und Strings werden verfolgt
+    int skipValue(const QByteArray &json, int pos)
+    {
+        int depth = 0;
+        while (pos < json.size())
+        {
+            const char c = json.at(pos);
+            if (c == '"')
+            {
+                pos = skipString(json, pos);
+                if (pos < 0)
+                    return -1;
+                if (depth == 0)
+                    return pos;
+                continue;
+            }
+            if (c == '[' || c == '{')
+            {
+                ++depth;
+            }
+            else if (c == ']' || c == '}')
+            {
+                if (depth == 0)
+                    return pos;
+                if (--depth == 0)
+                    return pos + 1;
+            }
+            else if (depth == 0 && (c == ',' || isSpace(c)))
+            {
+                return pos;
+            }
+            ++pos;
+        }
+        return depth == 0 ? pos : -1;
+    }
+
+    // Einzelwert über ein umschließendes Array dekodieren
+    QJsonValue parseValue(const QByteArray &bytes, bool *ok = nullptr)
+    {
+        QJsonParseError error;
+        const QJsonDocument doc = QJsonDocument::fromJson('[' + bytes + ']', &error);
+        if (ok)
+            *ok = error.error == QJsonParseError::NoError && doc.array().size() == 1;
+        return doc.array().first();
+    }
+}
+
+void AttendanceHistory::clear()
+{
+    m_slots.clear();
+    m_hydrated = 0;
+}
+
+AttendanceRecord AttendanceHistory::fromJson(const QJsonObject &entry) const
+{
+    AttendanceRecord record;
+    record.type = Symbol(entry.value("type").toString());
+    record.name = Symbol(entry.value("name").toString());
+    record.map = Symbol(entry.value("map").toString());
+    record.setDate(QDate::fromString(entry.value("date").toString(), Qt::ISODate));
+    const QDateTime when = QDateTime::fromString(entry.value("timestamp").toString(), Qt::ISODate);
+    record.timestamp = when.isValid() ? when.toMSecsSinceEpoch() : 0;
+    return record;
+}
+
+QJsonObject AttendanceHistory::toJson(const AttendanceRecord &record) const
+{
+    QJsonObject entry;
+    entry.insert("type", record.type.toString());
+    entry.insert("date", record.hasDate() ? record.date().toString(Qt::ISODate) : QString());
+    if (record.timestamp != 0)
+        entry.insert("timestamp", QDateTime::fromMSecsSinceEpoch(record.timestamp).toString(Qt::ISODate));
+    if (!record.name.isEmpty())
+        entry.insert("name", record.name.toString());
+    if (!record.map.isEmpty())
+        entry.insert("map", record.map.toString());
+    return entry;
+}
+
+AttendanceHistory::Entries AttendanceHistory::parseRaw(const QByteArray &raw) const
+{
+    Entries parsed;
+    const QJsonArray arr = QJsonDocument::fromJson(raw).array();
+    parsed.reserve(arr.size());
+    for (const QJsonValue &val : arr)
+    {
+        if (val.isObject())
+            parsed.append(fromJson(val.toObject()));
+    }
+    return parsed;
+}
+
+void AttendanceHistory::setRaw(const QString &key, const QByteArray &jsonArray)
+{
+    Slot &slot = m_slots[key];
+    if (slot.hydrated)
+        --m_hydrated;
+    slot = Slot();
+    slot.raw = jsonArray;
+}
+
+void AttendanceHistory::append(const QString &key, const AttendanceRecord &record)
+{
+    // Unberührte Spieler bleiben ungeparst; hydrate() hängt die Einträge an
+    Slot &slot = m_slots[key];
+    slot.entries.append(record);
+    if (slot.hydrated)
+        indexSession(slot, record);
+}
+
+void AttendanceHistory::indexSession(Slot &slot, const AttendanceRecord &record) const
+{
+    if (!record.hasDate())
+        return;
+    // Ohne Namen abgefragt zählt jeder Eintrag des Typs an diesem Tag
+    const StringPool &pool = StringPool::instance();
+    const quint32 type = pool.folded(record.type.id());
+    slot.sessions.insert({type, 0, record.julianDay});
+    if (!record.name.isEmpty())
+        slot.sessions.insert({type, pool.folded(record.name.id()), record.julianDay});
+}
+
+bool AttendanceHistory::remove(const QString &key)
+{
+    const auto it = m_slots.find(key);
+    if (it == m_slots.end())
+        return false;
+    if (it->hydrated)
+        --m_hydrated;
+    m_slots.erase(it);
+    return true;
+}
+
+void AttendanceHistory::hydrate(Slot &slot) const
+{
+    if (slot.hydrated)
+        return;
+    Entries parsed;
+    if (!slot.raw.isEmpty())
+        parsed = parseRaw(slot.raw);
+    parsed.append(slot.entries);
+    slot.entries = std::move(parsed);
+    slot.raw.clear();
+    slot.sessions.reserve(slot.entries.size());
+    for (const AttendanceRecord &record : slot.entries)
+        indexSession(slot, record);
+    slot.hydrated = true;
+    ++m_hydrated;
+}
+
+const AttendanceHistory::Entries &AttendanceHistory::entries(const QString &key) const
+{
+    static const Entries empty;
+    const auto it = m_slots.find(key);
+    if (it == m_slots.end())
+        return empty;
+    hydrate(*it);
+    return it->entries;
+}
+
+bool AttendanceHistory::hasSession(const QString &key, const QString &type, const QString &name, const QDate &date) const
+{
+    const auto it = m_slots.find(key);
+    if (!date.isValid() || it == m_slots.end())
+        return false;
+    // Nie internierte Texte kann kein Eintrag tragen
+    const StringPool &pool = StringPool::instance();
+    const quint32 typeId = pool.find(type.toCaseFolded());
+    const quint32 nameId = name.isEmpty() ? 0 : pool.find(name.toCaseFolded());
+    if (typeId == StringPool::NotFound || nameId == StringPool::NotFound)
+        return false;
+    hydrate(*it);
+    return it->sessions.contains({typeId, nameId, qint32(date.toJulianDay())});
+}
+
+QByteArray AttendanceHistory::rawJson(const QString &key) const
+{
+    const auto it = m_slots.constFind(key);
+    if (it == m_slots.constEnd())
+        return QByteArrayLiteral("[]");
+    if (!it->hydrated && !it->raw.isEmpty() && it->entries.isEmpty())
+        return it->raw;
+    // Rohbestand plus angehängte Einträge, ohne den Spieler als geparst zu zählen
+    Entries merged = it->hydrated ? Entries() : parseRaw(it->raw);
+    merged.append(it->entries);
+    QJsonArray arr;
+    for (const AttendanceRecord &record : merged)
+        arr.append(toJson(record));
+    return QJsonDocument(arr).toJson(QJsonDocument::Compact);
+}
+
+bool AttendanceHistory::indexJson(const QByteArray &json, QJsonObject *scalars)
+{
+    clear();
+    int pos = json.startsWith("\xEF\xBB\xBF") ? 3 : 0;
+    pos = skipSpace(json, pos);
+    if (pos >= json.size() || json.at(pos) != '{')
+        return false;
+    pos = skipSpace(json, pos + 1);
+    if (pos < json.size() && json.at(pos) == '}')
+        return true;
+
+    while (pos < json.size())
+    {
+        if (json.at(pos) != '"')
+            break;
+        const int keyEnd = skipString(json, pos);
+        if (keyEnd < 0)
+            break;
+        const QByteArray keyBytes = json.mid(pos + 1, keyEnd - pos - 2);
+        const QString key = keyBytes.contains('\\')
+                                ? parseValue(json.mid(pos, keyEnd - pos)).toString()
+                                : QString::fromUtf8(keyBytes);
+
+        pos = skipSpace(json, keyEnd);
+        if (pos >= json.size() || json.at(pos) != ':')
+            break;
+        const int valueStart = skipSpace(json, pos + 1);
+        const int valueEnd = skipValue(json, valueStart);
+        if (valueEnd <= valueStart)
+            break;
+        const QByteArray value = json.mid(valueStart, valueEnd - valueStart);
+        if (value.startsWith('['))
+        {
+            setRaw(key, value);
+        }
+        else if (scalars)
+        {
+            bool ok = false;
+            const QJsonValue parsed = parseValue(value, &ok);
+            if (ok)
+                scalars->insert(key, parsed);
+        }
+
+        pos = skipSpace(json, valueEnd);
+        if (pos >= json.size())
+            break;
+        if (json.at(pos) == '}')
+            return true;
+        if (json.at(pos) != ',')
+            break;
+        pos = skipSpace(json, pos + 1);
+    }
+    clear();
+    return false;
+}
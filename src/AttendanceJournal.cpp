@@ -0,0 +1,184 @@
+#include "AttendanceJournal.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSaveFile>
+
+void AttendanceJournal::setPaths(const QString &snapshotPath, const QString &journalPath)
+{
+    m_journal.close();
+    m_snapshotPath = snapshotPath;
+    m_journalPath = journalPath;
+}
+
+bool AttendanceJournal::load(Records &records)
+{
+    records.clear();
+    m_journal.close();
+    m_error.clear();
+    m_journalLines = 0;
+    m_replayed = 0;
+    m_dropped = 0;
+    m_journalUnread = false;
+
+    qint64 snapshotSeq = 0;
+    QFile f(m_snapshotPath);
+    if (f.exists())
+    {
+        if (!f.open(QIODevice::ReadOnly))
+        {
+            m_error = f.errorString();
+            return false;
+        }
+        const QByteArray bytes = f.readAll();
+        QJsonObject scalars;
+        if (records.indexJson(bytes, &scalars))
+        {
+            snapshotSeq = scalars.value("_journalSeq").toInteger();
+        }
+        else
+        {
+            // Unerwartete Formatierung: einmal komplett parsen
+            const QJsonObject root = QJsonDocument::fromJson(bytes).object();
+            snapshotSeq = root.value("_journalSeq").toInteger();
+            for (auto it = root.begin(); it != root.end(); ++it)
+            {
+                if (it.value().isArray())
+                    records.setRaw(it.key(), QJsonDocument(it.value().toArray()).toJson(QJsonDocument::Compact));
+            }
+        }
+    }
+    m_nextSeq = snapshotSeq + 1;
+    return replayJournal(records, snapshotSeq);
+}
+
+void AttendanceJournal::restore(qint64 nextSeq, int journalLines)
+{
+    m_journal.close();
+    m_error.clear();
+    m_nextSeq = qMax<qint64>(1, nextSeq);
+    m_journalLines = journalLines;
+    m_replayed = 0;
+    m_dropped = 0;
+    m_journalUnread = false;
+}
+
+bool AttendanceJournal::replayJournal(Records &records, qint64 snapshotSeq)
+{
+    QFile f(m_journalPath);
+    if (!f.exists())
+        return true;
+    // Schreibgeschützt oder gesperrt: trotzdem abspielen, nur nicht abschneiden
+    const bool writable = f.open(QIODevice::ReadWrite);
+    if (!writable && !f.open(QIODevice::ReadOnly))
+    {
+        // compact() würde die Einträge sonst mit dem Snapshot verwerfen
+        m_error = f.errorString();
+        m_journalUnread = true;
+        return false;
+    }
+
+    qint64 goodEnd = 0;
+    while (!f.atEnd())
+    {
+        const QByteArray line = f.readLine();
+        // Ohne Zeilenende wurde der Schreibvorgang unterbrochen
+        if (!line.endsWith('\n'))
+        {
+            ++m_dropped;
+            break;
+        }
+        goodEnd = f.pos();
+        const QJsonDocument doc = QJsonDocument::fromJson(line);
+        if (!doc.isObject())
+        {
+            ++m_dropped;
+            continue;
+        }
+        const QJsonObject obj = doc.object();
+        const qint64 seq = obj.value("seq").toInteger();
+        const QString key = obj.value("player").toString();
+        ++m_journalLines;
+        if (seq >= m_nextSeq)
+            m_nextSeq = seq + 1;
+        // Bereits im Snapshot enthalten
+        if (seq <= snapshotSeq || key.isEmpty())
+            continue;
+        records.append(key, obj.value("entry").toObject());
+        ++m_replayed;
+    }
+    // Abgerissenen Rest entfernen, damit neue Zeilen sauber beginnen
+    if (writable && f.size() > goodEnd)
+        f.resize(goodEnd);
+    return true;
+}
+
+bool AttendanceJournal::openJournal()
+{
+    if (m_journal.isOpen())
+        return true;
+    m_journal.setFileName(m_journalPath);
+    if (!m_journal.open(QIODevice::WriteOnly | QIODevice::Append))
+    {
+        m_error = m_journal.errorString();
+        return false;
+    }
+    return true;
+}
+
+bool AttendanceJournal::append(const QString &playerKey, const QJsonObject &entry)
+{
+    if (m_journalPath.isEmpty() || !openJournal())
+        return false;
+    QJsonObject line;
+    line.insert("seq", m_nextSeq);
+    line.insert("player", playerKey);
+    line.insert("entry", entry);
+    QByteArray bytes = QJsonDocument(line).toJson(QJsonDocument::Compact);
+    bytes.append('\n');
+    if (m_journal.write(bytes) != bytes.size() || !m_journal.flush())
+    {
+        m_error = m_journal.errorString();
+        m_journal.close();
+        return false;
+    }
+    ++m_nextSeq;
+    ++m_journalLines;
+    return true;
+}
+
+bool AttendanceJournal::compact(const Records &records)
+{
+    if (m_journalUnread)
+    {
+        m_error = QStringLiteral("Journal wurde nicht gelesen: %1").arg(m_journalPath);
+        return false;
+    }
+    // Von Hand zusammensetzen, damit ungeparste Spieler roh übernommen werden
+    QSaveFile out(m_snapshotPath);
+    if (!out.open(QIODevice::WriteOnly))
+    {
+        m_error = out.errorString();
+        return false;
+    }
+    out.write("{\n");
+    for (const QString &key : records.keys())
+    {
+        QByteArray quotedKey = QJsonDocument(QJsonArray{key}).toJson(QJsonDocument::Compact);
+        quotedKey = quotedKey.mid(1, quotedKey.size() - 2);
+        out.write("    " + quotedKey + ": " + records.rawJson(key) + ",\n");
+    }
+    out.write("    \"_journalSeq\": " + QByteArray::number(m_nextSeq - 1) + "\n}\n");
+    if (!out.commit())
+    {
+        m_error = out.errorString();
+        return false;
+    }
+
+    // Scheitert das Leeren, filtert _journalSeq die alten Zeilen beim Replay
+    m_journal.close();
+    QFile journal(m_journalPath);
+    if (journal.exists() && !journal.resize(0))
+        m_error = journal.errorString();
+    m_journalLines = 0;
+    return true;
+}
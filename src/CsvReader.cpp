@@ -0,0 +1,583 @@
+#include "CsvReader.h"
+#include <QDate>
+#include <QFile>
+#include <QList>
+
+namespace
+{
+    constexpr qint64 ChunkSize = 256 * 1024;
+    constexpr qint64 DetectWindow = 64 * 1024;
+
+    qint64 bomLength(const char *data, qint64 size)
+    {
+        if (size >= 3 && static_cast<uchar>(data[0]) == 0xEF && static_cast<uchar>(data[1]) == 0xBB && static_cast<uchar>(data[2]) == 0xBF)
+            return 3;
+        return 0;
+    }
+
+    QString valueAt(const QStringList &cols, int idx)
+    {
+        if (idx < 0 || idx >= cols.size())
+            return QString();
+        return cols.at(idx);
+    }
+
+    int parseIntValue(const QString &text)
+    {
+        QString cleaned;
+        cleaned.reserve(text.size());
+        for (const QChar ch : text)
+        {
+            if (ch.isDigit())
+                cleaned.append(ch);
+            else if (ch == '-' && cleaned.isEmpty())
+                cleaned.append(ch);
+        }
+        bool ok = false;
+        int val = cleaned.toInt(&ok);
+        return ok ? val : 0;
+    }
+
+    QDate parseDateValue(QString text)
+    {
+        text = text.trimmed();
+        if (text.isEmpty())
+            return QDate();
+        int spaceIdx = text.indexOf(' ');
+        if (spaceIdx > 0)
+            text = text.left(spaceIdx);
+        text.replace(',', '.');
+        static const QStringList formats = {QStringLiteral("yyyy-MM-dd"), QStringLiteral("dd.MM.yyyy"), QStringLiteral("dd.MM.yy"), QStringLiteral("dd/MM/yyyy"), QStringLiteral("dd/MM/yy"), QStringLiteral("dd-MM-yyyy"), QStringLiteral("dd-MM-yy"), QStringLiteral("yyyy.MM.dd"), QStringLiteral("yyyy/MM/dd"), QStringLiteral("MM/dd/yyyy"), QStringLiteral("MM/dd/yy")};
+        for (const QString &fmt : formats)
+        {
+            QDate parsed = QDate::fromString(text, fmt);
+            if (parsed.isValid())
+                return parsed;
+        }
+        bool ok = false;
+        int serial = text.toInt(&ok);
+        if (ok && serial > 0)
+        {
+            // Excel-Seriennummer
+            QDate base(1899, 12, 30);
+            return base.addDays(serial);
+        }
+        return QDate();
+    }
+}
+
+char CsvReader::detectDelimiter(const char *data, qint64 size)
+{
+    const char candidates[] = {'\t', ';', ',', '|'};
+    int scores[4] = {0, 0, 0, 0};
+    int lineScores[4] = {0, 0, 0, 0};
+    bool lineHasContent = false;
+    int inspected = 0;
+    for (qint64 i = 0; i <= size && inspected < 12; ++i)
+    {
+        const char c = i < size ? data[i] : '\n';
+        if (c == '\n')
+        {
+            if (lineHasContent)
+            {
+                for (int k = 0; k < 4; ++k)
+                    scores[k] += lineScores[k];
+                ++inspected;
+            }
+            for (int k = 0; k < 4; ++k)
+                lineScores[k] = 0;
+            lineHasContent = false;
+            continue;
+        }
+        for (int k = 0; k < 4; ++k)
+        {
+            if (c == candidates[k])
+                ++lineScores[k];
+        }
+        if (c != ' ' && c != '\t' && c != '\r')
+            lineHasContent = true;
+    }
+    char best = ',';
+    int bestScore = -1;
+    for (int k = 0; k < 4; ++k)
+    {
+        if (scores[k] > bestScore)
+        {
+            bestScore = scores[k];
+            best = candidates[k];
+        }
+    }
+    return bestScore <= 0 ? ';' : best;
+}
+
+bool CsvReader::readFile(const QString &path, const RowCallback &onRow)
+{
+    m_error.clear();
+    m_rows = 0;
+    m_aborted = false;
+    m_offset = 0;
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        m_error = file.errorString();
+        return false;
+    }
+
+    const qint64 size = file.size();
+    m_total = size;
+    if (size > 0)
+    {
+        // Gemappte Seiten gehören dem Kernel, der Heap bleibt unabhängig von der Dateigröße
+        if (uchar *mapped = file.map(0, size))
+        {
+            const char *data = reinterpret_cast<const char *>(mapped);
+            const qint64 offset = bomLength(data, size);
+            if (m_delimiter == 0)
+                m_delimiter = detectDelimiter(data + offset, qMin(size - offset, DetectWindow));
+            m_offset = offset;
+            const qint64 used = parse(data + offset, size - offset, true, onRow);
+            file.unmap(mapped);
+            if (m_onProgress)
+                m_onProgress(offset + used, size);
+            return true;
+        }
+    }
+
+    // Fallback ohne Mapping: blockweise lesen, angefangener Datensatz wird übertragen
+    QByteArray buffer;
+    bool started = false;
+    while (!m_aborted)
+    {
+        const QByteArray chunk = file.read(ChunkSize);
+        const bool atEnd = chunk.isEmpty() || file.atEnd();
+        buffer.append(chunk);
+        if (!started)
+        {
+            if (buffer.size() < DetectWindow && !atEnd)
+                continue;
+            started = true;
+            m_offset = bomLength(buffer.constData(), buffer.size());
+            buffer.remove(0, m_offset);
+            if (m_delimiter == 0)
+                m_delimiter = detectDelimiter(buffer.constData(), qMin<qint64>(buffer.size(), DetectWindow));
+        }
+        const qint64 used = parse(buffer.constData(), buffer.size(), atEnd, onRow);
+        buffer.remove(0, used);
+        m_offset += used;
+        if (atEnd)
+            break;
+    }
+    if (m_onProgress)
+        m_onProgress(m_offset, m_total);
+    if (file.error() != QFileDevice::NoError)
+    {
+        m_error = file.errorString();
+        return false;
+    }
+    return true;
+}
+
+qint64 CsvReader::parse(const char *data, qint64 size, bool atEnd, const RowCallback &onRow)
+{
+    const char *const end = data + size;
+    const char *p = data;
+    while (p < end && !m_aborted)
+    {
+        const char *recordStart = p;
+        m_fields.clear();
+        while (true)
+        {
+            const char *fieldStart = p;
+            // Quotes gelten nur am Feldanfang (nach Leerraum), sonst wörtlich:
+            // ein einzelnes " wie in 12" Kanone darf nicht den Rest der Datei schlucken
+            while (p < end && (*p == ' ' || *p == '\t') && *p != m_delimiter)
+                ++p;
+            const bool quoted = p < end && *p == '"';
+            if (quoted)
+            {
+                ++p;
+                while (p < end)
+                {
+                    if (*p == '"')
+                    {
+                        // "" am Pufferende: erst mit dem nächsten Block entscheidbar
+                        if (p + 1 == end)
+                        {
+                            p = end;
+                            break;
+                        }
+                        if (p[1] == '"')
+                        {
+                            p += 2;
+                            continue;
+                        }
+                        ++p;
+                        break;
+                    }
+                    ++p;
+                }
+            }
+            while (p < end && *p != m_delimiter && *p != '\n')
+                ++p;
+            // Datensatz läuft über das Pufferende hinaus: beim nächsten Block neu beginnen
+            if (p == end && !atEnd)
+                return recordStart - data;
+            m_fields.append(decodeField(fieldStart, p, quoted));
+            if (p == end)
+                break;
+            if (*p++ == '\n')
+                break;
+        }
+
+        if (m_fields.size() == 1 && m_fields.first().isEmpty())
+            continue;
+        ++m_rows;
+        if (onRow && !onRow(m_fields))
+            m_aborted = true;
+        if (m_onProgress && m_rows % ProgressInterval == 0)
+            m_onProgress(m_offset + (p - data), m_total);
+    }
+    return p - data;
+}
+
+QString CsvReader::decodeField(const char *begin, const char *end, bool quoted)
+{
+    if (!quoted)
+        return QString::fromUtf8(begin, end - begin).trimmed();
+
+    // Nur Felder mit Anführungszeichen brauchen eine Kopie ohne Quotes
+    QByteArray raw;
+    raw.reserve(end - begin);
+    const char *p = begin;
+    while (p < end && *p != '"') // Leerraum vor dem öffnenden Quote
+        ++p;
+    for (++p; p < end; ++p)
+    {
+        if (*p == '"')
+        {
+            if (p + 1 < end && p[1] == '"')
+            {
+                raw.append('"');
+                ++p;
+                continue;
+            }
+            ++p;
+            break;
+        }
+        if (*p != '\r')
+            raw.append(*p);
+    }
+    // Text nach dem schließenden Quote bleibt wörtlich
+    for (; p < end; ++p)
+    {
+        if (*p != '\r')
+            raw.append(*p);
+    }
+    return QString::fromUtf8(raw).trimmed();
+}
+
+QString PlayerCsvImporter::normalizeToken(const QString &text)
+{
+    QString lowered = text.normalized(QString::NormalizationForm_D).toLower();
+    QString result;
+    result.reserve(lowered.size());
+    bool lastWasSpace = true;
+    for (const QChar ch : lowered)
+    {
+        const QChar::Category category = ch.category();
+        if (category == QChar::Mark_NonSpacing || category == QChar::Mark_SpacingCombining || category == QChar::Mark_Enclosing)
+            continue;
+        if (ch.isLetterOrNumber())
+        {
+            result.append(ch);
+            lastWasSpace = false;
+        }
+        else if (!lastWasSpace)
+        {
+            result.append(' ');
+            lastWasSpace = true;
+        }
+    }
+    return result.simplified();
+}
+
+bool PlayerCsvImporter::looksLikeHeader(const QStringList &cols) const
+{
+    for (const QString &value : cols)
+    {
+        const QString norm = normalizeToken(value);
+        if (norm == "name" || norm == "spielername" || norm.contains(" name"))
+            return true;
+    }
+    return false;
+}
+
+int PlayerCsvImporter::findColumn(const QStringList &candidates) const
+{
+    for (const QString &candidate : candidates)
+    {
+        const QString needle = normalizeToken(candidate);
+        if (needle.isEmpty())
+            continue;
+        const int idx = m_normalizedHeaders.indexOf(needle);
+        if (idx >= 0)
+            return idx;
+    }
+    for (const QString &candidate : candidates)
+    {
+        const QString needle = normalizeToken(candidate);
+        if (needle.isEmpty())
+            continue;
+        for (int idx = 0; idx < m_normalizedHeaders.size(); ++idx)
+        {
+            if (m_normalizedHeaders.at(idx).contains(needle))
+                return idx;
+        }
+    }
+    return -1;
+}
+
+int PlayerCsvImporter::findColumnByParts(const QStringList &parts) const
+{
+    for (int idx = 0; idx < m_normalizedHeaders.size(); ++idx)
+    {
+        bool matches = true;
+        for (const QString &part : parts)
+        {
+            const QString needle = normalizeToken(part);
+            if (needle.isEmpty())
+                continue;
+            if (!m_normalizedHeaders.at(idx).contains(needle))
+            {
+                matches = false;
+                break;
+            }
+        }
+        if (matches)
+            return idx;
+    }
+    return -1;
+}
+
+void PlayerCsvImporter::resolveColumns(const QStringList &headers)
+{
+    m_normalizedHeaders.clear();
+    for (const QString &h : headers)
+        m_normalizedHeaders.append(normalizeToken(h));
+
+    m_nameIdx = findColumn(QStringList() << QStringLiteral("Name") << QStringLiteral("Spielername"));
+    m_t17Idx = findColumn(QStringList() << QStringLiteral("T17") << QStringLiteral("T17 Name") << QStringLiteral("T17-Name"));
+    m_joinIdx = findColumn(QStringList() << QStringLiteral("Datum Vollmitglied") << QStringLiteral("Eintrittsdatum") << QStringLiteral("Beitrittsdatum") << QStringLiteral("Eintritt") << QStringLiteral("Beitritt"));
+    m_rankIdx = findColumn(QStringList() << QStringLiteral("Dienstgrad") << QStringLiteral("Dienstgradstufe") << QStringLiteral("Dienstrang") << QStringLiteral("Rang"));
+    m_groupIdx = findColumn(QStringList() << QStringLiteral("Gruppe") << QStringLiteral("Trupp") << QStringLiteral("Squad"));
+    m_levelIdx = findColumn(QStringList() << QStringLiteral("Level") << QStringLiteral("Dienstgradstufe") << QStringLiteral("Stufe"));
+    m_commentIdx = findColumn(QStringList() << QStringLiteral("Kommentar") << QStringLiteral("Notiz"));
+    m_nextRankIdx = findColumn(QStringList() << QStringLiteral("Nächster Rang") << QStringLiteral("Naechster Rang") << QStringLiteral("Next Rank"));
+    m_lastPromotionIdx = findColumn(QStringList() << QStringLiteral("Datum letzte Beförderung") << QStringLiteral("Letzte Beförderung") << QStringLiteral("Last Promotion"));
+    m_trainingsTotalIdx = findColumnByParts(QStringList() << QStringLiteral("Training") << QStringLiteral("Gesamt"));
+    const int trainingsRankIdxFallback = findColumnByParts(QStringList() << QStringLiteral("Training") << QStringLiteral("Rang"));
+    const int trainingsSinceIdx = findColumnByParts(QStringList() << QStringLiteral("Training") << QStringLiteral("seit"));
+    m_eventsIdx = findColumnByParts(QStringList() << QStringLiteral("Event"));
+    m_reserveIdx = findColumnByParts(QStringList() << QStringLiteral("Reserve"));
+    if (m_trainingsTotalIdx < 0)
+        m_trainingsTotalIdx = findColumn(QStringList() << QStringLiteral("Trainings") << QStringLiteral("Teilnahmen"));
+    m_trainingsRankIdx = trainingsSinceIdx >= 0 ? trainingsSinceIdx : (trainingsRankIdxFallback >= 0 ? trainingsRankIdxFallback : m_trainingsTotalIdx);
+}
+
+void PlayerCsvImporter::importRow(const QStringList &cols, CsvImportResult &result)
+{
+    const QString name = valueAt(cols, m_nameIdx);
+    if (name.isEmpty())
+    {
+        ++result.skipped;
+        return;
+    }
+    const QString nameNormalized = normalizeToken(name);
+    if (nameNormalized == "name" || nameNormalized == "spielername")
+    {
+        // wiederholte Kopfzeile
+        ++result.skipped;
+        return;
+    }
+
+    Player player;
+    player.name = name;
+    player.t17name = valueAt(cols, m_t17Idx);
+    player.group = valueAt(cols, m_groupIdx);
+    player.comment = valueAt(cols, m_commentIdx);
+    player.rank = valueAt(cols, m_rankIdx);
+    player.nextRank = valueAt(cols, m_nextRankIdx);
+    player.level = parseIntValue(valueAt(cols, m_levelIdx));
+    player.joinDate = parseDateValue(valueAt(cols, m_joinIdx));
+    player.lastPromotionDate = parseDateValue(valueAt(cols, m_lastPromotionIdx));
+    player.attendance = parseIntValue(valueAt(cols, m_trainingsRankIdx));
+    player.totalAttendance = parseIntValue(valueAt(cols, m_trainingsTotalIdx));
+    if (player.attendance <= 0 && player.totalAttendance > 0)
+        player.attendance = player.totalAttendance;
+    if (player.totalAttendance <= 0 && player.attendance > 0)
+        player.totalAttendance = player.attendance;
+    player.events = parseIntValue(valueAt(cols, m_eventsIdx));
+    player.totalEvents = player.events;
+    player.reserve = parseIntValue(valueAt(cols, m_reserveIdx));
+    player.totalReserve = player.reserve;
+    if (!player.group.isEmpty() && !m_seenGroups.contains(player.group))
+    {
+        m_seenGroups.insert(player.group);
+        result.groups.append(player.group.toString());
+    }
+    m_onPlayer(player);
+}
+
+void PlayerCsvImporter::mergePlayer(const Player &player, PlayerList &list, CsvImportResult &result) const
+{
+    if (m_fuzzyMergeDistance > 0)
+    {
+        const bool exact = player.t17name.isEmpty() ? list.indexOfName(player.name) >= 0 : list.indexOfT17(player.t17name) >= 0;
+        const int similar = exact ? -1 : list.indexOfNameFuzzy(player.name, m_fuzzyMergeDistance);
+        if (similar >= 0)
+        {
+            list.mergeAt(similar, player);
+            ++result.merged;
+            return;
+        }
+    }
+
+    const int before = static_cast<int>(list.players.size());
+    list.addOrMerge(player);
+    if (static_cast<int>(list.players.size()) == before)
+        ++result.merged;
+    else
+        ++result.imported;
+}
+
+bool PlayerCsvImporter::importFile(const QString &path, PlayerList &list, CsvImportResult &result)
+{
+    m_onPlayer = [&](Player &player)
+    { mergePlayer(player, list, result); };
+    const bool ok = readRows(path, result);
+    m_onPlayer = nullptr;
+    return ok;
+}
+
+bool PlayerCsvImporter::readFile(const QString &path, QList<Player> &players, CsvImportResult &result)
+{
+    players.clear();
+    m_onPlayer = [&](Player &player)
+    { players.append(std::move(player)); };
+    const bool ok = readRows(path, result);
+    m_onPlayer = nullptr;
+    return ok;
+}
+
+void PlayerCsvImporter::mergeInto(const QList<Player> &players, PlayerList &list, CsvImportResult &result) const
+{
+    for (const Player &player : players)
+        mergePlayer(player, list, result);
+}
+
+bool PlayerCsvImporter::readRows(const QString &path, CsvImportResult &result)
+{
+    result = CsvImportResult();
+    m_normalizedHeaders.clear();
+    m_seenGroups.clear();
+    m_nameIdx = -1;
+
+    // Kopfzeile wird in der ganzen Datei gesucht, gepuffert werden davor aber
+    // nur die ersten Zeilen. Ohne Kopfzeile gilt die erste Zeile als Kopf.
+    QList<QStringList> pending;
+    int rowsBeforeHeader = 0;
+    bool headerResolved = false;
+    bool canceled = false;
+
+    CsvReader reader;
+    reader.setProgressCallback(m_onProgress);
+    const bool readOk = reader.readFile(path, [&](const QStringList &cols) -> bool
+                                        {
+        if (m_isCanceled && m_isCanceled())
+        {
+            canceled = true;
+            return false;
+        }
+        if (headerResolved)
+        {
+            importRow(cols, result);
+            return true;
+        }
+        if (looksLikeHeader(cols))
+        {
+            resolveColumns(cols);
+            headerResolved = true;
+            pending.clear();
+            return m_nameIdx >= 0;
+        }
+        ++rowsBeforeHeader;
+        if (pending.size() < MaxHeaderSearchRows)
+            pending.append(cols);
+        return true; });
+
+    if (!readOk)
+    {
+        result.error = CsvImportResult::OpenFailed;
+        result.errorString = QStringLiteral("Datei konnte nicht geöffnet werden: %1").arg(reader.errorString());
+        return false;
+    }
+    if (canceled)
+    {
+        result.error = CsvImportResult::Canceled;
+        result.errorString = QStringLiteral("Import abgebrochen");
+        return false;
+    }
+    if (!headerResolved)
+    {
+        if (pending.isEmpty())
+        {
+            result.error = CsvImportResult::NoRows;
+            result.errorString = QStringLiteral("Datei leer oder keine verwertbaren Zeilen");
+            return false;
+        }
+        resolveColumns(pending.first());
+        if (m_nameIdx >= 0 && rowsBeforeHeader <= pending.size())
+        {
+            for (int i = 1; i < pending.size(); ++i)
+                importRow(pending.at(i), result);
+        }
+        else if (m_nameIdx >= 0)
+        {
+            // Nicht alle Zeilen gepuffert: ab der zweiten Zeile erneut lesen
+            int row = 0;
+            CsvReader rest;
+            rest.setDelimiter(reader.delimiter());
+            rest.setProgressCallback(m_onProgress);
+            const bool restOk = rest.readFile(path, [&](const QStringList &cols) -> bool
+                                              {
+                if (m_isCanceled && m_isCanceled())
+                {
+                    canceled = true;
+                    return false;
+                }
+                if (row++ > 0)
+                    importRow(cols, result);
+                return true; });
+            if (!restOk)
+            {
+                result.error = CsvImportResult::OpenFailed;
+                result.errorString = QStringLiteral("Datei konnte nicht geöffnet werden: %1").arg(rest.errorString());
+                return false;
+            }
+            if (canceled)
+            {
+                result.error = CsvImportResult::Canceled;
+                result.errorString = QStringLiteral("Import abgebrochen");
+                return false;
+            }
+        }
+    }
+    if (m_nameIdx < 0)
+    {
+        result.error = CsvImportResult::NoNameColumn;
+        result.errorString = QStringLiteral("Keine Namensspalte erkannt");
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,223 @@
+#include "DataSnapshot.h"
+#include <QByteArray>
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+namespace
+{
+    void writePlayer(QDataStream &out, const Player &p)
+    {
+        // noResponseCounter wird wie im JSON nicht gespeichert
+        out << p.name << p.t17name << qint32(p.level) << p.group.toString()
+            << qint32(p.attendance) << qint32(p.totalAttendance)
+            << qint32(p.events) << qint32(p.totalEvents)
+            << qint32(p.reserve) << qint32(p.totalReserve)
+            << p.comment << p.joinDate << p.rank.toString() << p.lastPromotionDate << p.nextRank.toString();
+    }
+
+    void readPlayer(QDataStream &in, Player &p)
+    {
+        qint32 level = 0, attendance = 0, totalAttendance = 0, events = 0, totalEvents = 0, reserve = 0, totalReserve = 0;
+        QString group, rank, nextRank;
+        in >> p.name >> p.t17name >> level >> group
+            >> attendance >> totalAttendance
+            >> events >> totalEvents
+            >> reserve >> totalReserve
+            >> p.comment >> p.joinDate >> rank >> p.lastPromotionDate >> nextRank;
+        p.group = group;
+        p.rank = rank;
+        p.nextRank = nextRank;
+        p.level = level;
+        p.attendance = attendance;
+        p.totalAttendance = totalAttendance;
+        p.events = events;
+        p.totalEvents = totalEvents;
+        p.reserve = reserve;
+        p.totalReserve = totalReserve;
+    }
+
+    void writeTraining(QDataStream &out, const Training &t)
+    {
+        out << t.id << t.date << t.title << t.type.toString() << t.maps
+            << t.confirmedPlayers << t.declinedPlayers << t.noResponsePlayers;
+    }
+
+    void readTraining(QDataStream &in, Training &t)
+    {
+        QString type;
+        in >> t.id >> t.date >> t.title >> type >> t.maps
+            >> t.confirmedPlayers >> t.declinedPlayers >> t.noResponsePlayers;
+        t.type = type;
+    }
+}
+
+void DataSnapshot::setPaths(const QString &snapshotPath, const QStringList &sourceFiles)
+{
+    m_path = snapshotPath;
+    m_sources = sourceFiles;
+}
+
+QList<DataSnapshot::Stamp> DataSnapshot::currentStamps() const
+{
+    QList<Stamp> stamps;
+    for (const QString &source : m_sources)
+    {
+        const QFileInfo info(source);
+        Stamp stamp;
+        stamp.fileName = info.fileName();
+        if (info.exists())
+        {
+            stamp.size = info.size();
+            stamp.modified = info.lastModified().toMSecsSinceEpoch();
+        }
+        stamps.append(stamp);
+    }
+    return stamps;
+}
+
+bool DataSnapshot::write(const Contents &contents)
+{
+    m_error.clear();
+    QSaveFile file(m_path);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        m_error = file.errorString();
+        return false;
+    }
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << Magic << Version;
+
+    const QList<Stamp> stamps = currentStamps();
+    out << quint32(stamps.size());
+    for (const Stamp &stamp : stamps)
+        out << stamp.fileName << stamp.size << stamp.modified;
+
+    out << quint32(contents.players.size());
+    for (const Player &p : contents.players)
+        writePlayer(out, p);
+
+    // Teilnahmen als kompaktes JSON pro Spieler, damit sie ungeparst bleiben
+    const QStringList attendanceKeys = contents.attendance.keys();
+    out << quint32(attendanceKeys.size());
+    for (const QString &key : attendanceKeys)
+        out << key << contents.attendance.rawJson(key);
+    out << contents.attendanceNextSeq << qint32(contents.attendanceJournalLines);
+
+    out << quint32(contents.trainings.size());
+    for (const Training &t : contents.trainings)
+        writeTraining(out, t);
+
+    if (out.status() != QDataStream::Ok || !file.commit())
+    {
+        m_error = file.errorString();
+        return false;
+    }
+    return true;
+}
+
+bool DataSnapshot::read(Contents &contents)
+{
+    m_error.clear();
+    contents = Contents();
+    QFile file(m_path);
+    if (!file.exists() || !file.open(QIODevice::ReadOnly) || file.size() <= 0)
+        return false;
+
+    // Gemappt lesen; ohne Mapping einmal komplett einlesen
+    QByteArray bytes;
+    uchar *mapped = file.map(0, file.size());
+    if (mapped)
+        bytes = QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), file.size());
+    else
+        bytes = file.readAll();
+
+    QDataStream in(bytes);
+    in.setVersion(QDataStream::Qt_6_0);
+    const bool ok = readStream(in, bytes.size(), contents);
+
+    if (mapped)
+        file.unmap(mapped);
+    if (!ok)
+        contents = Contents();
+    return ok;
+}
+
+bool DataSnapshot::readStream(QDataStream &in, qint64 byteCount, Contents &contents)
+{
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if (magic != Magic || version != Version)
+    {
+        m_error = QStringLiteral("Unbekanntes Snapshot-Format");
+        return false;
+    }
+
+    quint32 stampCount = 0;
+    in >> stampCount;
+    const QList<Stamp> expected = currentStamps();
+    if (stampCount != quint32(expected.size()))
+    {
+        m_error = QStringLiteral("Snapshot veraltet");
+        return false;
+    }
+    for (const Stamp &current : expected)
+    {
+        Stamp stored;
+        in >> stored.fileName >> stored.size >> stored.modified;
+        if (stored.fileName != current.fileName || stored.size != current.size || stored.modified != current.modified)
+        {
+            m_error = QStringLiteral("Snapshot veraltet: %1").arg(current.fileName);
+            return false;
+        }
+    }
+
+    // Zähler gegen die Dateigröße prüfen, bevor Speicher reserviert wird
+    quint32 playerCount = 0;
+    in >> playerCount;
+    if (in.status() != QDataStream::Ok || playerCount > byteCount)
+    {
+        m_error = QStringLiteral("Snapshot beschädigt");
+        return false;
+    }
+    contents.players.resize(playerCount);
+    for (Player &p : contents.players)
+        readPlayer(in, p);
+
+    quint32 attendanceCount = 0;
+    in >> attendanceCount;
+    for (quint32 i = 0; i < attendanceCount && in.status() == QDataStream::Ok; ++i)
+    {
+        QString key;
+        QByteArray raw;
+        in >> key >> raw;
+        contents.attendance.setRaw(key, raw);
+    }
+    qint32 journalLines = 0;
+    in >> contents.attendanceNextSeq >> journalLines;
+    contents.attendanceJournalLines = journalLines;
+
+    quint32 trainingCount = 0;
+    in >> trainingCount;
+    for (quint32 i = 0; i < trainingCount && in.status() == QDataStream::Ok; ++i)
+    {
+        Training t;
+        readTraining(in, t);
+        contents.trainings.append(t);
+    }
+    if (in.status() != QDataStream::Ok)
+    {
+        m_error = QStringLiteral("Snapshot beschädigt");
+        return false;
+    }
+    return true;
+}
+
+bool DataSnapshot::remove()
+{
+    return !QFile::exists(m_path) || QFile::remove(m_path);
+}
@@ -0,0 +1,197 @@
+#include "EditDistance.h"
+#include <QVarLengthArray>
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+namespace
+{
+    // Ohne Schwelle: so groß, dass nie abgebrochen wird, ohne dass +1 überläuft
+    int effectiveLimit(int maxDistance)
+    {
+        return maxDistance < 0 ? INT_MAX - 1 : maxDistance;
+    }
+
+    // Zwei DP-Zeilen für Muster über 64 Zeichen; bricht ab, wenn das Zeilen-
+    // minimum die Schwelle übersteigt
+    int rowDistance(QStringView a, QStringView b, int limit)
+    {
+        const int m = a.size();
+        const int n = b.size();
+        QVarLengthArray<int, 256> rows(2 * (n + 1));
+        int *prev = rows.data();
+        int *cur = prev + n + 1;
+        for (int j = 0; j <= n; ++j)
+            prev[j] = j;
+        for (int i = 1; i <= m; ++i)
+        {
+            cur[0] = i;
+            int rowMin = cur[0];
+            const QChar ca = a[i - 1];
+            for (int j = 1; j <= n; ++j)
+            {
+                const int cost = (ca == b[j - 1]) ? 0 : 1;
+                cur[j] = std::min({prev[j] + 1, cur[j - 1] + 1, prev[j - 1] + cost});
+                rowMin = std::min(rowMin, cur[j]);
+            }
+            if (rowMin > limit)
+                return limit + 1;
+            std::swap(prev, cur);
+        }
+        return prev[n] <= limit ? prev[n] : limit + 1;
+    }
+}
+
+namespace EditDistance
+{
+    Pattern::Pattern(QStringView pattern)
+        : m_pattern(pattern), m_length(int(pattern.size()))
+    {
+        if (!isBitParallel())
+            return;
+        for (int i = 0; i < m_length; ++i)
+        {
+            const QChar c = pattern[i];
+            const quint64 bit = quint64(1) << i;
+            if (c.unicode() < 128)
+            {
+                m_ascii[c.unicode()] |= bit;
+                continue;
+            }
+            int slot = 0;
+            while (slot < m_otherCount && m_otherChars[slot] != c)
+                ++slot;
+            if (slot == m_otherCount)
+            {
+                m_otherChars[slot] = c;
+                ++m_otherCount;
+            }
+            m_otherMasks[slot] |= bit;
+        }
+    }
+
+    quint64 Pattern::mask(QChar c) const
+    {
+        if (c.unicode() < 128)
+            return m_ascii[c.unicode()];
+        for (int slot = 0; slot < m_otherCount; ++slot)
+        {
+            if (m_otherChars[slot] == c)
+                return m_otherMasks[slot];
+        }
+        return 0;
+    }
+
+    int Pattern::distanceTo(QStringView text, int maxDistance) const
+    {
+        const int limit = effectiveLimit(maxDistance);
+        const int m = m_length;
+        const int n = int(text.size());
+        if (std::abs(m - n) > limit)
+            return limit + 1;
+        if (m == 0 || n == 0)
+            return std::max(m, n);
+        if (!isBitParallel())
+            return rowDistance(m_pattern, text, limit);
+
+        // Myers/Hyyrö: vertikale Differenzen der DP-Spalte als Bitvektoren,
+        // score ist der Wert in der letzten Musterzeile
+        const quint64 last = quint64(1) << (m - 1);
+        quint64 pv = ~quint64(0);
+        quint64 mv = 0;
+        int score = m;
+        for (int j = 0; j < n; ++j)
+        {
+            const quint64 eq = mask(text[j]);
+            const quint64 xv = eq | mv;
+            const quint64 xh = (((eq & pv) + pv) ^ pv) | eq;
+            quint64 ph = mv | ~(xh | pv);
+            quint64 mh = pv & xh;
+            if (ph & last)
+                ++score;
+            else if (mh & last)
+                --score;
+            ph = (ph << 1) | 1;
+            mh <<= 1;
+            pv = mh | ~(xv | ph);
+            mv = ph & xv;
+            // Pro restlichem Textzeichen sinkt die Distanz höchstens um 1
+            if (score - (n - j - 1) > limit)
+                return limit + 1;
+        }
+        return score <= limit ? score : limit + 1;
+    }
+
+    int distance(QStringView a, QStringView b, int maxDistance)
+    {
+        const int limit = effectiveLimit(maxDistance);
+        if (std::abs(int(a.size()) - int(b.size())) > limit)
+            return limit + 1;
+        if (a == b)
+            return 0;
+        // Das kürzere Wort als Muster, damit es öfter in 64 Bit passt
+        if (a.size() > b.size())
+            std::swap(a, b);
+        return Pattern(a).distanceTo(b, maxDistance);
+    }
+
+    Roster::Roster(const QStringList &names)
+    {
+        for (const QString &name : names)
+            append(name);
+    }
+
+    void Roster::clear()
+    {
+        m_buffer.clear();
+        m_offsets.clear();
+        m_lengths.clear();
+    }
+
+    void Roster::append(QStringView name)
+    {
+        m_offsets.append(m_buffer.size());
+        m_lengths.append(int(name.size()));
+        m_buffer.append(name.data(), name.size());
+    }
+
+    QStringView Roster::name(int index) const
+    {
+        return QStringView(m_buffer.constData() + m_offsets.at(index), m_lengths.at(index));
+    }
+
+    void Roster::distances(QStringView candidate, int maxDistance, QVector<int> &out) const
+    {
+        const int limit = effectiveLimit(maxDistance);
+        const int count = size();
+        const int length = int(candidate.size());
+        out.resize(count);
+        // Erst nur über die Längen: Namen außerhalb der Schwelle gar nicht prüfen
+        const int *lengths = m_lengths.constData();
+        int *result = out.data();
+        for (int i = 0; i < count; ++i)
+            result[i] = std::abs(lengths[i] - length) > limit ? limit + 1 : -1;
+
+        const Pattern pattern(candidate);
+        for (int i = 0; i < count; ++i)
+        {
+            if (result[i] < 0)
+                result[i] = pattern.distanceTo(name(i), maxDistance);
+        }
+    }
+
+    int Roster::firstWithin(QStringView candidate, int maxDistance) const
+    {
+        const int limit = effectiveLimit(maxDistance);
+        const int length = int(candidate.size());
+        const Pattern pattern(candidate);
+        for (int i = 0; i < size(); ++i)
+        {
+            if (std::abs(m_lengths.at(i) - length) > limit)
+                continue;
+            if (pattern.distanceTo(name(i), maxDistance) <= limit)
+                return i;
+        }
+        return -1;
+    }
+}
@@ -0,0 +1,101 @@
+#include "EligibilityEngine.h"
+
+int EligibilityEngine::monthsBetween(const QDate &joinDate, const QDate &referenceDate)
+{
+    if (!joinDate.isValid())
+        return -1;
+    int months = (referenceDate.year() - joinDate.year()) * 12 + (referenceDate.month() - joinDate.month());
+    if (referenceDate.day() < joinDate.day())
+        months -= 1;
+    return qMax(0, months);
+}
+
+const EligibilityResult &EligibilityEngine::evaluate(const Player &player, const RankRequirement &req, const QDate &referenceDate, bool *resultChanged)
+{
+    Inputs inputs;
+    inputs.rank = player.rank;
+    inputs.level = player.level;
+    inputs.joinDate = player.joinDate;
+    inputs.attendance = player.attendance;
+    inputs.events = player.events;
+    inputs.reserve = player.reserve;
+    inputs.referenceDate = referenceDate;
+    inputs.requirementsVersion = m_requirementsVersion;
+
+    auto it = m_cache.find(player.name);
+    const bool known = (it != m_cache.end());
+    if (known && !it->dirty && it->inputs == inputs)
+    {
+        if (resultChanged)
+            *resultChanged = false;
+        return it->result;
+    }
+    if (!known)
+        it = m_cache.insert(player.name, Entry());
+
+    ++m_evaluations;
+    EligibilityResult result;
+    if (req.minMonths > 0)
+    {
+        if (!player.joinDate.isValid())
+        {
+            result.reasons << QString("kein Beitrittsdatum (benötigt: %1 Monate)").arg(req.minMonths);
+            result.ok = false;
+        }
+        else
+        {
+            int months = monthsBetween(player.joinDate, referenceDate);
+            if (months < req.minMonths)
+            {
+                result.reasons << QString("nur %1 Monate im Dienst (benötigt: %2)").arg(months).arg(req.minMonths);
+                result.ok = false;
+            }
+        }
+    }
+    if (req.minLevel > 0 && player.level < req.minLevel)
+    {
+        result.reasons << QString("Level %1/%2").arg(player.level).arg(req.minLevel);
+        result.ok = false;
+    }
+    if (req.minCombined > 0)
+    {
+        int combined = player.attendance + player.events + player.reserve;
+        if (combined < req.minCombined)
+        {
+            result.reasons << QString("T+E+R: %1/%2").arg(combined).arg(req.minCombined);
+            result.ok = false;
+        }
+    }
+    const bool hasRequirement = (req.minMonths > 0 || req.minCombined > 0 || req.minLevel > 0);
+    result.eligible = result.ok && hasRequirement;
+
+    if (resultChanged)
+        *resultChanged = !known || it->result.eligible != result.eligible || it->result.reasons != result.reasons;
+    it->inputs = inputs;
+    it->result = result;
+    it->dirty = false;
+    return it->result;
+}
+
+void EligibilityEngine::markDirty(const QString &playerKey)
+{
+    auto it = m_cache.find(playerKey);
+    if (it != m_cache.end())
+        it->dirty = true;
+}
+
+void EligibilityEngine::markAllDirty()
+{
+    for (auto it = m_cache.begin(); it != m_cache.end(); ++it)
+        it->dirty = true;
+}
+
+void EligibilityEngine::remove(const QString &playerKey)
+{
+    m_cache.remove(playerKey);
+}
+
+void EligibilityEngine::clear()
+{
+    m_cache.clear();
+}
@@ -0,0 +1,119 @@
+#include "FuzzyNameIndex.h"
+#include "EditDistance.h"
+#include <QVarLengthArray>
+#include <algorithm>
+
+void FuzzyNameIndex::clear()
+{
+    m_nodes.clear();
+    m_byKey.clear();
+    m_liveKeys = 0;
+    m_lastComparisons = 0;
+}
+
+void FuzzyNameIndex::insert(const QString &key, const QString &value)
+{
+    if (key.isEmpty())
+        return;
+    const auto known = m_byKey.constFind(key);
+    if (known != m_byKey.constEnd())
+    {
+        // Schlüssel schon im Baum (evtl. als leerer Knoten): nur Wert ergänzen
+        QStringList &values = m_nodes[known.value()].values;
+        if (values.isEmpty())
+            ++m_liveKeys;
+        if (!values.contains(value))
+            values.append(value);
+        return;
+    }
+
+    const int created = m_nodes.size();
+    Node node;
+    node.key = key;
+    node.values.append(value);
+    m_nodes.append(node);
+    m_byKey.insert(key, created);
+    ++m_liveKeys;
+    if (created == 0)
+        return;
+
+    const EditDistance::Pattern pattern(key);
+    int current = 0;
+    for (;;)
+    {
+        const int d = pattern.distanceTo(m_nodes.at(current).key);
+        QVector<QPair<int, int>> &children = m_nodes[current].children;
+        const auto child = std::find_if(children.cbegin(), children.cend(), [d](const QPair<int, int> &c)
+                                        { return c.first == d; });
+        if (child == children.cend())
+        {
+            children.append({d, created});
+            return;
+        }
+        current = child->second;
+    }
+}
+
+void FuzzyNameIndex::remove(const QString &key, const QString &value)
+{
+    const auto it = m_byKey.constFind(key);
+    if (it == m_byKey.constEnd())
+        return;
+    QStringList &values = m_nodes[it.value()].values;
+    if (values.removeOne(value) && values.isEmpty())
+        --m_liveKeys;
+}
+
+bool FuzzyNameIndex::contains(const QString &key) const
+{
+    const auto it = m_byKey.constFind(key);
+    return it != m_byKey.constEnd() && !m_nodes.at(it.value()).values.isEmpty();
+}
+
+QString FuzzyNameIndex::value(const QString &key) const
+{
+    const auto it = m_byKey.constFind(key);
+    if (it == m_byKey.constEnd() || m_nodes.at(it.value()).values.isEmpty())
+        return QString();
+    return m_nodes.at(it.value()).values.first();
+}
+
+QVector<FuzzyNameIndex::Match> FuzzyNameIndex::within(const QString &query, int maxDistance) const
+{
+    QVector<Match> matches;
+    m_lastComparisons = 0;
+    if (m_nodes.isEmpty() || maxDistance < 0)
+        return matches;
+
+    const EditDistance::Pattern pattern(query);
+    QVarLengthArray<int, 64> pending;
+    pending.append(0);
+    while (!pending.isEmpty())
+    {
+        const Node &node = m_nodes.at(pending.last());
+        pending.removeLast();
+        // Volle Distanz nötig, sie bestimmt die zu besuchenden Kinder
+        const int d = pattern.distanceTo(node.key);
+        ++m_lastComparisons;
+        if (d <= maxDistance && !node.values.isEmpty())
+            matches.append({node.key, node.values.first(), d});
+        for (const QPair<int, int> &child : node.children)
+        {
+            if (child.first >= d - maxDistance && child.first <= d + maxDistance)
+                pending.append(child.second);
+        }
+    }
+    std::sort(matches.begin(), matches.end(), [](const Match &a, const Match &b)
+              { return a.distance != b.distance ? a.distance < b.distance : a.key < b.key; });
+    return matches;
+}
+
+bool FuzzyNameIndex::nearest(const QString &query, int maxDistance, Match *out) const
+{
+    const QVector<Match> matches = within(query, maxDistance);
+    if (matches.isEmpty())
+        return false;
+    if (out)
+        *out = matches.first();
+    return true;
+}
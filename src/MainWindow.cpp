@@ -7,7 +7,6 @@
 #include <QVBoxLayout>
 #include <QMessageBox>
 #include <QItemSelectionModel>
-#include <QStandardItem>
 #include <QPushButton>
 #include <QFileDialog>
 #include <QFile>
@@ -45,6 +44,12 @@
 #include <algorithm>
 #include "LineupDialog.h"
 #include "LineupExporter.h"
+#include "CsvReader.h"
+#include "PlayerFilterIndex.h"
+#include "EditDistance.h"
+#include "FuzzyNameIndex.h"
+#include "OcrService.h"
+#include "OcrCache.h"
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QCheckBox>
@@ -61,6 +66,12 @@
 #include <QTabWidget>
 #include <QScrollArea>
 #include <QTextBrowser>
+#include <QProgressDialog>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QCollator>
+#include <QFutureWatcher>
+#include <QtConcurrent/QtConcurrentRun>
 
 namespace
 {
@@ -131,24 +142,55 @@ public:
     {
         int idx = 0;
         for (const QString &r : ranks)
-            rankOrder.insert(r, idx++);
+            rankOrder.insert(Symbol(r).id(), idx++);
         officerThreshold = INT_MAX;
     }
 
     void setRankFilter(const QString &f)
     {
         rankFilter = f;
-        invalidateFilter();
+        rankFilterSymbol = Symbol(f);
+        applyFilters();
     }
     void setGroupFilter(const QString &f)
     {
         groupFilter = f;
-        invalidateFilter();
+        groupFilterSymbol = Symbol(f);
+        applyFilters();
     }
     void setTextFilter(const QString &t)
     {
+        const QString previous = textFilter;
         textFilter = t;
-        invalidateFilter();
+        if (incrementalText && canRefineText(previous))
+            refineTextFilter();
+        else
+            applyFilters();
+    }
+    // Verlängert eine Anfrage die vorige, werden nur deren Treffer neu geprüft
+    void setIncrementalText(bool on) { incrementalText = on; }
+
+    void setSourceModel(QAbstractItemModel *source) override
+    {
+        // Vor den Verbindungen der Basisklasse, damit dynamisches Nachsortieren
+        // und Nachfiltern schon die frischen Schlüssel bzw. den Index sehen
+        for (const QMetaObject::Connection &c : sourceConnections)
+            disconnect(c);
+        sourceConnections.clear();
+        if (source)
+        {
+            auto invalidateAll = [this]()
+            { invalidateRowCaches(); };
+            sourceConnections << connect(source, &QAbstractItemModel::dataChanged, this, [this](const QModelIndex &topLeft, const QModelIndex &bottomRight)
+                                       { invalidateRowCaches(topLeft.row(), bottomRight.row()); })
+                              << connect(source, &QAbstractItemModel::rowsInserted, this, invalidateAll)
+                              << connect(source, &QAbstractItemModel::rowsRemoved, this, invalidateAll)
+                              << connect(source, &QAbstractItemModel::rowsMoved, this, invalidateAll)
+                              << connect(source, &QAbstractItemModel::modelReset, this, invalidateAll)
+                              << connect(source, &QAbstractItemModel::layoutChanged, this, invalidateAll);
+        }
+        invalidateRowCaches();
+        QSortFilterProxyModel::setSourceModel(source);
     }
 
 protected:
@@ -158,115 +200,272 @@ protected:
         if (!m)
             return QSortFilterProxyModel::lessThan(left, right);
 
-        auto stringValue = [&](int row, int column) -> QString
-        {
-            const int role = (column == 8) ? Qt::EditRole : Qt::DisplayRole;
-            return m->index(row, column).data(role).toString();
-        };
-        auto compareString = [](const QString &a, const QString &b) -> bool
-        {
-            return QString::localeAwareCompare(a, b) < 0;
-        };
-
         int column = sortColumn();
         if (column < 0)
             column = left.column();
+        ensureSortKeys(column);
+        const size_t l = static_cast<size_t>(left.row());
+        const size_t r = static_cast<size_t>(right.row());
+        if (l >= sortKeys.size() || r >= sortKeys.size())
+            return QSortFilterProxyModel::lessThan(left, right);
 
+        const SortKey &a = sortKeys[l];
+        const SortKey &b = sortKeys[r];
         switch (column)
         {
-        case 0:
-        case 1:
-        case 2:
-        case 4:
-        case 5:
-        case 6:
-            return compareString(stringValue(left.row(), column), stringValue(right.row(), column));
         case 3:
-        {
-            int lv = m->index(left.row(), 3).data(Qt::DisplayRole).toInt();
-            int rv = m->index(right.row(), 3).data(Qt::DisplayRole).toInt();
-            if (lv != rv)
-                return lv < rv;
-            return compareString(stringValue(left.row(), 0), stringValue(right.row(), 0));
-        }
+            if (a.primary != b.primary)
+                return a.primary < b.primary;
+            break;
         case 7:
-        {
-            QDate dl = QDate::fromString(stringValue(left.row(), 7), Qt::ISODate);
-            QDate dr = QDate::fromString(stringValue(right.row(), 7), Qt::ISODate);
-            if (dl.isValid() && dr.isValid() && dl != dr)
-                return dl < dr;
-            return compareString(stringValue(left.row(), 7), stringValue(right.row(), 7));
-        }
+            // Nur wenn beide Daten gültig sind, sonst wie bisher nach Text
+            if (a.primary != 0 && b.primary != 0 && a.primary != b.primary)
+                return a.primary < b.primary;
+            break;
         case 8:
-        {
-            QString rl = stringValue(left.row(), 8);
-            QString rr = stringValue(right.row(), 8);
-            int i1 = rankOrder.value(rl, INT_MAX);
-            int i2 = rankOrder.value(rr, INT_MAX);
-            if (i1 != i2)
-                return i1 < i2;
-            int lvl = m->index(left.row(), 3).data(Qt::DisplayRole).toInt();
-            int lvr = m->index(right.row(), 3).data(Qt::DisplayRole).toInt();
-            if (lvl != lvr)
-                return lvl < lvr;
-            return compareString(stringValue(left.row(), 0), stringValue(right.row(), 0));
-        }
+            if (a.primary != b.primary)
+                return a.primary < b.primary;
+            if (a.secondary != b.secondary)
+                return a.secondary < b.secondary;
+            break;
         default:
             break;
         }
-
-        QString n1 = stringValue(left.row(), 0);
-        QString n2 = stringValue(right.row(), 0);
-        return compareString(n1, n2);
+        return a.text.compare(b.text) < 0;
     }
 
     bool filterAcceptsRow(int source_row, const QModelIndex &source_parent) const override
     {
-        const QAbstractItemModel *m = sourceModel();
-        if (!m)
+        Q_UNUSED(source_parent);
+        if (!sourceModel())
             return true;
+        ensureAcceptedRows();
+        return source_row >= acceptedRows.size() || acceptedRows.testBit(source_row);
+    }
+
+private:
+    // Vorberechnete Sortierschlüssel je Quellzeile für die aktuelle Spalte.
+    // text ist die Spalte selbst (Level/Dienstrang: der Name als Tiebreaker),
+    // primary/secondary sind Level, Julianischer Tag bzw. Rang-Position und Level.
+    struct SortKey
+    {
+        QCollatorSortKey text;
+        qint64 primary;
+        qint64 secondary;
+    };
+
+    void invalidateRowCaches()
+    {
+        invalidateSortKeys();
+        filterIndexDirty = true;
+        acceptedDirty = true;
+    }
+    void invalidateRowCaches(int first, int last)
+    {
+        invalidateSortKeys(first, last);
+        if (!filterIndexDirty)
+        {
+            for (int row = qMax(0, first); row <= last && row < filterIndex.rowCount(); ++row)
+                staleFilterRows.insert(row);
+        }
+        acceptedDirty = true;
+    }
+
+    bool groupFilterActive() const { return !groupFilter.isEmpty() && groupFilter != "Alle Gruppen"; }
+    bool rankFilterActive() const { return !rankFilter.isEmpty() && rankFilter != "Alle Ränge"; }
+
+    // Neu filtern nur, wenn sich die Treffermenge wirklich geändert hat;
+    // filterAcceptsRow ist danach nur noch ein Bit-Test
+    void applyFilters()
+    {
+        if (!sourceModel())
+            return;
+        const QBitArray before = acceptedRows;
+        acceptedDirty = true;
+        ensureAcceptedRows();
+        if (acceptedRows != before)
+            invalidateRowsFilter();
+    }
+
+    // Nur wenn die bisherige Treffermenge aktuell ist und die neue Anfrage die
+    // alte enthält; Gruppe und Rang sind dabei unverändert geblieben
+    bool canRefineText(const QString &previous) const
+    {
+        if (!sourceModel() || previous.isEmpty() || textFilter.isEmpty())
+            return false;
+        if (acceptedDirty || acceptedRows.size() != sourceModel()->rowCount())
+            return false;
+        return textFilter.toCaseFolded().contains(previous.toCaseFolded());
+    }
+
+    void refineTextFilter()
+    {
+        ensureFilterIndex();
+        const QBitArray refined = filterIndex.refineText(textFilter, acceptedRows);
+        if (refined == acceptedRows)
+            return;
+        acceptedRows = refined;
+        invalidateRowsFilter();
+    }
+
+    PlayerFilterIndex::Row filterRow(int row) const
+    {
+        const QAbstractItemModel *m = sourceModel();
+        PlayerFilterIndex::Row data;
+        data.name = m->index(row, 0).data().toString();
+        data.t17name = m->index(row, 2).data().toString();
+        data.group = m->index(row, 4).data().toString();
+        data.groupId = m->index(row, 4).data(PlayerTableModel::SymbolRole).toUInt();
+        data.rankId = m->index(row, 8).data(PlayerTableModel::SymbolRole).toUInt();
+        return data;
+    }
 
-        if (!groupFilter.isEmpty() && groupFilter != "Alle Gruppen")
+    void ensureFilterIndex() const
+    {
+        const int rows = sourceModel()->rowCount();
+        if (filterIndexDirty || filterIndex.rowCount() != rows)
         {
-            QString g = m->index(source_row, 4, source_parent).data().toString(); // group col
-            if (g != groupFilter)
-                return false;
+            filterIndex.reset(rows);
+            for (int row = 0; row < rows; ++row)
+                filterIndex.setRow(row, filterRow(row));
+            staleFilterRows.clear();
+            filterIndexDirty = false;
+            return;
         }
+        for (int row : std::as_const(staleFilterRows))
+            filterIndex.setRow(row, filterRow(row));
+        staleFilterRows.clear();
+    }
 
-        if (!rankFilter.isEmpty() && rankFilter != "Alle Ränge")
+    void ensureAcceptedRows() const
+    {
+        const int rows = sourceModel()->rowCount();
+        if (!acceptedDirty && acceptedRows.size() == rows)
+            return;
+        acceptedDirty = false;
+        // Ohne aktive Filter wird der Index gar nicht erst aufgebaut
+        if (!groupFilterActive() && !rankFilterActive() && textFilter.isEmpty())
         {
+            acceptedRows = QBitArray(rows, true);
+            return;
+        }
+        ensureFilterIndex();
+        QBitArray accepted = filterIndex.all();
+        if (groupFilterActive())
+            accepted &= filterIndex.matchGroup(groupFilterSymbol.id());
+        if (rankFilterActive())
+        {
+            QSet<quint32> ranks;
             if (rankFilter == "Nur Offiziere")
             {
-                QString r = m->index(source_row, 8, source_parent).data(Qt::EditRole).toString();
-                int idx = rankOrder.value(r, -1);
-                if (idx < officerThreshold)
-                    return false;
+                for (auto it = rankOrder.constBegin(); it != rankOrder.constEnd(); ++it)
+                {
+                    if (it.value() >= officerThreshold)
+                        ranks.insert(it.key());
+                }
             }
             else
             {
-                QString r = m->index(source_row, 8, source_parent).data(Qt::EditRole).toString();
-                if (r != rankFilter)
-                    return false;
+                ranks.insert(rankFilterSymbol.id());
             }
+            accepted &= filterIndex.matchRanks(ranks);
         }
-
         if (!textFilter.isEmpty())
+            accepted &= filterIndex.matchText(textFilter);
+        acceptedRows = accepted;
+    }
+
+    void invalidateSortKeys()
+    {
+        sortKeys.clear();
+        staleSortRows.clear();
+        sortKeyColumn = -1;
+    }
+    void invalidateSortKeys(int first, int last)
+    {
+        if (sortKeyColumn < 0)
+            return;
+        for (int row = qMax(0, first); row <= last && row < static_cast<int>(sortKeys.size()); ++row)
+            staleSortRows.insert(row);
+    }
+
+    SortKey makeSortKey(int row, int column) const
+    {
+        const QAbstractItemModel *m = sourceModel();
+        auto text = [&](int col) -> QString
+        {
+            const int role = (col == 8) ? Qt::EditRole : Qt::DisplayRole;
+            return m->index(row, col).data(role).toString();
+        };
+        auto level = [&]() -> qint64
+        {
+            return m->index(row, 3).data(Qt::DisplayRole).toInt();
+        };
+        switch (column)
+        {
+        case 0:
+        case 1:
+        case 2:
+        case 4:
+        case 5:
+        case 6:
+            return {sortCollator.sortKey(text(column)), 0, 0};
+        case 3:
+            return {sortCollator.sortKey(text(0)), level(), 0};
+        case 7:
+        {
+            const QString value = text(7);
+            const QDate date = QDate::fromString(value, Qt::ISODate);
+            return {sortCollator.sortKey(value), date.isValid() ? date.toJulianDay() : 0, 0};
+        }
+        case 8:
         {
-            QString txt = textFilter;
-            QString n = m->index(source_row, 0, source_parent).data().toString();
-            QString t17 = m->index(source_row, 2, source_parent).data().toString();
-            QString g = m->index(source_row, 4, source_parent).data().toString();
-            if (!n.contains(txt, Qt::CaseInsensitive) && !t17.contains(txt, Qt::CaseInsensitive) && !g.contains(txt, Qt::CaseInsensitive))
-                return false;
+            const quint32 rank = m->index(row, 8).data(PlayerTableModel::SymbolRole).toUInt();
+            return {sortCollator.sortKey(text(0)), rankOrder.value(rank, INT_MAX), level()};
+        }
+        default:
+            return {sortCollator.sortKey(text(0)), 0, 0};
         }
+    }
 
-        return true;
+    // Einmal pro Sortierung aufbauen; geänderte Zeilen einzeln nachziehen
+    void ensureSortKeys(int column) const
+    {
+        const int rows = sourceModel()->rowCount();
+        if (sortKeyColumn != column || static_cast<int>(sortKeys.size()) != rows)
+        {
+            sortKeys.clear();
+            sortKeys.reserve(static_cast<size_t>(rows));
+            for (int row = 0; row < rows; ++row)
+                sortKeys.push_back(makeSortKey(row, column));
+            staleSortRows.clear();
+            sortKeyColumn = column;
+            return;
+        }
+        for (int row : std::as_const(staleSortRows))
+            sortKeys[static_cast<size_t>(row)] = makeSortKey(row, column);
+        staleSortRows.clear();
     }
 
-private:
-    QMap<QString, int> rankOrder;
+    QCollator sortCollator;
+    mutable std::vector<SortKey> sortKeys;
+    mutable QSet<int> staleSortRows;
+    mutable int sortKeyColumn = -1;
+    QList<QMetaObject::Connection> sourceConnections;
+
+    mutable PlayerFilterIndex filterIndex;
+    mutable QSet<int> staleFilterRows;
+    mutable bool filterIndexDirty = true;
+    mutable QBitArray acceptedRows;
+    mutable bool acceptedDirty = true;
+    bool incrementalText = true;
+
+    // Gruppe und Rang werden über Symbol-IDs verglichen
+    QHash<quint32, int> rankOrder;
     QString rankFilter;
     QString groupFilter;
+    Symbol rankFilterSymbol;
+    Symbol groupFilterSymbol;
     QString textFilter;
     int officerThreshold;
 };
@@ -390,19 +589,13 @@ public:
             return;
         QString val = cb->currentText().trimmed();
         if (val.isEmpty())
-        {
-            model->setData(index, QString(), Qt::EditRole);
             return;
-        }
 
         QMessageBox::StandardButton res = QMessageBox::question(m_main, "Kommentar bestätigen",
                                                                 QString("Kommentar '%1' hinzufügen und ins Log schreiben?").arg(val),
                                                                 QMessageBox::Yes | QMessageBox::No);
         if (res != QMessageBox::Yes)
-        {
-            model->setData(index, QString(), Qt::EditRole);
             return;
-        }
 
         if (!m_main->commentOptions.contains(val))
         {
@@ -417,14 +610,8 @@ public:
             srcIndex = proxy->mapToSource(index);
 
         QString playerKey;
-        const QStandardItemModel *srcModel = qobject_cast<const QStandardItemModel *>(srcIndex.model());
-        if (srcModel && srcIndex.isValid())
-        {
-            int actionCol = srcModel->columnCount() - 1;
-            const QStandardItem *actItem = srcModel->item(srcIndex.row(), actionCol);
-            if (actItem)
-                playerKey = actItem->data(Qt::UserRole + 1).toString();
-        }
+        if (srcIndex.isValid())
+            playerKey = srcIndex.data(PlayerTableModel::PlayerKeyRole).toString();
 
         if (!playerKey.isEmpty())
         {
@@ -434,8 +621,8 @@ public:
             m_main->appendSoldbuchEntry(playerKey, "Comment", data, QDateTime::currentDateTime());
             m_main->updateEligibilityForPlayerKey(playerKey);
         }
-
-        model->setData(index, QString(), Qt::EditRole);
+        // Kein setData: der Kommentar geht nur ins Soldbuch, Player::comment
+        // (Bearbeiten-Dialog, CSV-Import) bleibt unverändert
     }
 
 private:
@@ -579,6 +766,8 @@ MainWindow::MainWindow(QWidget *parent)
     table = nullptr;
     proxy = nullptr;
     searchEdit = nullptr;
+    searchDebounce = nullptr;
+    ocrService = nullptr;
     filterModeCombo = nullptr;
     rankFilterCombo = nullptr;
     groupFilterCombo = nullptr;
@@ -610,8 +799,31 @@ MainWindow::MainWindow(QWidget *parent)
     incrementCounterOnNoResponse = true;
     resetCounterOnResponse = true;
     showCounterInTable = true;
+    useBinarySnapshot = true;
+    incrementalSearch = true;
+    csvFuzzyMerge = false;
+    ocrPreprocess = true;
     hintColumnName = "Hinweis";
+
+    // Häufig geänderte Dateien werden gebündelt geschrieben
+    persistence.registerStore(PlayersStore, [this]()
+                              { writePlayersFile(); });
+    persistence.registerStore(AttendanceStore, [this]()
+                              { writeAttendanceFile(); });
+    attendanceJournal.setPaths(dataFilePath("clan_attendance_log.json"), dataFilePath("clan_attendance_log.jsonl"));
+    soldbuchLog.setPaths(dataFilePath("clan_soldbuch.jsonl"), dataFilePath("clan_soldbuch.idx"), dataFilePath("clan_soldbuch_log.json"));
+    dataSnapshot.setPaths(dataFilePath("clan_snapshot.bin"),
+                          {dataFilePath("clan_players.json"), dataFilePath("clan_attendance_log.json"),
+                           dataFilePath("clan_attendance_log.jsonl"), dataFilePath("clan_sessions.json")});
+    if (QCoreApplication *app = QCoreApplication::instance())
+        connect(app, &QCoreApplication::aboutToQuit, this, [this]()
+                { writeDataSnapshot(); });
     
+    ocrService = new OcrService(this);
+    // Erneut hochgeladene Screenshots ohne zweiten Tesseract-Lauf
+    ocrService->setCache(std::make_shared<OcrCache>(OcrCache::defaultDirectory()));
+    ocrService->setRosterParser(rosterParser);
+
     qDebug() << "MainWindow: Starting UI initialization...";
     
     try {
@@ -641,11 +853,16 @@ void MainWindow::initializeUI()
     QWidget *central = new QWidget(this);
     setCentralWidget(central);
 
-    model = new QStandardItemModel(this);
-    QStringList headers = {"Spielername", hintColumnName, "T17-Name", "Level", "Gruppe", "Einsätze", "Kommentar", "Beitrittsdatum", "Dienstrang", "Aktion"};
-    model->setHorizontalHeaderLabels(headers);
+    model = new PlayerTableModel(&list, this, this);
+    model->setHeaderData(PlayerTableModel::StatusColumn, Qt::Horizontal, hintColumnName);
+    // Bearbeitungen in der Tabelle schreiben direkt in den Player; hier nur prüfen und speichern
+    connect(model, &PlayerTableModel::playerEdited, this, [this](int row)
+            {
+        validateRow(row);
+        savePlayers(); });
 
     table = new QTableView(this);
+    table->setObjectName("playerTable");
     QHeaderView *header = table->horizontalHeader();
     header->setSectionResizeMode(QHeaderView::Stretch);
     header->setSectionResizeMode(1, QHeaderView::Interactive);
@@ -743,6 +960,7 @@ void MainWindow::initializeUI()
     filterLay->setSpacing(6);
     QLabel *searchLbl = new QLabel("Suche:", this);
     searchEdit = new QLineEdit(this);
+    searchEdit->setObjectName("searchEdit");
     searchEdit->setPlaceholderText("Name, T17 oder Gruppe...");
 
     filterModeCombo = new QComboBox(this);
@@ -946,19 +1164,15 @@ void MainWindow::initializeUI()
         if (paren > 0) playerName = text.left(paren);
 
         bool found = false;
-        for (Player &p : list.players) {
-            if (p.name == playerName) {
-                found = true;
-                p.noResponseCounter++;
-                int row = rowForPlayerKey(playerName);
-                if (row >= 0) validateRow(row);
-                break;
-            }
+        if (Player *p = list.findByName(playerName)) {
+            found = true;
+            p->noResponseCounter++;
+            int row = rowForPlayerKey(playerName);
+            if (row >= 0) model->playerChanged(row, PlayerTableModel::StatusColumn, PlayerTableModel::TrainingColumn);
         }
         if (!found) {
             // Spieler existiert nicht in Stammliste: anlegen mit Counter=1
             Player np; np.name = playerName; np.group = unassignedGroupName; np.noResponseCounter = 1; np.joinDate = nowDate();
-            list.players.push_back(np);
             addPlayerToModel(np);
             validateRow(model->rowCount()-1);
             savePlayers();
@@ -970,7 +1184,7 @@ void MainWindow::initializeUI()
         refreshSessionPlayerLists();
         // UI-Text aktualisieren mit neuem Counter
         int cnt = 0;
-        for (const Player &p : list.players) { if (p.name == playerName) { cnt = p.noResponseCounter; break; } }
+        if (const Player *p = list.findByName(playerName)) cnt = p->noResponseCounter;
         item->setText(QStringLiteral("%1 (NR: %2)").arg(playerName).arg(cnt));
         QMessageBox::information(this, "Test Counter", QStringLiteral("Counter für '%1' ist jetzt %2").arg(playerName).arg(cnt));
         updateSessionSummary(); });
@@ -981,410 +1195,99 @@ void MainWindow::initializeUI()
             {
         QFileDialog::Options opts;
         opts |= QFileDialog::DontUseNativeDialog;
-        QString file = QFileDialog::getOpenFileName(this, QStringLiteral("Bild mit Spielerliste wählen"), QDir::homePath(),
-                                                    QStringLiteral("Bilder (*.png *.jpg *.jpeg *.bmp *.tif *.tiff);;Alle Dateien (*.*)"), nullptr, opts);
-        if (file.isEmpty())
+        // Mehrere Screenshots einer langen Liste werden zusammen erkannt
+        const QStringList files = QFileDialog::getOpenFileNames(this, QStringLiteral("Bilder mit Spielerliste wählen"), QDir::homePath(),
+                                                                QStringLiteral("Bilder (*.png *.jpg *.jpeg *.bmp *.tif *.tiff);;Alle Dateien (*.*)"), nullptr, opts);
+        if (files.isEmpty())
             return;
-        QProcess proc;
-        QString program = QStringLiteral("tesseract");
-        QStringList args;
-        args << file << QStringLiteral("stdout") << QStringLiteral("-l") << QStringLiteral("deu");
-        proc.start(program, args);
-        if (!proc.waitForStarted(5000))
-        {
-            QMessageBox::warning(this, QStringLiteral("Tesseract fehlt"),
-                                 QStringLiteral("Tesseract konnte nicht gestartet werden. Bitte installieren (z.B. via Homebrew: brew install tesseract)."));
+        // Erkennung läuft im Hintergrund; ein neuer Upload ersetzt einen laufenden
+        if (sessionOcrJob)
+            ocrService->cancel(sessionOcrJob);
+        sessionOcrJob = startOcrJob(this, files); });
+    connect(ocrService, &OcrService::finished, this, [this](const OcrResult &ocr)
+            {
+        if (ocr.job != sessionOcrJob)
             return;
-        }
-        proc.waitForFinished(-1);
-        QByteArray out = proc.readAllStandardOutput();
-        QByteArray err = proc.readAllStandardError();
-        if (proc.exitStatus() != QProcess::NormalExit || proc.exitCode() != 0)
-        {
-            QMessageBox::warning(this, QStringLiteral("OCR-Fehler"),
-                                 QStringLiteral("Die Texterkennung ist fehlgeschlagen.\n%1").arg(QString::fromUtf8(err)));
+        sessionOcrJob = 0;
+        if (reportOcrError(this, ocr))
             return;
-        }
-        QString textRaw = QString::fromUtf8(out);
-        QString textLower = textRaw.toLower();
-
-        // Event-Metadaten aus OCR extrahieren (falls vorhanden)
-        QString extractedEventName;
-        QDate extractedDate;
-        QString extractedMap;
-        bool isTraining = false;
-        
-        QStringList allLines = textRaw.split(QRegularExpression("[\\r\\n]+"), Qt::SkipEmptyParts);
-        
-        // Training vs Event Erkennung
-        QStringList trainingKeywords = {"training", "clantraining", "freitagstraining", "montagstraining", "übung", "practice", "drill"};
-        QStringList eventKeywords = {"event", "vs", "versus", "match", "scrim", "scrimmage", "gegen"};
-        for (const QString &line : allLines) {
-            QString lineLower = line.toLower();
-            for (const QString &kw : trainingKeywords) {
-                if (lineLower.contains(kw)) { isTraining = true; break; }
-            }
-            if (!isTraining) {
-                for (const QString &kw : eventKeywords) {
-                    if (lineLower.contains(kw)) { isTraining = false; break; }
-                }
-            }
-        }
-        
-        // Parse Zusagen/Absagen
-        QSet<QString> acceptedPlayers, rejectedPlayers;
-        QRegularExpression acceptedRx(QStringLiteral(R"(Akzeptiert\s*\((\d+)\))"), QRegularExpression::CaseInsensitiveOption);
-        QRegularExpression tankRx(QStringLiteral(R"(Tank\s*\((\d+)\))"), QRegularExpression::CaseInsensitiveOption);
-        QRegularExpression rejectedRx(QStringLiteral(R"(Abgelehnt\s*\((\d+)\))"), QRegularExpression::CaseInsensitiveOption);
-        int acceptedIdx = -1, tankIdx = -1, rejectedIdx = -1;
-        for (int i = 0; i < allLines.size(); ++i) {
-            QString line = allLines[i];
-            if (acceptedRx.match(line).hasMatch()) acceptedIdx = i;
-            if (tankRx.match(line).hasMatch()) tankIdx = i;
-            if (rejectedRx.match(line).hasMatch()) rejectedIdx = i;
-        }
-        if (acceptedIdx >= 0) {
-            int nextIdx = qMin(tankIdx >= 0 ? tankIdx : allLines.size(), rejectedIdx >= 0 ? rejectedIdx : allLines.size());
-            for (int i = acceptedIdx + 1; i < nextIdx && i < allLines.size(); ++i) {
-                QString line = allLines[i].trimmed();
-                if (line.length() >= 3 && line.length() <= 48) acceptedPlayers.insert(line);
-            }
-        }
-        if (tankIdx >= 0) {
-            int nextIdx = rejectedIdx >= 0 ? rejectedIdx : allLines.size();
-            for (int i = tankIdx + 1; i < nextIdx && i < allLines.size(); ++i) {
-                QString line = allLines[i].trimmed();
-                if (line.length() >= 3 && line.length() <= 48) acceptedPlayers.insert(line);
-            }
-        }
-        if (rejectedIdx >= 0) {
-            for (int i = rejectedIdx + 1; i < allLines.size(); ++i) {
-                QString line = allLines[i].trimmed();
-                if (line.length() >= 3 && line.length() <= 48) rejectedPlayers.insert(line);
-            }
-        }
-        
-        if (!allLines.isEmpty()) {
-            QString firstLine = allLines.first().trimmed();
-            if (firstLine.length() >= 5 && firstLine.length() <= 80) {
-                extractedEventName = firstLine;
-            }
-        }
-        
-        QRegularExpression dateRx(QStringLiteral(R"(\b(\d{1,2})[\.\-/](\d{1,2})[\.\-/](\d{4})\b)"));
-        QRegularExpressionMatch dateMatch = dateRx.match(textRaw);
-        if (dateMatch.hasMatch()) {
-            int day = dateMatch.captured(1).toInt();
-            int month = dateMatch.captured(2).toInt();
-            int year = dateMatch.captured(3).toInt();
-            QDate parsedDate(year, month, day);
-            if (parsedDate.isValid()) {
-                extractedDate = parsedDate;
-            }
-        }
-        
-        QStringList knownMaps = {"SME", "Carentan", "Foy", "Kursk", "Stalingrad", "Omaha", "Utah", 
-                                 "Purple Heart Lane", "Hill 400", "Hurtgen", "Sainte", "SMDM"};
-        for (const QString &map : knownMaps) {
-            if (textRaw.contains(map, Qt::CaseInsensitive)) {
-                extractedMap = map;
-                break;
-            }
-        }
+        const QString textLower = ocr.text.toLower();
 
-        // Levenshtein-Distanz Hilfsfunktion
-        auto levenshtein = [](const QString &s1, const QString &s2) -> int {
-            const int m = s1.size(), n = s2.size();
-            QVector<QVector<int>> dp(m+1, QVector<int>(n+1));
-            for (int i=0; i<=m; ++i) dp[i][0] = i;
-            for (int j=0; j<=n; ++j) dp[0][j] = j;
-            for (int i=1; i<=m; ++i) {
-                for (int j=1; j<=n; ++j) {
-                    int cost = (s1[i-1] == s2[j-1]) ? 0 : 1;
-                    dp[i][j] = std::min({dp[i-1][j]+1, dp[i][j-1]+1, dp[i-1][j-1]+cost});
-                }
-            }
-            return dp[m][n];
-        };
+        // Abschnitte, Event-Daten, Typ und Namenskandidaten (im Worker ausgewertet)
+        const RosterTextParser::Result &roster = ocr.roster;
+        const QString &extractedEventName = roster.eventName;
+        const QDate &extractedDate = roster.date;
+        const QString &extractedMap = roster.map;
+        const bool isTraining = roster.training;
+        const QSet<QString> acceptedPlayers(roster.accepted.cbegin(), roster.accepted.cend());
+        const QSet<QString> rejectedPlayers(roster.rejected.cbegin(), roster.rejected.cend());
 
         QSet<QString> recognized;
-        QMap<QString, QString> existingByLower;
         for (const Player &p : list.players)
         {
-            if (!p.name.isEmpty()) existingByLower.insert(p.name.toLower(), p.name);
-            if (!p.t17name.isEmpty()) existingByLower.insert(p.t17name.toLower(), p.name);
             const QString name = p.name.toLower();
             const QString t17 = p.t17name.toLower();
             if ((!name.isEmpty() && textLower.contains(name)) || (!t17.isEmpty() && textLower.contains(t17)))
                 recognized.insert(p.name);
         }
-        
-        // Rang-Präfixe zum Trennen von Namen
-        QStringList rankPrefixes = MainWindow::rankOptions();
-        
-        // Hilfsfunktion: Trenne Namen mit mehreren Rängen oder Leerzeichen + Großbuchstabe
-        auto splitNames = [&rankPrefixes](const QString &text) -> QStringList {
-            QStringList result;
-            QString current = text.trimmed();
-            
-            // Finde alle Vorkommen von Rängen
-            QList<int> rankPositions;
-            for (const QString &rank : rankPrefixes) {
-                if (rank.isEmpty()) continue;
-                QRegularExpression rx(QRegularExpression::escape(rank), 
-                                     QRegularExpression::CaseInsensitiveOption);
-                QRegularExpressionMatchIterator it = rx.globalMatch(current);
-                while (it.hasNext()) {
-                    QRegularExpressionMatch match = it.next();
-                    rankPositions << match.capturedStart();
-                }
-            }
-            
-            // Wenn mehrere Ränge: trenne bei jedem Rang
-            if (rankPositions.size() > 1) {
-                std::sort(rankPositions.begin(), rankPositions.end());
-                for (int i = 0; i < rankPositions.size(); ++i) {
-                    int start = rankPositions[i];
-                    int end = (i + 1 < rankPositions.size()) ? rankPositions[i + 1] : current.length();
-                    QString segment = current.mid(start, end - start).trimmed();
-                    if (!segment.isEmpty() && segment.length() >= 3)
-                        result << segment;
-                }
-                return result;
-            }
-            
-            // Fallback: Trenne bei Leerzeichen + Kleinbuchstabe oder Großbuchstabe
-            QRegularExpression splitPattern1("\\s+(?=[a-zäöüß])");
-            QStringList parts1 = current.split(splitPattern1, Qt::SkipEmptyParts);
-            if (parts1.size() > 1) {
-                for (const QString &p : parts1) {
-                    if (p.trimmed().length() >= 3)
-                        result << p.trimmed();
-                }
-                if (!result.isEmpty()) return result;
-            }
-            
-            QRegularExpression splitPattern2("\\s+(?=[A-ZÄÖÜ])");
-            QStringList parts2 = current.split(splitPattern2, Qt::SkipEmptyParts);
-            if (parts2.size() > 1) {
-                for (const QString &p : parts2) {
-                    if (p.trimmed().length() >= 3)
-                        result << p.trimmed();
-                }
-                if (!result.isEmpty()) return result;
-            }
-            
-            if (!current.isEmpty() && current.length() >= 3)
-                result << current;
-            return result;
-        };
-        
-        // Alle Spieler aus acceptedPlayers und rejectedPlayers sammeln (mit Trennung)
-        QSet<QString> allParsedPlayers;
-        for (const QString &player : acceptedPlayers) {
-            for (const QString &split : splitNames(player))
-                allParsedPlayers.insert(split);
-        }
-        for (const QString &player : rejectedPlayers) {
-            for (const QString &split : splitNames(player))
-                allParsedPlayers.insert(split);
-        }
-        
-        // Kandidaten aus Zeilen/Kommas bilden
-        QSet<QString> candidates;
-        auto addCandidate = [&candidates](const QString &s){ QString c=s; c.replace('\t',' '); c.replace(QRegularExpression("\\s+"), " "); c=c.trimmed(); if(c.size()>=3 && c.size()<=48) candidates.insert(c); };
-        
-        // Hilfsfunktion: Teile String bei mehrfach vorkommenden Rängen
-        auto splitByRanks = [&rankPrefixes](const QString &text) -> QStringList {
-            QStringList result;
-            QString current = text.trimmed();
-            
-            // Finde alle Vorkommen von Rängen im Text
-            QList<int> rankPositions;
-            QList<QString> foundRanks;
-            
-            for (const QString &rank : rankPrefixes) {
-                if (rank.isEmpty()) continue;
-                
-                // Suche nach Rang-Vorkommen (case-insensitive)
-                QRegularExpression rx(QRegularExpression::escape(rank), 
-                                     QRegularExpression::CaseInsensitiveOption);
-                QRegularExpressionMatchIterator it = rx.globalMatch(current);
-                while (it.hasNext()) {
-                    QRegularExpressionMatch match = it.next();
-                    rankPositions << match.capturedStart();
-                    foundRanks << rank;
-                }
-            }
-            
-            // Wenn mehr als ein Rang gefunden wurde, trenne bei jedem Rang
-            if (rankPositions.size() > 1) {
-                // Sortiere nach Position
-                QList<QPair<int, QString>> posRankPairs;
-                for (int i = 0; i < rankPositions.size(); ++i) {
-                    posRankPairs << qMakePair(rankPositions[i], foundRanks[i]);
-                }
-                std::sort(posRankPairs.begin(), posRankPairs.end());
-                
-                for (int i = 0; i < posRankPairs.size(); ++i) {
-                    int start = posRankPairs[i].first;
-                    int end = (i + 1 < posRankPairs.size()) ? posRankPairs[i + 1].first : current.length();
-                    QString segment = current.mid(start, end - start).trimmed();
-                    if (!segment.isEmpty())
-                        result << segment;
-                }
-                return result;
-            }
-            
-            // Fallback: Trenne bei Leerzeichen gefolgt von Kleinbuchstabe oder Großbuchstabe
-            // Dies erfasst sowohl "GefrBuddy eiben" als auch "Buddy Eiben" (Namen ohne Rang)
-            if (!current.isEmpty()) {
-                // Versuche zuerst Trennung bei Leerzeichen + Kleinbuchstabe
-                QRegularExpression splitPattern1("\\s+(?=[a-zäöüß])");
-                QStringList parts1 = current.split(splitPattern1, Qt::SkipEmptyParts);
-                if (parts1.size() > 1) {
-                    result = parts1;
-                    return result;
-                }
-                
-                // Dann versuche Trennung bei Leerzeichen + Großbuchstabe (für Namen ohne Rang)
-                // Aber nur wenn kein Rang am Anfang des zweiten Teils steht
-                QRegularExpression splitPattern2("\\s+(?=[A-ZÄÖÜ])");
-                QStringList parts2 = current.split(splitPattern2, Qt::SkipEmptyParts);
-                if (parts2.size() > 1) {
-                    // Prüfe ob Teile valide Namen sind (nicht nur einzelne Buchstaben)
-                    bool allValid = true;
-                    for (const QString &part : parts2) {
-                        if (part.trimmed().length() < 2) {
-                            allValid = false;
-                            break;
-                        }
-                    }
-                    if (allValid) {
-                        result = parts2;
-                        return result;
-                    }
-                }
-            }
-            
-            if (result.isEmpty())
-                result << current;
-            return result;
-        };
-        
-        // Falls wir Status-Kategorien gefunden haben, verwende diese als Kandidaten
-        if (!allParsedPlayers.isEmpty()) {
-            for (const QString &player : allParsedPlayers) {
-                QStringList subParts = splitByRanks(player);
-                for (const QString &sub : subParts) addCandidate(sub);
-            }
-        }
-        
-        // Falls keine Status-Kategorien gefunden wurden, verwende Fallback
-        if (candidates.isEmpty()) {
-            const QStringList lines = textRaw.split(QRegularExpression("[\\r\\n]+"), Qt::SkipEmptyParts);
-            for (const QString &ln : lines) {
-                const QStringList parts = ln.split(',', Qt::SkipEmptyParts);
-                if (parts.size()>1) { 
-                    for (const QString &p : parts) {
-                        QStringList subParts = splitByRanks(p);
-                        for (const QString &sub : subParts) addCandidate(sub);
-                    }
-                }
-                else { 
-                    QStringList subParts = splitByRanks(ln);
-                    for (const QString &sub : subParts) addCandidate(sub);
-                }
-            }
-        }
+
         // Unbekannte Spieler automatisch anlegen in Gruppe "Nicht zugewiesen" (mit Fuzzy-Matching)
         const QString unassignedGroup = QStringLiteral("Nicht zugewiesen");
         QSet<QString> created;
-        constexpr int fuzzyThreshold = 2;
-        for (const QString &cand : std::as_const(candidates))
+        QList<int> createdRows;
+        const int fuzzyThreshold = fuzzyMatchThreshold;
+        // Zusagen sind wenige: einmal als Liste aufbauen. Bekannte Namen kommen aus
+        // dem Fuzzy-Index der Spielerliste, neu angelegte Spieler landen dort mit.
+        EditDistance::Roster acceptedRoster;
+        for (const QString &acc : std::as_const(acceptedPlayers)) acceptedRoster.append(acc.toLower());
+        const FuzzyNameIndex &knownNames = list.fuzzyIndex();
+        model->beginBatch();
+        for (const QString &cand : roster.candidates)
         {
             const QString lower = cand.toLower();
+            const QString key = PlayerList::foldKey(cand);
             // Prüfe ob Spieler zugesagt hat
-            bool isAccepted = false;
-            for (const QString &acc : acceptedPlayers) {
-                if (levenshtein(acc.toLower(), lower) <= 1) {
-                    isAccepted = true;
-                    break;
-                }
-            }
+            const bool isAccepted = acceptedRoster.firstWithin(lower, 1) >= 0;
             // Exakte Übereinstimmung prüfen
-            if (existingByLower.contains(lower)) {
-                if (isAccepted) recognized.insert(existingByLower.value(lower));
+            if (knownNames.contains(key)) {
+                if (isAccepted) recognized.insert(knownNames.value(key));
                 continue;
             }
-            // Fuzzy-Matching gegen alle vorhandenen Namen
-            bool fuzzyMatch = false;
-            for (auto it = existingByLower.cbegin(); it != existingByLower.cend(); ++it)
+            // Fuzzy-Matching gegen alle vorhandenen Namen (nächster Treffer)
+            FuzzyNameIndex::Match match;
+            if (knownNames.nearest(key, fuzzyThreshold, &match))
             {
-                if (levenshtein(lower, it.key()) <= fuzzyThreshold)
-                {
-                    fuzzyMatch = true;
-                    if (isAccepted) recognized.insert(it.value());
-                    break;
-                }
-            }
-            if (fuzzyMatch)
+                if (isAccepted) recognized.insert(match.value);
                 continue;
+            }
             Player np; np.name = cand; np.group = unassignedGroup; np.joinDate = nowDate();
             if (!MainWindow::rankOptions().isEmpty()) np.rank = MainWindow::rankOptions().first();
             np.totalAttendance = qMax(np.totalAttendance, np.attendance);
             np.totalEvents = qMax(np.totalEvents, np.events);
             np.totalReserve = qMax(np.totalReserve, np.reserve);
-            list.players.push_back(np);
             if (ensureGroupRegistered(unassignedGroup)) saveGroups();
-            addPlayerToModel(np); validateRow(model->rowCount()-1);
-            existingByLower.insert(lower, np.name);
+            createdRows << addPlayerToModel(np);
             created.insert(np.name);
             if (isAccepted) recognized.insert(np.name);
         }
+        model->endBatch();
+        for (int row : std::as_const(createdRows)) validateRow(row);
         if (!created.isEmpty()) savePlayers();
         
         // Fülle sessionPlayerStatus basierend auf OCR-Ergebnissen
         sessionPlayerStatus.clear();
 
-        // Hilfsfunktion: Zeile in mehrere Spieler auftrennen, wenn mehrere Ränge vorkommen
-        auto splitByMultipleRanksLine = [this](const QString &line) -> QStringList {
-            const QStringList ranks = MainWindow::rankOptions();
-            QString text = line.trimmed();
-            QList<int> pos;
-            for (const QString &r : ranks) {
-                if (r.isEmpty()) continue;
-                QRegularExpression rx(QRegularExpression::escape(r), QRegularExpression::CaseInsensitiveOption);
-                auto it = rx.globalMatch(text);
-                while (it.hasNext()) {
-                    auto m = it.next();
-                    pos << m.capturedStart();
-                }
-            }
-            if (pos.size() <= 1)
-                return {text};
-            std::sort(pos.begin(), pos.end());
-            QStringList out;
-            for (int i = 0; i < pos.size(); ++i) {
-                int start = pos[i];
-                int end = (i+1<pos.size()) ? pos[i+1] : text.size();
-                QString seg = text.mid(start, end-start).trimmed();
-                if (!seg.isEmpty()) out << seg;
-            }
-            return out;
-        };
-
         // Zugesagte Spieler (accepted)
         for (const QString &raw : acceptedPlayers)
         {
-            for (const QString &playerName : splitByMultipleRanksLine(raw))
+            for (const QString &playerName : rosterParser->splitAtRanks(raw))
                 sessionPlayerStatus.insert(playerName, ResponseStatus::Confirmed);
         }
 
         // Abgelehnte Spieler (rejected)
         for (const QString &raw : rejectedPlayers)
         {
-            for (const QString &playerName : splitByMultipleRanksLine(raw))
+            for (const QString &playerName : rosterParser->splitAtRanks(raw))
                 sessionPlayerStatus.insert(playerName, ResponseStatus::Declined);
         }
         
@@ -1488,8 +1391,22 @@ void MainWindow::initializeUI()
 
     // wire search and filter to proxy
     auto *sp = static_cast<SortProxy *>(proxy);
-    connect(searchEdit, &QLineEdit::textChanged, this, [sp](const QString &txt)
-            { sp->setTextFilter(txt); });
+    // Beim Tippen erst nach einer kurzen Pause filtern; Leeren und Enter sofort
+    searchDebounce = new QTimer(this);
+    searchDebounce->setSingleShot(true);
+    searchDebounce->setInterval(SearchDebounceMsecs);
+    connect(searchDebounce, &QTimer::timeout, this, [sp, this]()
+            { sp->setTextFilter(searchEdit->text()); });
+    connect(searchEdit, &QLineEdit::textChanged, this, [sp, this](const QString &txt)
+            {
+        if (!incrementalSearch || txt.isEmpty())
+        {
+            searchDebounce->stop();
+            sp->setTextFilter(txt);
+            return;
+        }
+        searchDebounce->start(); });
+    connect(searchEdit, &QLineEdit::returnPressed, this, &MainWindow::flushPendingSearch);
     connect(rankFilterCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [sp, this](int idx)
             {
         if (idx == 0) { sp->setRankFilter(""); return; }
@@ -1533,6 +1450,8 @@ void MainWindow::initializeUI()
 void MainWindow::loadDataFiles()
 {
     qDebug() << "loadDataFiles: Loading settings and data...";
+    QElapsedTimer startupTimer;
+    startupTimer.start();
     
     // Load settings with error handling
     try {
@@ -1540,6 +1459,14 @@ void MainWindow::loadDataFiles()
     } catch (...) {
         qWarning() << "Failed to load settings, using defaults";
     }
+
+    // Passt der Binär-Snapshot zu den JSON-Dateien, lesen die Loader daraus
+    DataSnapshot::Contents snapshotContents;
+    startupFromSnapshot = useBinarySnapshot && dataSnapshot.read(snapshotContents);
+    if (startupFromSnapshot)
+        startupSnapshot = &snapshotContents;
+    else if (useBinarySnapshot && !dataSnapshot.errorString().isEmpty())
+        qDebug() << "loadDataFiles: Snapshot nicht verwendet:" << dataSnapshot.errorString();
     
     try {
         loadRankRequirements();
@@ -1588,6 +1515,7 @@ void MainWindow::loadDataFiles()
     } catch (...) {
         qWarning() << "Failed to load players";
     }
+    startupSnapshot = nullptr;
     
     // Only call these if widgets are initialized
     if (model && table) {
@@ -1634,18 +1562,14 @@ void MainWindow::loadDataFiles()
         qWarning() << "Failed to apply settings to UI";
     }
     
-    qDebug() << "loadDataFiles: All data files processed";
+    startupLoadTime = startupTimer.elapsed();
+    qInfo() << "loadDataFiles: Daten geladen aus" << (startupFromSnapshot ? "Binär-Snapshot" : "JSON")
+            << "in" << startupLoadTime << "ms";
 }
 
 int MainWindow::monthsSinceJoin(const QDate &joinDate)
 {
-    if (!joinDate.isValid())
-        return -1;
-    QDate now = nowDate();
-    int months = (now.year() - joinDate.year()) * 12 + (now.month() - joinDate.month());
-    if (now.day() < joinDate.day())
-        months -= 1;
-    return qMax(0, months);
+    return EligibilityEngine::monthsBetween(joinDate, nowDate());
 }
 
 int MainWindow::monthsRequiredForRank(const QString &rank)
@@ -1655,81 +1579,18 @@ int MainWindow::monthsRequiredForRank(const QString &rank)
 
 bool MainWindow::validateRow(int row, QString *outReason)
 {
-    if (row < 0 || row >= model->rowCount())
-        return true;
-    QStandardItem *joinItem = model->item(row, 7);
-    QStandardItem *rankItem = model->item(row, 8);
-    if (!joinItem || !rankItem)
+    if (!model || row < 0 || row >= model->rowCount() || row >= static_cast<int>(list.players.size()))
         return true;
-    QString joinStr = joinItem->text();
-    QString rank = rankItem->data(Qt::EditRole).toString();
-    if (rank.isEmpty())
-        rank = rankItem->text();
-    QDate joinDate = QDate::fromString(joinStr, Qt::ISODate);
-    RankRequirement req = requirementForRank(rank);
-
-    // reset background first
-    for (int c = 0; c < model->columnCount(); ++c)
-        if (QStandardItem *it = model->item(row, c))
-            it->setBackground(Qt::NoBrush);
-
-    QStringList reasons;
-    // Entferne auffällige Hintergrundfarbe für Warnungen
-    QColor warnColor; // ungenutzt
-    bool ok = true;
-
-    if (req.minMonths > 0)
-    {
-        if (!joinDate.isValid())
-        {
-            reasons << QString("kein Beitrittsdatum (benötigt: %1 Monate)").arg(req.minMonths);
-            ok = false;
-        }
-        else
-        {
-            int months = monthsSinceJoin(joinDate);
-            if (months < req.minMonths)
-            {
-                reasons << QString("nur %1 Monate im Dienst (benötigt: %2)").arg(months).arg(req.minMonths);
-                ok = false;
-            }
-        }
-    }
-
-    Player player = playerFromModelRow(row);
-    int playerLevel = player.level;
-    if (playerLevel <= 0)
-    {
-        if (QStandardItem *levelItem = model->item(row, 3))
-            playerLevel = levelItem->text().toInt();
-    }
-    if (req.minLevel > 0 && playerLevel < req.minLevel)
-    {
-        reasons << QString("Level %1/%2").arg(playerLevel).arg(req.minLevel);
-        ok = false;
-    }
-
-    QString key = playerKeyForRow(row);
-    if (!key.isEmpty() && req.minCombined > 0)
-    {
-        AttendanceSummary stats = attendanceSummaryForPlayer(key, nowDate());
-        int combined = stats.trainings + stats.events + stats.reserve;
-        if (combined < req.minCombined)
-        {
-            reasons << QString("T+E+R: %1/%2").arg(combined).arg(req.minCombined);
-            ok = false;
-        }
-    }
-
-    // Bei Nichterfüllung der Anforderungen wird kein Hintergrund mehr gesetzt
-    // (Anzeige bleibt neutral; Details stehen im Tooltip/Status)
-
-    bool hasRequirement = (req.minMonths > 0 || req.minCombined > 0 || req.minLevel > 0);
-    updatePromotionIndicatorForRow(row, ok && hasRequirement);
+    const Player &player = list.players[static_cast<size_t>(row)];
+    // Gecachtes Ergebnis, solange Rang/Level/Beitritt/Zähler/Stichtag/Anforderungen gleich sind
+    bool changed = false;
+    const EligibilityResult &result = eligibility.evaluate(player, requirementForRank(player.rank), nowDate(), &changed);
+    if (changed || model->isEligible(row) != result.eligible)
+        updatePromotionIndicatorForRow(row, result.eligible);
 
     if (outReason)
-        *outReason = reasons.join(", ");
-    return ok;
+        *outReason = result.reasons.join(", ");
+    return result.ok;
 }
 
 void MainWindow::validateAllRows()
@@ -1750,10 +1611,7 @@ void MainWindow::refreshModelFromList()
 {
     if (!model)
         return;
-    model->removeRows(0, model->rowCount());
-    for (const auto &p : list.players)
-        addPlayerToModel(p);
-    updateGroupDecorations();
+    model->resetFromList();
     refreshSessionPlayerTable();
 }
 
@@ -1804,55 +1662,75 @@ bool MainWindow::ensureGroupRegistered(const QString &groupName, const QString &
     return true;
 }
 
-void MainWindow::addPlayerToModel(const Player &p)
+int MainWindow::addPlayerToModel(const Player &p)
 {
     if (!model)
-        return;
-    QList<QStandardItem *> row;
-    row << new QStandardItem(p.name)
-        << new QStandardItem()
-        << new QStandardItem(p.t17name)
-        << new QStandardItem(QString::number(p.level))
-        << new QStandardItem(p.group)
-        << new QStandardItem(formatTrainingDisplay(p))
-        << new QStandardItem(p.comment)
-        << new QStandardItem(p.joinDate.toString(Qt::ISODate))
-        << new QStandardItem()
-        << new QStandardItem();
-    const QString key = p.name;
-    for (QStandardItem *item : row)
-    {
-        if (item)
-            item->setData(key, Qt::UserRole + 1);
-    }
-    if (QStandardItem *statusItem = row.value(1))
-    {
-        statusItem->setEditable(false);
-        statusItem->setTextAlignment(Qt::AlignCenter);
-        // Rotes X wenn noResponseCounter >= threshold
-        if (p.noResponseCounter >= noResponseThreshold)
-        {
-            statusItem->setText("❌");
-            statusItem->setForeground(QBrush(Qt::red));
-        }
-    }
-    if (QStandardItem *trainingItem = row.value(5))
-        trainingItem->setToolTip(trainingTooltip(p));
-    if (QStandardItem *rankItem = row.value(8))
+        return -1;
+    // Gruppenfarbe kommt beim Zeichnen aus groupDecorationCache, kein Neufärben aller Zeilen
+    return model->appendPlayer(p);
+}
+
+quint64 MainWindow::startOcrJob(QWidget *parent, const QStringList &imagePaths)
+{
+    quint64 job = 0;
+    if (imagePaths.size() == 1)
     {
-        rankItem->setEditable(true);
-        rankItem->setData(p.rank, Qt::EditRole);
-        rankItem->setData(formatRankDisplay(p, false), Qt::DisplayRole);
+        job = ocrService->recognize(imagePaths.first());
     }
-    if (QStandardItem *actionItem = row.last())
-        actionItem->setEditable(false);
-    model->appendRow(row);
-    updateGroupDecorations();
+    else
+    {
+        // Seiten in natürlicher Reihenfolge (Bild 2 vor Bild 10), damit
+        // Abschnitte über Seitengrenzen richtig weiterlaufen
+        QStringList pages = imagePaths;
+        QCollator collator;
+        collator.setNumericMode(true);
+        std::sort(pages.begin(), pages.end(), collator);
+        job = ocrService->recognizeBatch(pages);
+    }
+    auto *progress = new QProgressDialog(QStringLiteral("Texterkennung läuft..."), QStringLiteral("Abbrechen"), 0, 100, parent);
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(300);
+    progress->setAutoReset(false);
+    progress->setAttribute(Qt::WA_DeleteOnClose);
+    connect(progress, &QProgressDialog::canceled, ocrService, [this, job]()
+            { ocrService->cancel(job); });
+    connect(ocrService, &OcrService::progress, progress, [progress, job](quint64 id, int percent)
+            {
+        if (id == job)
+            progress->setValue(percent); });
+    connect(ocrService, &OcrService::finished, progress, [progress, job](const OcrResult &result)
+            {
+        if (result.job == job)
+            progress->close(); });
+    return job;
 }
 
-QString MainWindow::formatTrainingDisplay(const Player &p) const
+bool MainWindow::reportOcrError(QWidget *parent, const OcrResult &result)
 {
-    // Einsätze = Training + Event + Reserve
+    switch (result.error)
+    {
+    case OcrResult::NoError:
+        // Stapel mit einzelnen unlesbaren Seiten: Rest auswerten, Fehler notieren
+        if (!result.errorString.isEmpty())
+            appendErrorLog(QStringLiteral("ocr"), result.errorString);
+        return false;
+    case OcrResult::Canceled:
+        return true;
+    case OcrResult::EngineMissing:
+        QMessageBox::warning(parent, QStringLiteral("Tesseract fehlt"), result.errorString);
+        break;
+    default:
+        QMessageBox::warning(parent, QStringLiteral("OCR-Fehler"),
+                             QStringLiteral("Die Texterkennung ist fehlgeschlagen.\n%1").arg(result.errorString));
+        break;
+    }
+    appendErrorLog(QStringLiteral("ocr"), QStringLiteral("%1: %2").arg(result.imagePath, result.errorString));
+    return true;
+}
+
+QString MainWindow::formatTrainingDisplay(const Player &p) const
+{
+    // Einsätze = Training + Event + Reserve
     int currentCombined = p.attendance + p.events + p.reserve;
     int totalCombined = qMax(p.attendance, p.totalAttendance) + qMax(p.events, p.totalEvents) + qMax(p.reserve, p.totalReserve);
     if (showCounterInTable)
@@ -1880,7 +1758,7 @@ QString MainWindow::trainingTooltip(const Player &p) const
 QString MainWindow::formatRankDisplay(const Player &p, bool eligible) const
 {
     QStringList parts;
-    QString rank = p.rank.isEmpty() ? QStringLiteral("-") : p.rank;
+    QString rank = p.rank.isEmpty() ? QStringLiteral("-") : p.rank.toString();
     parts << rank;
     if (p.level > 0)
         parts << QStringLiteral("Level %1").arg(p.level);
@@ -1892,40 +1770,23 @@ QString MainWindow::formatRankDisplay(const Player &p, bool eligible) const
 
 Player MainWindow::playerFromModelRow(int row) const
 {
-    Player p;
-    if (!model)
-        return p;
-    if (row < 0 || row >= model->rowCount())
-        return p;
-    QString key = playerKeyForRow(row);
-    for (const Player &candidate : list.players)
-    {
-        if (candidate.name == key)
-            return candidate;
-    }
-    return p;
+    if (!model || row < 0 || row >= model->rowCount() || row >= static_cast<int>(list.players.size()))
+        return Player();
+    return list.players[static_cast<size_t>(row)];
 }
 
 Player *MainWindow::findPlayerByKey(const QString &playerKey)
 {
-    for (Player &player : list.players)
-    {
-        if (player.name == playerKey)
-            return &player;
-    }
-    return nullptr;
+    return list.findByName(playerKey);
 }
 
 int MainWindow::rowForPlayerKey(const QString &playerKey) const
 {
     if (!model)
         return -1;
-    for (int row = 0; row < model->rowCount(); ++row)
-    {
-        if (playerKeyForRow(row) == playerKey)
-            return row;
-    }
-    return -1;
+    // Modellzeile == Index in der PlayerList
+    const int row = list.indexOfName(playerKey);
+    return row < model->rowCount() ? row : -1;
 }
 
 bool MainWindow::playerContextForRow(int sourceRow, QString &playerKey, QString &playerName) const
@@ -1935,8 +1796,7 @@ bool MainWindow::playerContextForRow(int sourceRow, QString &playerKey, QString
     playerKey = playerKeyForRow(sourceRow);
     if (playerKey.isEmpty())
         return false;
-    if (QStandardItem *nameItem = model->item(sourceRow, 0))
-        playerName = nameItem->text();
+    playerName = model->index(sourceRow, PlayerTableModel::NameColumn).data().toString();
     if (playerName.isEmpty())
         playerName = playerKey;
     return true;
@@ -2012,19 +1872,7 @@ void MainWindow::incrementPlayerCounters(const QString &playerKey, const QString
 
     int row = rowForPlayerKey(playerKey);
     if (row >= 0)
-    {
-        if (QStandardItem *trainingItem = model->item(row, 5))
-        {
-            trainingItem->setText(formatTrainingDisplay(*player));
-            trainingItem->setToolTip(trainingTooltip(*player));
-        }
-        // Update Hinweis-Spalte (rotes X entfernen)
-        if (QStandardItem *statusItem = model->item(row, 1))
-        {
-            statusItem->setText(QString());
-            statusItem->setForeground(QBrush(Qt::NoBrush));
-        }
-    }
+        model->playerChanged(row, PlayerTableModel::StatusColumn, PlayerTableModel::TrainingColumn);
     savePlayers();
 }
 
@@ -2032,56 +1880,16 @@ void MainWindow::updatePromotionIndicatorForRow(int row, bool eligible)
 {
     if (!model || row < 0 || row >= model->rowCount())
         return;
-
-    Player player = playerFromModelRow(row);
-
-    if (QStandardItem *statusItem = model->item(row, 1))
-    {
-        // Priorität: Rotes X bei noResponseCounter >= threshold
-        if (player.noResponseCounter >= noResponseThreshold)
-        {
-            statusItem->setText("❌");
-            statusItem->setForeground(QBrush(Qt::red));
-            statusItem->setToolTip(QStringLiteral("Keine Rückmeldungen: %1 Mal").arg(player.noResponseCounter));
-        }
-        else if (eligible)
-        {
-            statusItem->setText(QStringLiteral("★"));
-            statusItem->setForeground(QBrush(QColor(255, 215, 0)));
-            statusItem->setToolTip("Beförderungsvoraussetzungen erfüllt");
-        }
-        else
-        {
-            statusItem->setText(QString());
-            statusItem->setForeground(QBrush(Qt::NoBrush));
-            statusItem->setToolTip(QString());
-        }
-    }
-    if (!player.name.isEmpty())
-    {
-        if (QStandardItem *rankItem = model->item(row, 8))
-        {
-            rankItem->setData(player.rank, Qt::EditRole);
-            rankItem->setData(formatRankDisplay(player, eligible), Qt::DisplayRole);
-        }
-    }
+    // Status- und Rangspalte werden im Modell aus Player + Flag berechnet
+    // setEligible meldet nur tatsächlich geänderte Zellen (Status, Dienstrang)
+    model->setEligible(row, eligible);
 }
 
 QString MainWindow::playerKeyForRow(int row) const
 {
-    if (!model || row < 0 || row >= model->rowCount())
+    if (!model || row < 0 || row >= model->rowCount() || row >= static_cast<int>(list.players.size()))
         return {};
-    for (int c = 0; c < model->columnCount(); ++c)
-    {
-        if (QStandardItem *item = model->item(row, c))
-        {
-            QString key = item->data(Qt::UserRole + 1).toString();
-            if (!key.isEmpty())
-                return key;
-        }
-    }
-    QStandardItem *fallback = model->item(row, 0);
-    return fallback ? fallback->text() : QString();
+    return list.players[static_cast<size_t>(row)].name;
 }
 
 MainWindow::AttendanceSummary MainWindow::attendanceSummaryForPlayer(const QString &playerKey, const QDate &referenceDate) const
@@ -2089,16 +1897,12 @@ MainWindow::AttendanceSummary MainWindow::attendanceSummaryForPlayer(const QStri
     AttendanceSummary summary;
     if (playerKey.isEmpty())
         return summary;
-    for (const Player &player : list.players)
+    Q_UNUSED(referenceDate);
+    if (const Player *player = list.findByName(playerKey))
     {
-        if (player.name == playerKey)
-        {
-            Q_UNUSED(referenceDate);
-            summary.trainings = player.attendance;
-            summary.events = player.events;
-            summary.reserve = player.reserve;
-            return summary;
-        }
+        summary.trainings = player->attendance;
+        summary.events = player->events;
+        summary.reserve = player->reserve;
     }
     return summary;
 }
@@ -2182,13 +1986,13 @@ bool MainWindow::openPlayerEditDialog(Player &player, bool editing)
     QComboBox *groupCombo = new QComboBox(&dlg);
     groupCombo->setEditable(true);
     groupCombo->addItems(groups);
-    groupCombo->setCurrentText(player.group);
+    groupCombo->setCurrentText(player.group.toString());
     form->addRow("Gruppe", groupCombo);
 
     QComboBox *rankCombo = new QComboBox(&dlg);
     const QStringList rankChoices = MainWindow::rankOptions();
     rankCombo->addItems(rankChoices);
-    int rankIndex = rankCombo->findText(player.rank);
+    int rankIndex = rankCombo->findText(player.rank.toString());
     if (rankIndex < 0)
         rankIndex = 0;
     rankCombo->setCurrentIndex(rankIndex);
@@ -2303,6 +2107,7 @@ bool MainWindow::openPlayerEditDialog(Player &player, bool editing)
 void MainWindow::loadRankRequirements()
 {
     rankRequirements.clear();
+    eligibility.bumpRequirementsVersion();
     auto ensureDefaults = [this]()
     {
         if (!rankRequirements.isEmpty())
@@ -2368,6 +2173,7 @@ void MainWindow::loadRankRequirements()
 }
 void MainWindow::saveRankRequirements()
 {
+    eligibility.bumpRequirementsVersion();
     QString dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
     if (dir.isEmpty())
         dir = QDir::homePath();
@@ -2431,6 +2237,26 @@ void MainWindow::showSettingsDialog()
     fuzzyThresholdSpin->setToolTip("Maximale Levenshtein-Distanz für Namensübereinstimmung");
     generalForm->addRow(fuzzyThresholdLabel, fuzzyThresholdSpin);
 
+    QCheckBox *csvFuzzyMergeCheck = new QCheckBox("CSV-Import: ähnliche Namen zusammenführen", generalTab);
+    csvFuzzyMergeCheck->setChecked(csvFuzzyMerge);
+    csvFuzzyMergeCheck->setToolTip("Zeilen ohne exakten Treffer werden dem einzigen Spieler innerhalb der Fuzzy-Toleranz zugeordnet");
+    generalForm->addRow(csvFuzzyMergeCheck);
+
+    QCheckBox *ocrPreprocessCheck = new QCheckBox("OCR: Screenshot vorbereiten (zuschneiden, schwarz-weiß)", generalTab);
+    ocrPreprocessCheck->setChecked(ocrPreprocess);
+    ocrPreprocessCheck->setToolTip("Schneidet das Bild auf die Liste zu, vergrößert kleine Schrift und binarisiert es vor der Texterkennung");
+    generalForm->addRow(ocrPreprocessCheck);
+
+    QCheckBox *binarySnapshotCheck = new QCheckBox("Schnellstart über Binär-Snapshot", generalTab);
+    binarySnapshotCheck->setChecked(useBinarySnapshot);
+    binarySnapshotCheck->setToolTip("Speichert beim Beenden einen Binär-Snapshot der Daten; die JSON-Dateien bleiben maßgeblich");
+    generalForm->addRow(binarySnapshotCheck);
+
+    QCheckBox *incrementalSearchCheck = new QCheckBox("Suche beim Tippen verzögern und verfeinern", generalTab);
+    incrementalSearchCheck->setChecked(incrementalSearch);
+    incrementalSearchCheck->setToolTip("Filtert erst nach einer kurzen Tipp-Pause und prüft beim Weitertippen nur die bisherigen Treffer");
+    generalForm->addRow(incrementalSearchCheck);
+
     tabs->addTab(generalTab, "Allgemein");
 
     // Tab 2: Gruppenreihenfolge
@@ -2451,7 +2277,7 @@ void MainWindow::showSettingsDialog()
         QSet<QString> currentGroups;
         for (const Player &p : list.players) {
             if (!p.group.isEmpty())
-                currentGroups.insert(p.group);
+                currentGroups.insert(p.group.toString());
         }
         QStringList sorted = currentGroups.values();
         std::sort(sorted.begin(), sorted.end());
@@ -2532,20 +2358,20 @@ void MainWindow::showSettingsDialog()
         if (res != QMessageBox::Yes)
             return;
         // Listen und Strukturen leeren
-        list.players.clear();
+        list.clear();
+        eligibility.clear();
         attendanceRecords.clear();
-        soldbuchRecords.clear();
+        soldbuchLog.clear();
         groups.clear();
         groupCategory.clear();
         groupColors.clear();
         sessionSelectedPlayers.clear();
         // Model leeren
         if (model)
-            model->removeRows(0, model->rowCount());
+            model->resetFromList();
         // Persistenz
         savePlayers();
         saveAttendance();
-        saveSoldbuch();
         saveGroups();
         saveGroupColors();
         // UI aktualisieren
@@ -2589,7 +2415,7 @@ void MainWindow::showSettingsDialog()
     {
         if (player.rank.isEmpty())
             continue;
-        rankCounts[player.rank] += 1;
+        rankCounts[player.rank.toString()] += 1;
     }
 
     QMap<QString, RankWidgets> rankWidgets;
@@ -2717,12 +2543,16 @@ void MainWindow::showSettingsDialog()
         autoCreatePlayers = autoCreatePlayersCheck->isChecked();
         fuzzyMatchingEnabled = fuzzyMatchingCheck->isChecked();
         fuzzyMatchThreshold = fuzzyThresholdSpin->value();
+        csvFuzzyMerge = csvFuzzyMergeCheck->isChecked();
+        ocrPreprocess = ocrPreprocessCheck->isChecked();
         ocrLanguage = ocrLangEdit->text().trimmed();
         unassignedGroupName = unassignedGroupEdit->text().trimmed();
         autoFillMetadata = autoFillMetadataCheck->isChecked();
         incrementCounterOnNoResponse = incrementOnNoResponseCheck->isChecked();
         resetCounterOnResponse = resetOnResponseCheck->isChecked();
         showCounterInTable = showCounterInTableCheck->isChecked();
+        useBinarySnapshot = binarySnapshotCheck->isChecked();
+        incrementalSearch = incrementalSearchCheck->isChecked();
 
         // Speichere Spaltennamen 'Hinweis'
         hintColumnName = hinweisEdit->text().trimmed().isEmpty() ? QStringLiteral("Hinweis") : hinweisEdit->text().trimmed();
@@ -2785,7 +2615,7 @@ void MainWindow::editRankRequirements()
     {
         if (player.rank.isEmpty())
             continue;
-        rankCounts[player.rank] += 1;
+        rankCounts[player.rank.toString()] += 1;
     }
 
     QMap<QString, RankWidgets> widgets;
@@ -2917,24 +2747,18 @@ void MainWindow::addPlayer()
         return;
 
     // Prüfe ob Spieler mit diesem Namen bereits existiert
-    QString normalizedName = newPlayer.name.trimmed();
-    for (const Player &existing : list.players)
+    if (const Player *existing = list.findByNameInsensitive(newPlayer.name))
     {
-        if (existing.name.trimmed().compare(normalizedName, Qt::CaseInsensitive) == 0)
-        {
-            QMessageBox::warning(this, "Spieler existiert bereits",
-                                 QStringLiteral("Ein Spieler mit dem Namen '%1' ist bereits vorhanden.\n"
-                                                "Bitte verwenden Sie einen anderen Namen oder bearbeiten Sie den existierenden Spieler.")
-                                     .arg(existing.name));
-            return;
-        }
+        QMessageBox::warning(this, "Spieler existiert bereits",
+                             QStringLiteral("Ein Spieler mit dem Namen '%1' ist bereits vorhanden.\n"
+                                            "Bitte verwenden Sie einen anderen Namen oder bearbeiten Sie den existierenden Spieler.")
+                                 .arg(existing->name));
+        return;
     }
 
     newPlayer.totalAttendance = qMax(newPlayer.totalAttendance, newPlayer.attendance);
     newPlayer.totalEvents = qMax(newPlayer.totalEvents, newPlayer.events);
     newPlayer.totalReserve = qMax(newPlayer.totalReserve, newPlayer.reserve);
-    list.players.push_back(newPlayer);
-
     if (ensureGroupRegistered(newPlayer.group))
         saveGroups();
 
@@ -3180,6 +3004,7 @@ void MainWindow::editGroups()
     groups = newGroups;
     groupCategory = newCategories;
     groupColors = newColors;
+    invalidateGroupDecorationCache();
 
     bool playersChanged = false;
     for (Player &p : list.players)
@@ -3189,7 +3014,7 @@ void MainWindow::editGroups()
         bool applied = false;
         for (auto it = renameMap.constBegin(); it != renameMap.constEnd(); ++it)
         {
-            if (p.group.compare(it.key(), Qt::CaseInsensitive) == 0)
+            if (p.group.toString().compare(it.key(), Qt::CaseInsensitive) == 0)
             {
                 p.group = it.value();
                 applied = true;
@@ -3201,7 +3026,7 @@ void MainWindow::editGroups()
             continue;
         for (const QString &removed : removedGroups)
         {
-            if (p.group.compare(removed, Qt::CaseInsensitive) == 0)
+            if (p.group.toString().compare(removed, Qt::CaseInsensitive) == 0)
             {
                 p.group.clear();
                 playersChanged = true;
@@ -3310,20 +3135,14 @@ void MainWindow::editPlayer()
     // Prüfe ob Spieler gelöscht werden soll
     if (edited.name == "__DELETE__")
     {
-        // Entferne aus der Spielerliste
-        list.players.erase(
-            std::remove_if(list.players.begin(), list.players.end(),
-                           [&originalKey](const Player &p)
-                           { return p.name == originalKey; }),
-            list.players.end());
+        // Entferne aus Spielerliste und Tabelle
+        model->removePlayerAt(sourceRow);
+        eligibility.remove(originalKey);
 
         // Entferne Teilnahme-Historie
         if (attendanceRecords.contains(originalKey))
             attendanceRecords.remove(originalKey);
 
-        // Entferne Zeile aus der Tabelle
-        model->removeRow(sourceRow);
-
         savePlayers();
         saveAttendance();
 
@@ -3332,45 +3151,12 @@ void MainWindow::editPlayer()
         return;
     }
 
-    auto setItemText = [this, sourceRow](int column, const QString &text)
-    {
-        if (QStandardItem *item = model->item(sourceRow, column))
-            item->setText(text);
-    };
-
-    setItemText(0, edited.name);
-    setItemText(2, edited.t17name);
-    setItemText(3, QString::number(edited.level));
-    setItemText(4, edited.group);
-    setItemText(5, formatTrainingDisplay(edited));
-    if (QStandardItem *trainingItem = model->item(sourceRow, 5))
-        trainingItem->setToolTip(trainingTooltip(edited));
-    setItemText(6, edited.comment);
-    setItemText(7, edited.joinDate.toString(Qt::ISODate));
-    setItemText(8, edited.rank);
-
-    const QString newKey = edited.name;
-    for (int c = 0; c < model->columnCount(); ++c)
-    {
-        if (QStandardItem *item = model->item(sourceRow, c))
-            item->setData(newKey, Qt::UserRole + 1);
-    }
-
     if (ensureGroupRegistered(edited.group))
         saveGroups();
 
-    bool replaced = false;
-    for (Player &p : list.players)
-    {
-        if (p.name == originalKey)
-        {
-            p = edited;
-            replaced = true;
-            break;
-        }
-    }
-    if (!replaced)
-        list.addOrMerge(edited);
+    // Modellzeile == Listenindex; replace() pflegt auch die Namensindizes
+    list.replace(sourceRow, edited);
+    model->playerChanged(sourceRow);
 
     validateRow(sourceRow);
     savePlayers();
@@ -3394,9 +3180,8 @@ void MainWindow::showPlayerAttendance()
         playerKey = playerKeyForRow(sourceRow);
         if (playerKey.isEmpty())
             return false;
-        if (QStandardItem *nameItem = model->item(sourceRow, 0))
-            playerName = nameItem->text();
-        else
+        playerName = model->index(sourceRow, PlayerTableModel::NameColumn).data().toString();
+        if (playerName.isEmpty())
             playerName = playerKey;
         return true;
     };
@@ -3407,7 +3192,7 @@ void MainWindow::showPlayerAttendance()
     if (!resolveSelection(sourceRow, playerKey, playerName))
         return;
 
-    const QList<QJsonObject> entries = attendanceRecords.value(playerKey);
+    const AttendanceHistory::Entries entries = attendanceRecords.value(playerKey);
 
     QDialog dlg(this);
     dlg.setWindowTitle(QStringLiteral("Teilnahmen - %1").arg(playerName));
@@ -3423,10 +3208,10 @@ void MainWindow::showPlayerAttendance()
         tree->setHeaderLabels({"Datum", "Typ", "Name", "Karte"});
         for (auto it = entries.crbegin(); it != entries.crend(); ++it)
         {
-            QString date = it->value("date").toString();
-            QString type = it->value("type").toString();
-            QString name = it->value("name").toString();
-            QString map = it->value("map").toString();
+            QString date = it->date().toString(Qt::ISODate);
+            const QString &type = it->type.toString();
+            const QString &name = it->name.toString();
+            const QString &map = it->map.toString();
             QTreeWidgetItem *item = new QTreeWidgetItem({date, type, name, map});
             tree->addTopLevelItem(item);
         }
@@ -3458,9 +3243,8 @@ void MainWindow::showPlayerSoldbuch()
         playerKey = playerKeyForRow(sourceRow);
         if (playerKey.isEmpty())
             return false;
-        if (QStandardItem *nameItem = model->item(sourceRow, 0))
-            playerName = nameItem->text();
-        else
+        playerName = model->index(sourceRow, PlayerTableModel::NameColumn).data().toString();
+        if (playerName.isEmpty())
             playerName = playerKey;
         return true;
     };
@@ -3476,7 +3260,8 @@ void MainWindow::showPlayerSoldbuch()
 
 void MainWindow::showSoldbuchDialogForPlayer(const QString &playerKey, const QString &playerName)
 {
-    const QList<QJsonObject> entries = soldbuchRecords.value(playerKey);
+    // Nur die Einträge dieses Spielers aus dem Log lesen
+    const QList<QJsonObject> entries = soldbuchLog.entriesFor(playerKey);
 
     QDialog dlg(this);
     dlg.setWindowTitle(QStringLiteral("Soldbuch - %1").arg(playerName));
@@ -3519,485 +3304,159 @@ void MainWindow::demotePlayer() {}
 
 void MainWindow::importCsv()
 {
+    if (isCsvImportRunning())
+        return;
     QString fileName = QFileDialog::getOpenFileName(this, QStringLiteral("CSV importieren"), QString(), QStringLiteral("CSV/TSV Dateien (*.csv *.tsv *.txt);;Alle Dateien (*.*)"));
     if (fileName.isEmpty())
         return;
 
-    QFile file(fileName);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
-    {
-        QMessageBox::warning(this, QStringLiteral("Import fehlgeschlagen"), QStringLiteral("Datei konnte nicht geöffnet werden:\n%1").arg(file.errorString()));
-        appendErrorLog("importCsv", QStringLiteral("Datei konnte nicht geöffnet werden: %1").arg(file.errorString()));
-        return;
-    }
-
-    QTextStream stream(&file);
-    stream.setEncoding(QStringConverter::Utf8);
-    QStringList rawLines;
-    while (!stream.atEnd())
-        rawLines << stream.readLine();
-    file.close();
-
-    auto detectDelimiter = [](const QStringList &lines) -> QChar
-    {
-        const QList<QChar> candidates = {QChar('\t'), QChar(';'), QChar(','), QChar('|')};
-        QMap<QChar, int> scores;
-        for (QChar cand : candidates)
-            scores.insert(cand, 0);
-        int inspected = 0;
-        for (const QString &line : lines)
-        {
-            const QString trimmed = line.trimmed();
-            if (trimmed.isEmpty())
-                continue;
-            for (QChar cand : candidates)
-                scores[cand] += trimmed.count(cand);
-            if (++inspected >= 12)
-                break;
-        }
-        QChar best = QChar(',');
-        int bestScore = -1;
-        for (QChar cand : candidates)
-        {
-            if (scores.value(cand) > bestScore)
-            {
-                bestScore = scores.value(cand);
-                best = cand;
-            }
-        }
-        if (bestScore <= 0)
-            return QChar(';');
-        return best;
-    };
-
-    const QChar delimiter = detectDelimiter(rawLines);
-
-    auto splitLine = [delimiter](const QString &line) -> QStringList
-    {
-        QString normalized = line;
-        normalized.remove('\r');
-        QStringList cols;
-        QString current;
-        bool inQuotes = false;
-        for (int i = 0; i < normalized.size(); ++i)
-        {
-            const QChar ch = normalized.at(i);
-            if (ch == '"')
-            {
-                if (inQuotes && i + 1 < normalized.size() && normalized.at(i + 1) == '"')
-                {
-                    current.append('"');
-                    ++i;
-                }
-                else
-                {
-                    inQuotes = !inQuotes;
-                }
-            }
-            else if (ch == delimiter && !inQuotes)
-            {
-                cols << current;
-                current.clear();
-            }
-            else
+    // Modal, damit der Import nicht doppelt gestartet wird
+    auto *progress = new QProgressDialog(QStringLiteral("CSV wird importiert …"), QStringLiteral("Abbrechen"), 0, 100, this);
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(300);
+    progress->setAutoReset(false);
+    connect(this, &MainWindow::csvImportProgress, progress, &QProgressDialog::setValue);
+    connect(progress, &QProgressDialog::canceled, this, &MainWindow::cancelCsvImport);
+    connect(this, &MainWindow::csvImportFinished, progress, [this, progress](bool)
             {
-                current.append(ch);
-            }
-        }
-        cols << current;
-        for (QString &value : cols)
-        {
-            value = value.trimmed();
-            if (value.startsWith('"') && value.endsWith('"') && value.size() >= 2)
-                value = value.mid(1, value.size() - 2).trimmed();
-            if (!value.isEmpty() && value.at(0) == QChar(0xFEFF))
-                value.remove(0, 1);
-        }
-        return cols;
-    };
-
-    QList<QStringList> rows;
-    rows.reserve(rawLines.size());
-    for (const QString &line : rawLines)
-    {
-        if (line.trimmed().isEmpty())
-            continue;
-        rows.append(splitLine(line));
-    }
+        progress->hide();
+        progress->deleteLater();
+        showCsvImportResult(csvImportResult); });
+    if (!importCsvFileAsync(fileName))
+        progress->deleteLater();
+}
 
-    if (rows.isEmpty())
+void MainWindow::showCsvImportResult(const CsvImportResult &result)
+{
+    switch (result.error)
     {
+    case CsvImportResult::NoError:
+        QMessageBox::information(this, QStringLiteral("Import abgeschlossen"), QStringLiteral("%1 Spieler verarbeitet (%2 neu, %3 aktualisiert). %4 Zeilen übersprungen.").arg(result.imported + result.merged).arg(result.imported).arg(result.merged).arg(result.skipped));
+        break;
+    case CsvImportResult::Canceled:
+        break;
+    case CsvImportResult::OpenFailed:
+        QMessageBox::warning(this, QStringLiteral("Import fehlgeschlagen"), result.errorString);
+        break;
+    case CsvImportResult::NoNameColumn:
+        QMessageBox::warning(this, QStringLiteral("Import"), QStringLiteral("Die Datei enthält keine erkennbaren Namensspalten."));
+        break;
+    default:
         QMessageBox::information(this, QStringLiteral("Import"), QStringLiteral("Die Datei enthielt keine verwertbaren Daten."));
-        appendErrorLog("importCsv", QStringLiteral("Datei leer oder keine verwertbaren Zeilen"));
-        return;
+        break;
     }
+}
 
-    auto normalizeToken = [](const QString &text) -> QString
-    {
-        QString lowered = text.normalized(QString::NormalizationForm_D).toLower();
-        QString result;
-        result.reserve(lowered.size());
-        bool lastWasSpace = true;
-        for (const QChar ch : lowered)
-        {
-            const QChar::Category category = ch.category();
-            if (category == QChar::Mark_NonSpacing || category == QChar::Mark_SpacingCombining || category == QChar::Mark_Enclosing)
-                continue;
-            if (ch.isLetterOrNumber())
-            {
-                result.append(ch);
-                lastWasSpace = false;
-            }
-            else
-            {
-                if (!lastWasSpace)
-                {
-                    result.append(' ');
-                    lastWasSpace = true;
-                }
-            }
-        }
-        return result.simplified();
-    };
-
-    auto looksLikeHeader = [&](const QStringList &cols) -> bool
+// Gemeinsamer Importpfad: Datei streamen und direkt in die Liste mergen
+bool MainWindow::runCsvImport(const QString &filePath, const QString &source, CsvImportResult &result)
+{
+    PlayerCsvImporter importer;
+    importer.setFuzzyMergeDistance(csvFuzzyMerge ? fuzzyMatchThreshold : 0);
+    if (!importer.importFile(filePath, list, result))
     {
-        for (const QString &value : cols)
-        {
-            QString norm = normalizeToken(value);
-            if (norm == "name" || norm == "spielername" || norm.contains(" name"))
-                return true;
-        }
+        appendErrorLog(source, result.errorString);
         return false;
-    };
-
-    int headerRow = -1;
-    for (int i = 0; i < rows.size(); ++i)
-    {
-        if (looksLikeHeader(rows.at(i)))
-        {
-            headerRow = i;
-            break;
-        }
-    }
-    if (headerRow < 0)
-        headerRow = 0;
-
-    const QStringList headers = rows.at(headerRow);
-    QVector<QString> normalizedHeaders;
-    normalizedHeaders.reserve(headers.size());
-    for (const QString &h : headers)
-        normalizedHeaders.append(normalizeToken(h));
-
-    auto findColumn = [&](const QStringList &candidates) -> int
-    {
-        for (const QString &candidate : candidates)
-        {
-            QString needle = normalizeToken(candidate);
-            if (needle.isEmpty())
-                continue;
-            for (int idx = 0; idx < normalizedHeaders.size(); ++idx)
-            {
-                if (normalizedHeaders.at(idx) == needle)
-                    return idx;
-            }
-        }
-        for (const QString &candidate : candidates)
-        {
-            QString needle = normalizeToken(candidate);
-            if (needle.isEmpty())
-                continue;
-            for (int idx = 0; idx < normalizedHeaders.size(); ++idx)
-            {
-                if (normalizedHeaders.at(idx).contains(needle))
-                    return idx;
-            }
-        }
-        return -1;
-    };
-
-    auto findColumnByParts = [&](const QStringList &parts) -> int
-    {
-        for (int idx = 0; idx < normalizedHeaders.size(); ++idx)
-        {
-            bool matches = true;
-            for (const QString &part : parts)
-            {
-                QString needle = normalizeToken(part);
-                if (needle.isEmpty())
-                    continue;
-                if (!normalizedHeaders.at(idx).contains(needle))
-                {
-                    matches = false;
-                    break;
-                }
-            }
-            if (matches)
-                return idx;
-        }
-        return -1;
-    };
-
-    const int nameIdx = findColumn(QStringList() << QStringLiteral("Name") << QStringLiteral("Spielername"));
-    if (nameIdx < 0)
-    {
-        QMessageBox::warning(this, QStringLiteral("Import"), QStringLiteral("Die Datei enthält keine erkennbaren Namensspalten."));
-        appendErrorLog("importCsv", QStringLiteral("Keine Namensspalte erkannt"));
-        return;
     }
-    const int t17Idx = findColumn(QStringList() << QStringLiteral("T17") << QStringLiteral("T17 Name") << QStringLiteral("T17-Name"));
-    const int joinIdx = findColumn(QStringList() << QStringLiteral("Datum Vollmitglied") << QStringLiteral("Eintrittsdatum") << QStringLiteral("Beitrittsdatum") << QStringLiteral("Eintritt") << QStringLiteral("Beitritt"));
-    const int rankIdx = findColumn(QStringList() << QStringLiteral("Dienstgrad") << QStringLiteral("Dienstgradstufe") << QStringLiteral("Dienstrang") << QStringLiteral("Rang"));
-    const int groupIdx = findColumn(QStringList() << QStringLiteral("Gruppe") << QStringLiteral("Trupp") << QStringLiteral("Squad"));
-    const int levelIdx = findColumn(QStringList() << QStringLiteral("Level") << QStringLiteral("Dienstgradstufe") << QStringLiteral("Stufe"));
-    const int commentIdx = findColumn(QStringList() << QStringLiteral("Kommentar") << QStringLiteral("Notiz"));
-    const int nextRankIdx = findColumn(QStringList() << QStringLiteral("Nächster Rang") << QStringLiteral("Naechster Rang") << QStringLiteral("Next Rank"));
-    const int lastPromotionIdx = findColumn(QStringList() << QStringLiteral("Datum letzte Beförderung") << QStringLiteral("Letzte Beförderung") << QStringLiteral("Last Promotion"));
-    int trainingsTotalIdx = findColumnByParts(QStringList() << QStringLiteral("Training") << QStringLiteral("Gesamt"));
-    const int trainingsRankIdxFallback = findColumnByParts(QStringList() << QStringLiteral("Training") << QStringLiteral("Rang"));
-    const int trainingsSinceIdx = findColumnByParts(QStringList() << QStringLiteral("Training") << QStringLiteral("seit"));
-    const int eventsIdx = findColumnByParts(QStringList() << QStringLiteral("Event"));
-    const int reserveIdx = findColumnByParts(QStringList() << QStringLiteral("Reserve"));
-    if (trainingsTotalIdx < 0)
-        trainingsTotalIdx = findColumn(QStringList() << QStringLiteral("Trainings") << QStringLiteral("Teilnahmen"));
-    const int trainingsRankIdx = trainingsSinceIdx >= 0 ? trainingsSinceIdx : (trainingsRankIdxFallback >= 0 ? trainingsRankIdxFallback : trainingsTotalIdx);
-
-    auto valueAt = [](const QStringList &cols, int idx) -> QString
-    {
-        if (idx < 0 || idx >= cols.size())
-            return QString();
-        return cols.at(idx).trimmed();
-    };
-
-    auto parseIntValue = [](const QString &text) -> int
-    {
-        QString cleaned;
-        cleaned.reserve(text.size());
-        for (const QChar ch : text)
-        {
-            if (ch.isDigit())
-                cleaned.append(ch);
-            else if (ch == '-' && cleaned.isEmpty())
-                cleaned.append(ch);
-        }
-        bool ok = false;
-        int val = cleaned.toInt(&ok);
-        return ok ? val : 0;
-    };
-
-    auto parseDateValue = [](QString text) -> QDate
-    {
-        text = text.trimmed();
-        if (text.isEmpty())
-            return QDate();
-        int spaceIdx = text.indexOf(' ');
-        if (spaceIdx > 0)
-            text = text.left(spaceIdx);
-        text.replace(',', '.');
-        static const QStringList formats = {QStringLiteral("yyyy-MM-dd"), QStringLiteral("dd.MM.yyyy"), QStringLiteral("dd.MM.yy"), QStringLiteral("dd/MM/yyyy"), QStringLiteral("dd/MM/yy"), QStringLiteral("dd-MM-yyyy"), QStringLiteral("dd-MM-yy"), QStringLiteral("yyyy.MM.dd"), QStringLiteral("yyyy/MM/dd"), QStringLiteral("MM/dd/yyyy"), QStringLiteral("MM/dd/yy")};
-        for (const QString &fmt : formats)
-        {
-            QDate parsed = QDate::fromString(text, fmt);
-            if (parsed.isValid())
-                return parsed;
-        }
-        bool ok = false;
-        int serial = text.toInt(&ok);
-        if (ok && serial > 0)
-        {
-            QDate base(1899, 12, 30);
-            return base.addDays(serial);
-        }
-        return QDate();
-    };
+    applyCsvImport(result);
+    return true;
+}
 
-    int imported = 0;
-    int merged = 0;
-    int skipped = 0;
+// Nach dem Merge einmal Gruppen, Modell, Prüfung und Speichern nachziehen
+void MainWindow::applyCsvImport(const CsvImportResult &result)
+{
     bool groupsChanged = false;
-    for (int row = headerRow + 1; row < rows.size(); ++row)
-    {
-        const QStringList &cols = rows.at(row);
-        const QString name = valueAt(cols, nameIdx);
-        if (name.trimmed().isEmpty())
-        {
-            ++skipped;
-            continue;
-        }
-        const QString nameNormalized = normalizeToken(name);
-        if (nameNormalized == "name" || nameNormalized == "spielername")
-        {
-            ++skipped;
-            continue;
-        }
-
-        Player player;
-        player.name = name.trimmed();
-        player.t17name = valueAt(cols, t17Idx);
-        player.group = valueAt(cols, groupIdx);
-        player.comment = valueAt(cols, commentIdx);
-        player.rank = valueAt(cols, rankIdx);
-        player.nextRank = valueAt(cols, nextRankIdx);
-        player.level = parseIntValue(valueAt(cols, levelIdx));
-        player.joinDate = parseDateValue(valueAt(cols, joinIdx));
-        player.lastPromotionDate = parseDateValue(valueAt(cols, lastPromotionIdx));
-        player.attendance = parseIntValue(valueAt(cols, trainingsRankIdx));
-        player.totalAttendance = parseIntValue(valueAt(cols, trainingsTotalIdx));
-        if (player.attendance <= 0 && player.totalAttendance > 0)
-            player.attendance = player.totalAttendance;
-        if (player.totalAttendance <= 0 && player.attendance > 0)
-            player.totalAttendance = player.attendance;
-        player.events = parseIntValue(valueAt(cols, eventsIdx));
-        player.totalEvents = player.events;
-        player.reserve = parseIntValue(valueAt(cols, reserveIdx));
-        player.totalReserve = player.reserve;
-        if (!player.group.isEmpty())
-            groupsChanged = ensureGroupRegistered(player.group) || groupsChanged;
-
-        const int before = static_cast<int>(list.players.size());
-        list.addOrMerge(player);
-        if (static_cast<int>(list.players.size()) == before)
-            ++merged;
-        else
-            ++imported;
-    }
-
+    for (const QString &group : result.groups)
+        groupsChanged = ensureGroupRegistered(group) || groupsChanged;
     if (groupsChanged)
         saveGroups();
 
     refreshModelFromList();
     validateAllRows();
     savePlayers();
-
-    QMessageBox::information(this, QStringLiteral("Import abgeschlossen"), QStringLiteral("%1 Spieler verarbeitet (%2 neu, %3 aktualisiert). %4 Zeilen übersprungen.").arg(imported + merged).arg(imported).arg(merged).arg(skipped));
 }
 
 // Test-Hilfsmethode: direkter Import ohne QFileDialog
 bool MainWindow::importCsvFile(const QString &filePath, int *outImported, int *outMerged, int *outSkipped)
 {
+    CsvImportResult result;
+    const bool ok = runCsvImport(filePath, QStringLiteral("importCsvFile"), result);
     if (outImported)
-        *outImported = 0;
+        *outImported = result.imported;
     if (outMerged)
-        *outMerged = 0;
+        *outMerged = result.merged;
     if (outSkipped)
-        *outSkipped = 0;
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
-    {
-        appendErrorLog("importCsvFile", QStringLiteral("Datei konnte nicht geöffnet werden: %1").arg(file.errorString()));
-        return false;
-    }
-    QTextStream stream(&file);
-    stream.setEncoding(QStringConverter::Utf8);
-    QStringList rawLines;
-    while (!stream.atEnd())
-        rawLines << stream.readLine();
-    file.close();
-    if (rawLines.isEmpty())
+        *outSkipped = result.skipped;
+    return ok;
+}
+
+bool MainWindow::importCsvFileAsync(const QString &filePath)
+{
+    if (isCsvImportRunning())
         return false;
-    auto detectDelimiter = [](const QStringList &lines) -> QChar
-    {
-        const QList<QChar> candidates = {QChar('\t'), QChar(';'), QChar(','), QChar('|')};
-        QMap<QChar, int> scores;
-        for (QChar c : candidates)
-            scores[c] = 0;
-        int inspected = 0;
-        for (const QString &line : lines)
-        {
-            QString t = line.trimmed();
-            if (t.isEmpty())
-                continue;
-            for (QChar c : candidates)
-                scores[c] += t.count(c);
-            if (++inspected >= 12)
-                break;
-        }
-        QChar best = ',';
-        int bestScore = -1;
-        for (QChar c : candidates)
-            if (scores[c] > bestScore)
-            {
-                bestScore = scores[c];
-                best = c;
-            }
-        return bestScore <= 0 ? QChar(';') : best;
+    if (!csvImportWatcher)
+    {
+        csvImportWatcher = new QFutureWatcher<CsvImportOutcome>(this);
+        connect(csvImportWatcher, &QFutureWatcherBase::progressValueChanged, this, &MainWindow::csvImportProgress);
+        connect(csvImportWatcher, &QFutureWatcherBase::finished, this, &MainWindow::finishCsvImportAsync);
+    }
+    csvImportResult = CsvImportResult();
+
+    // Der Worker liest nur die Datei und fasst weder list noch MainWindow an
+    auto work = [](QPromise<CsvImportOutcome> &promise, const QString &path)
+    {
+        promise.setProgressRange(0, 100);
+        PlayerCsvImporter importer;
+        importer.setCancelCheck([&promise]()
+                                { return promise.isCanceled(); });
+        importer.setProgressCallback([&promise](qint64 done, qint64 total)
+                                     { promise.setProgressValue(total > 0 ? static_cast<int>(done * 100 / total) : 100); });
+        CsvImportOutcome outcome;
+        importer.readFile(path, outcome.players, outcome.result);
+        promise.addResult(std::move(outcome));
     };
-    const QChar delimiter = detectDelimiter(rawLines);
-    auto splitLine = [delimiter](const QString &line) -> QStringList
-    {
-        QString normalized = line; normalized.remove('\r'); QStringList cols; QString current; bool inQuotes=false;
-        for (int i=0;i<normalized.size();++i) { QChar ch=normalized.at(i); if (ch=='"') { if (inQuotes && i+1<normalized.size() && normalized.at(i+1)=='"'){ current.append('"'); ++i;} else inQuotes=!inQuotes; }
-            else if (ch==delimiter && !inQuotes) { cols<<current; current.clear(); } else current.append(ch); }
-        cols<<current; for (QString &v: cols){ v=v.trimmed(); if (v.startsWith('"') && v.endsWith('"') && v.size()>=2) v=v.mid(1,v.size()-2).trimmed(); if(!v.isEmpty() && v.at(0)==QChar(0xFEFF)) v.remove(0,1);} return cols; };
-    QList<QStringList> rows;
-    for (const QString &line : rawLines)
+    csvImportWatcher->setFuture(QtConcurrent::run(work, filePath));
+    return true;
+}
+
+void MainWindow::cancelCsvImport()
+{
+    if (isCsvImportRunning())
+        csvImportWatcher->cancel();
+}
+
+bool MainWindow::isCsvImportRunning() const
+{
+    return csvImportWatcher && csvImportWatcher->isRunning();
+}
+
+void MainWindow::finishCsvImportAsync()
+{
+    QFuture<CsvImportOutcome> future = csvImportWatcher->future();
+    if (future.isCanceled() || future.resultCount() == 0)
     {
-        if (line.trimmed().isEmpty())
-            continue;
-        rows << splitLine(line);
+        csvImportResult = CsvImportResult();
+        csvImportResult.error = CsvImportResult::Canceled;
+        emit csvImportFinished(false);
+        return;
     }
-    if (rows.isEmpty())
-        return false;
-    int headerRow = 0;
-    QStringList headers = rows.at(headerRow);
-    QStringList normalizedHeaders;
-    for (const QString &h : headers)
-    {
-        QString n = h.trimmed().toLower();
-        n.replace(' ', '_');
-        normalizedHeaders << n;
-    }
-    auto normalizeToken = [](QString t)
-    { t=t.trimmed().toLower(); t.replace(' ','_'); return t; };
-    auto findColumn = [&](const QStringList &candidates)
-    { for (const QString &cand: candidates){ QString needle=normalizeToken(cand); if (needle.isEmpty()) continue; for (int i=0;i<normalizedHeaders.size();++i){ if (normalizedHeaders.at(i)==needle) return i; } } for (const QString &cand: candidates){ QString needle=normalizeToken(cand); if (needle.isEmpty()) continue; for (int i=0;i<normalizedHeaders.size();++i){ if (normalizedHeaders.at(i).contains(needle)) return i; } } return -1; };
-    auto findColumnByParts = [&](const QStringList &parts)
-    { for (int i=0;i<normalizedHeaders.size();++i){ bool matches=true; for (const QString &part: parts){ QString needle=normalizeToken(part); if (needle.isEmpty()) continue; if (!normalizedHeaders.at(i).contains(needle)){ matches=false; break; } } if (matches) return i; } return -1; };
-    int nameIdx = findColumn(QStringList{QStringLiteral("Name"), QStringLiteral("Spielername")});
-    if (nameIdx < 0)
-        return false;
-    int groupIdx = findColumn(QStringList{QStringLiteral("Gruppe"), QStringLiteral("Trupp")});
-    int levelIdx = findColumn(QStringList{QStringLiteral("Level")});
-    auto valueAt = [](const QStringList &cols, int idx) -> QString
-    { return (idx < 0 || idx >= cols.size()) ? QString() : cols.at(idx).trimmed(); };
-    auto parseIntValue = [](const QString &text) -> int
-    { QString cleaned; for (QChar ch: text){ if (ch.isDigit()) cleaned.append(ch); else if (ch=='-' && cleaned.isEmpty()) cleaned.append(ch);} bool ok=false; int v=cleaned.toInt(&ok); return ok? v:0; };
-    int imported = 0, merged = 0, skipped = 0;
-    bool groupsChanged = false;
-    for (int r = headerRow + 1; r < rows.size(); ++r)
+
+    CsvImportOutcome outcome = future.takeResult();
+    csvImportResult = outcome.result;
+    if (csvImportResult.error != CsvImportResult::NoError)
     {
-        const QStringList &cols = rows.at(r);
-        QString name = valueAt(cols, nameIdx);
-        if (name.trimmed().isEmpty())
-        {
-            ++skipped;
-            continue;
-        }
-        Player player;
-        player.name = name.trimmed();
-        player.group = valueAt(cols, groupIdx);
-        player.level = parseIntValue(valueAt(cols, levelIdx));
-        if (!player.group.isEmpty())
-            groupsChanged = ensureGroupRegistered(player.group) || groupsChanged;
-        int before = list.players.size();
-        list.addOrMerge(player);
-        if ((int)list.players.size() == before)
-            ++merged;
-        else
-            ++imported;
+        if (csvImportResult.error != CsvImportResult::Canceled)
+            appendErrorLog("importCsvFileAsync", csvImportResult.errorString);
+        emit csvImportFinished(false);
+        return;
     }
-    if (groupsChanged)
-        saveGroups();
-    refreshModelFromList();
-    validateAllRows();
-    savePlayers();
-    if (outImported)
-        *outImported = imported;
-    if (outMerged)
-        *outMerged = merged;
-    if (outSkipped)
-        *outSkipped = skipped;
-    return true;
+
+    // Gegen die aktuelle Liste mergen: was während des Lesens bearbeitet oder per
+    // OCR angelegt wurde, bleibt erhalten. Danach ein Reset statt Zeile für Zeile.
+    PlayerCsvImporter importer;
+    importer.setFuzzyMergeDistance(csvFuzzyMerge ? fuzzyMatchThreshold : 0);
+    importer.mergeInto(outcome.players, list, csvImportResult);
+    applyCsvImport(csvImportResult);
+    emit csvImportFinished(true);
 }
 
 bool MainWindow::isPlayerFlaggedNoResponse(const QString &playerName) const
@@ -4007,10 +3466,7 @@ bool MainWindow::isPlayerFlaggedNoResponse(const QString &playerName) const
     int row = rowForPlayerKey(playerName);
     if (row < 0)
         return false;
-    QStandardItem *statusItem = model->item(row, 1);
-    if (!statusItem)
-        return false;
-    return statusItem->text() == QStringLiteral("❌");
+    return model->index(row, PlayerTableModel::StatusColumn).data().toString() == QStringLiteral("❌");
 }
 
 QMap<QString, QStringList> MainWindow::groupingSnapshot() const
@@ -4018,7 +3474,7 @@ QMap<QString, QStringList> MainWindow::groupingSnapshot() const
     QMap<QString, QStringList> grouped;
     for (const Player &p : list.players)
     {
-        QString g = p.group.trimmed();
+        QString g = p.group.toString().trimmed();
         if (g.isEmpty())
             g = QStringLiteral("Ohne Gruppe");
         grouped[g].append(p.name);
@@ -4060,6 +3516,22 @@ void MainWindow::testRebuildModel()
     refreshModelFromList();
     validateAllRows();
 }
+void MainWindow::setSearchDebounceInterval(int msecs)
+{
+    if (searchDebounce)
+        searchDebounce->setInterval(qMax(0, msecs));
+}
+void MainWindow::flushPendingSearch()
+{
+    if (!searchDebounce || !searchDebounce->isActive())
+        return;
+    searchDebounce->stop();
+    static_cast<SortProxy *>(proxy)->setTextFilter(searchEdit->text());
+}
+int MainWindow::visiblePlayerCount() const
+{
+    return proxy ? proxy->rowCount() : 0;
+}
 void MainWindow::exportCsv()
 {
     QString filter = QStringLiteral("CSV (*.csv);;TSV (*.tsv);;Alle Dateien (*.*)");
@@ -4130,13 +3602,13 @@ void MainWindow::exportCsv()
         cols << p.name
              << p.t17name
              << QString::number(p.level)
-             << p.group
+             << p.group.toString()
              << QString::number(p.attendance)
              << p.comment
              << p.joinDate.toString(Qt::ISODate)
-             << p.rank
+             << p.rank.toString()
              << p.lastPromotionDate.toString(Qt::ISODate)
-             << p.nextRank
+             << p.nextRank.toString()
              << QString::number(p.totalAttendance)
              << QString::number(p.events)
              << QString::number(p.totalEvents)
@@ -4193,7 +3665,7 @@ void MainWindow::assignAttendanceMulti()
     const QString noGroupLabel = QStringLiteral("Ohne Gruppe");
     for (const Player &p : list.players)
     {
-        QString grp = p.group.trimmed();
+        QString grp = p.group.toString().trimmed();
         if (grp.isEmpty())
             grp = noGroupLabel;
         grouped[grp].append(p);
@@ -4284,236 +3756,77 @@ void MainWindow::assignAttendanceMulti()
         if (guard) return;
         guard = true;
         if (!item)
-        {
-            guard = false;
-            return;
-        }
-        if (!item->parent())
-        {
-            // Top-Level: setze alle Kinder auf gleichen Zustand
-            Qt::CheckState st = item->checkState(0);
-            for (int i = 0; i < item->childCount(); ++i)
-                item->child(i)->setCheckState(0, st);
-        }
-        else
-        {
-            // Kind geändert: aggregiere Zustand zum Parent
-            QTreeWidgetItem *parent = item->parent();
-            int total = parent->childCount();
-            int checked = 0;
-            for (int i = 0; i < total; ++i)
-            {
-                if (parent->child(i)->checkState(0) == Qt::Checked)
-                    ++checked;
-            }
-            if (checked == 0)
-                parent->setCheckState(0, Qt::Unchecked);
-            else if (checked == total)
-                parent->setCheckState(0, Qt::Checked);
-            else
-                parent->setCheckState(0, Qt::PartiallyChecked);
-        }
-        updateSelectedCount();
-        guard = false; });
-
-    // OCR Upload: Bilddatei -> Tesseract -> Namen erkennen -> Häkchen setzen
-    QObject::connect(uploadBtn, &QPushButton::clicked, &dlg, [this, &dlg, playerTree, updateSelectedCount]()
-                     {
-        QFileDialog::Options opts;
-        opts |= QFileDialog::DontUseNativeDialog;
-        QString file = QFileDialog::getOpenFileName(&dlg, QStringLiteral("Bild mit Spielerliste wählen"), QDir::homePath(),
-                                                    QStringLiteral("Bilder (*.png *.jpg *.jpeg *.bmp *.tif *.tiff);;Alle Dateien (*.*)"), nullptr, opts);
-        if (file.isEmpty())
-            return;
-
-        QProcess proc;
-        QString program = QStringLiteral("tesseract");
-        QStringList args;
-        // Deutsch als OCR-Sprache verwenden
-        args << file << QStringLiteral("stdout") << QStringLiteral("-l") << QStringLiteral("deu");
-        proc.start(program, args);
-        if (!proc.waitForStarted(5000))
-        {
-            QMessageBox::warning(&dlg, QStringLiteral("Tesseract fehlt"),
-                                 QStringLiteral("Tesseract konnte nicht gestartet werden. Bitte installieren (z.B. via Homebrew: brew install tesseract)."));
-            return;
-        }
-        proc.waitForFinished(-1);
-        QByteArray out = proc.readAllStandardOutput();
-        QByteArray err = proc.readAllStandardError();
-        if (proc.exitStatus() != QProcess::NormalExit || proc.exitCode() != 0)
-        {
-            QMessageBox::warning(&dlg, QStringLiteral("OCR-Fehler"),
-                                 QStringLiteral("Die Texterkennung ist fehlgeschlagen.\n%1").arg(QString::fromUtf8(err)));
-            return;
-        }
-        QString textRaw = QString::fromUtf8(out);
-        QString textLower = textRaw.toLower();
-
-        // Event-Metadaten aus OCR extrahieren (falls vorhanden)
-        QString extractedEventName;
-        QString extractedDate;
-        QString extractedMap;
-        bool isTraining = false;
-
-        // Suche nach Event-Name (erste Zeile oder Zeile mit "vs" oder spezifischen Mustern)
-        QStringList allLines = textRaw.split(QRegularExpression("[\\r\\n]+"), Qt::SkipEmptyParts);
-
-        // Training vs Event Erkennung
-        QStringList trainingKeywords = {"training", "clantraining", "freitagstraining", "montagstraining",
-                                        "übung", "practice", "drill"};
-        QStringList eventKeywords = {"event", "vs", "versus", "match", "scrim", "scrimmage", "gegen"};
-
-        for (const QString &line : allLines)
-        {
-            QString lineLower = line.toLower();
-            for (const QString &kw : trainingKeywords)
-            {
-                if (lineLower.contains(kw))
-                {
-                    isTraining = true;
-                    break;
-                }
-            }
-            if (!isTraining)
-            {
-                for (const QString &kw : eventKeywords)
-                {
-                    if (lineLower.contains(kw))
-                    {
-                        isTraining = false;
-                        break;
-                    }
-                }
-            }
-        }
-        if (!allLines.isEmpty())
-        {
-            // Erste nicht-leere Zeile als möglicher Event-Name
-            QString firstLine = allLines.first().trimmed();
-            if (firstLine.length() >= 5 && firstLine.length() <= 80)
-            {
-                extractedEventName = firstLine;
-            }
-        }
-
-        // Suche nach Datum (Format: DD.MM.YYYY oder ähnlich)
-        QRegularExpression dateRx(QStringLiteral(R"(\b(\d{1,2})[\.\-/](\d{1,2})[\.\-/](\d{4})\b)"));
-        QRegularExpressionMatch dateMatch = dateRx.match(textRaw);
-        if (dateMatch.hasMatch())
-        {
-            int day = dateMatch.captured(1).toInt();
-            int month = dateMatch.captured(2).toInt();
-            int year = dateMatch.captured(3).toInt();
-            QDate parsedDate(year, month, day);
-            if (parsedDate.isValid())
-            {
-                extractedDate = parsedDate.toString("dd.MM.yyyy");
-            }
-        }
-
-        // Suche nach Map (häufige Maps: SME, Carentan, Foy, Kursk, etc.)
-        QStringList knownMaps = {"SME", "Carentan", "Foy", "Kursk", "Stalingrad", "Omaha", "Utah",
-                                 "Purple Heart Lane", "Hill 400", "Hurtgen", "Sainte", "SMDM"};
-        for (const QString &map : knownMaps)
-        {
-            if (textRaw.contains(map, Qt::CaseInsensitive))
-            {
-                extractedMap = map;
-                break;
-            }
-        }
-
-        // Parse Zusagen/Absagen aus dem Bild (Akzeptiert, Tank, Abgelehnt)
-        QSet<QString> acceptedPlayers; // Spieler die zugesagt haben
-        QSet<QString> rejectedPlayers; // Spieler die abgesagt haben
-
-        // Suche nach Status-Kategorien im OCR-Text
-        QRegularExpression acceptedRx(QStringLiteral(R"(Akzeptiert\s*\((\d+)\))"), QRegularExpression::CaseInsensitiveOption);
-        QRegularExpression tankRx(QStringLiteral(R"(Tank\s*\((\d+)\))"), QRegularExpression::CaseInsensitiveOption);
-        QRegularExpression rejectedRx(QStringLiteral(R"(Abgelehnt\s*\((\d+)\))"), QRegularExpression::CaseInsensitiveOption);
-
-        int acceptedIdx = -1, tankIdx = -1, rejectedIdx = -1;
-        for (int i = 0; i < allLines.size(); ++i)
-        {
-            QString line = allLines[i];
-            if (acceptedRx.match(line).hasMatch())
-                acceptedIdx = i;
-            if (tankRx.match(line).hasMatch())
-                tankIdx = i;
-            if (rejectedRx.match(line).hasMatch())
-                rejectedIdx = i;
-        }
-
-        // Extrahiere Namen unter den jeweiligen Kategorien
-        if (acceptedIdx >= 0)
-        {
-            int nextCategoryIdx = qMin(tankIdx >= 0 ? tankIdx : allLines.size(),
-                                       rejectedIdx >= 0 ? rejectedIdx : allLines.size());
-            for (int i = acceptedIdx + 1; i < nextCategoryIdx && i < allLines.size(); ++i)
-            {
-                QString line = allLines[i].trimmed();
-                if (!line.isEmpty() && line.length() >= 3 && line.length() <= 48)
-                {
-                    acceptedPlayers.insert(line);
-                }
-            }
+        {
+            guard = false;
+            return;
         }
-
-        if (tankIdx >= 0)
+        if (!item->parent())
         {
-            int nextCategoryIdx = rejectedIdx >= 0 ? rejectedIdx : allLines.size();
-            for (int i = tankIdx + 1; i < nextCategoryIdx && i < allLines.size(); ++i)
-            {
-                QString line = allLines[i].trimmed();
-                if (!line.isEmpty() && line.length() >= 3 && line.length() <= 48)
-                {
-                    acceptedPlayers.insert(line); // Tank ist auch eine Zusage!
-                }
-            }
+            // Top-Level: setze alle Kinder auf gleichen Zustand
+            Qt::CheckState st = item->checkState(0);
+            for (int i = 0; i < item->childCount(); ++i)
+                item->child(i)->setCheckState(0, st);
         }
-
-        if (rejectedIdx >= 0)
+        else
         {
-            for (int i = rejectedIdx + 1; i < allLines.size(); ++i)
+            // Kind geändert: aggregiere Zustand zum Parent
+            QTreeWidgetItem *parent = item->parent();
+            int total = parent->childCount();
+            int checked = 0;
+            for (int i = 0; i < total; ++i)
             {
-                QString line = allLines[i].trimmed();
-                if (!line.isEmpty() && line.length() >= 3 && line.length() <= 48)
-                {
-                    rejectedPlayers.insert(line);
-                }
+                if (parent->child(i)->checkState(0) == Qt::Checked)
+                    ++checked;
             }
+            if (checked == 0)
+                parent->setCheckState(0, Qt::Unchecked);
+            else if (checked == total)
+                parent->setCheckState(0, Qt::Checked);
+            else
+                parent->setCheckState(0, Qt::PartiallyChecked);
         }
+        updateSelectedCount();
+        guard = false; });
 
-        // Levenshtein-Distanz Hilfsfunktion
-        auto levenshtein = [](const QString &s1, const QString &s2) -> int
-        {
-            const int m = s1.size(), n = s2.size();
-            QVector<QVector<int>> dp(m + 1, QVector<int>(n + 1));
-            for (int i = 0; i <= m; ++i)
-                dp[i][0] = i;
-            for (int j = 0; j <= n; ++j)
-                dp[0][j] = j;
-            for (int i = 1; i <= m; ++i)
-            {
-                for (int j = 1; j <= n; ++j)
-                {
-                    int cost = (s1[i - 1] == s2[j - 1]) ? 0 : 1;
-                    dp[i][j] = std::min({dp[i - 1][j] + 1, dp[i][j - 1] + 1, dp[i - 1][j - 1] + cost});
-                }
-            }
-            return dp[m][n];
-        };
+    // OCR Upload: Bilddatei -> Tesseract -> Namen erkennen -> Häkchen setzen
+    auto dialogOcrJob = std::make_shared<quint64>(0);
+    QObject::connect(uploadBtn, &QPushButton::clicked, &dlg, [this, &dlg, dialogOcrJob]()
+                     {
+        QFileDialog::Options opts;
+        opts |= QFileDialog::DontUseNativeDialog;
+        // Mehrere Screenshots einer langen Liste werden zusammen erkannt
+        const QStringList files = QFileDialog::getOpenFileNames(&dlg, QStringLiteral("Bilder mit Spielerliste wählen"), QDir::homePath(),
+                                                                QStringLiteral("Bilder (*.png *.jpg *.jpeg *.bmp *.tif *.tiff);;Alle Dateien (*.*)"), nullptr, opts);
+        if (files.isEmpty())
+            return;
+        // Erkennung läuft im Hintergrund, der Dialog bleibt bedienbar
+        if (*dialogOcrJob)
+            ocrService->cancel(*dialogOcrJob);
+        *dialogOcrJob = startOcrJob(&dlg, files); });
+    QObject::connect(ocrService, &OcrService::finished, &dlg, [this, &dlg, playerTree, updateSelectedCount, dialogOcrJob](const OcrResult &ocr)
+                     {
+        if (ocr.job != *dialogOcrJob)
+            return;
+        *dialogOcrJob = 0;
+        if (reportOcrError(&dlg, ocr))
+            return;
+        const QString textLower = ocr.text.toLower();
+
+        // Abschnitte, Event-Daten, Typ und Namenskandidaten (im Worker ausgewertet)
+        const RosterTextParser::Result &roster = ocr.roster;
+        const QString &extractedEventName = roster.eventName;
+        const QString extractedDate = roster.date.isValid() ? roster.date.toString("dd.MM.yyyy") : QString();
+        const QString &extractedMap = roster.map;
+        const bool isTraining = roster.training;
+
+        // Zusagen/Absagen aus dem Bild (Akzeptiert, Tank, Abgelehnt)
+        const QSet<QString> acceptedPlayers(roster.accepted.cbegin(), roster.accepted.cend());
+        const QSet<QString> rejectedPlayers(roster.rejected.cbegin(), roster.rejected.cend());
 
         // Bekannte Spieler per Name oder T17-Name im OCR-Text finden (exakt + Fuzzy)
         QSet<QString> recognizedKeys;
-        QMap<QString, QString> existingByLower;
         for (const Player &p : list.players)
         {
-            if (!p.name.isEmpty())
-                existingByLower.insert(p.name.toLower(), p.name);
-            if (!p.t17name.isEmpty())
-                existingByLower.insert(p.t17name.toLower(), p.name);
             QString name = p.name.toLower();
             QString t17 = p.t17name.toLower();
             if (!name.isEmpty() && textLower.contains(name))
@@ -4522,268 +3835,45 @@ void MainWindow::assignAttendanceMulti()
                 recognizedKeys.insert(p.name);
         }
 
-        // Rang-Präfixe zum Trennen von Namen
-        QStringList rankPrefixes = MainWindow::rankOptions();
-
-        // Hilfsfunktion: Trenne Namen mit mehreren Rängen oder Leerzeichen + Großbuchstabe
-        auto splitNames = [&rankPrefixes](const QString &text) -> QStringList {
-            QStringList result;
-            QString current = text.trimmed();
-            
-            // Finde alle Vorkommen von Rängen
-            QList<int> rankPositions;
-            for (const QString &rank : rankPrefixes) {
-                if (rank.isEmpty()) continue;
-                QRegularExpression rx(QRegularExpression::escape(rank), 
-                                     QRegularExpression::CaseInsensitiveOption);
-                QRegularExpressionMatchIterator it = rx.globalMatch(current);
-                while (it.hasNext()) {
-                    QRegularExpressionMatch match = it.next();
-                    rankPositions << match.capturedStart();
-                }
-            }
-            
-            // Wenn mehrere Ränge: trenne bei jedem Rang
-            if (rankPositions.size() > 1) {
-                std::sort(rankPositions.begin(), rankPositions.end());
-                for (int i = 0; i < rankPositions.size(); ++i) {
-                    int start = rankPositions[i];
-                    int end = (i + 1 < rankPositions.size()) ? rankPositions[i + 1] : current.length();
-                    QString segment = current.mid(start, end - start).trimmed();
-                    if (!segment.isEmpty() && segment.length() >= 3)
-                        result << segment;
-                }
-                return result;
-            }
-            
-            // Fallback: Trenne bei Leerzeichen + Kleinbuchstabe oder Großbuchstabe
-            QRegularExpression splitPattern1("\\s+(?=[a-zäöüß])");
-            QStringList parts1 = current.split(splitPattern1, Qt::SkipEmptyParts);
-            if (parts1.size() > 1) {
-                for (const QString &p : parts1) {
-                    if (p.trimmed().length() >= 3)
-                        result << p.trimmed();
-                }
-                if (!result.isEmpty()) return result;
-            }
-            
-            QRegularExpression splitPattern2("\\s+(?=[A-ZÄÖÜ])");
-            QStringList parts2 = current.split(splitPattern2, Qt::SkipEmptyParts);
-            if (parts2.size() > 1) {
-                for (const QString &p : parts2) {
-                    if (p.trimmed().length() >= 3)
-                        result << p.trimmed();
-                }
-                if (!result.isEmpty()) return result;
-            }
-            
-            if (!current.isEmpty() && current.length() >= 3)
-                result << current;
-            return result;
-        };
-
-        // Alle Spieler aus acceptedPlayers und rejectedPlayers sammeln (mit Trennung)
-        QSet<QString> allParsedPlayers;
-        for (const QString &player : acceptedPlayers) {
-            for (const QString &split : splitNames(player))
-                allParsedPlayers.insert(split);
-        }
-        for (const QString &player : rejectedPlayers) {
-            for (const QString &split : splitNames(player))
-                allParsedPlayers.insert(split);
-        }
-
-        // Hilfsfunktion: Teile String bei mehrfach vorkommenden Rängen
-        auto splitByRanks = [&rankPrefixes](const QString &text) -> QStringList
-        {
-            QStringList result;
-            QString current = text.trimmed();
-            
-            // Finde alle Vorkommen von Rängen im Text
-            QList<int> rankPositions;
-            QList<QString> foundRanks;
-            
-            for (const QString &rank : rankPrefixes) {
-                if (rank.isEmpty()) continue;
-                
-                // Suche nach Rang-Vorkommen (case-insensitive)
-                QRegularExpression rx(QRegularExpression::escape(rank), 
-                                     QRegularExpression::CaseInsensitiveOption);
-                QRegularExpressionMatchIterator it = rx.globalMatch(current);
-                while (it.hasNext()) {
-                    QRegularExpressionMatch match = it.next();
-                    rankPositions << match.capturedStart();
-                    foundRanks << rank;
-                }
-            }
-            
-            // Wenn mehr als ein Rang gefunden wurde, trenne bei jedem Rang
-            if (rankPositions.size() > 1) {
-                // Sortiere nach Position
-                QList<QPair<int, QString>> posRankPairs;
-                for (int i = 0; i < rankPositions.size(); ++i) {
-                    posRankPairs << qMakePair(rankPositions[i], foundRanks[i]);
-                }
-                std::sort(posRankPairs.begin(), posRankPairs.end());
-                
-                for (int i = 0; i < posRankPairs.size(); ++i) {
-                    int start = posRankPairs[i].first;
-                    int end = (i + 1 < posRankPairs.size()) ? posRankPairs[i + 1].first : current.length();
-                    QString segment = current.mid(start, end - start).trimmed();
-                    if (!segment.isEmpty())
-                        result << segment;
-                }
-                return result;
-            }
-            
-            // Fallback: Trenne bei Leerzeichen gefolgt von Kleinbuchstabe oder Großbuchstabe
-            // Dies erfasst sowohl "GefrBuddy eiben" als auch "Buddy Eiben" (Namen ohne Rang)
-            if (!current.isEmpty()) {
-                // Versuche zuerst Trennung bei Leerzeichen + Kleinbuchstabe
-                QRegularExpression splitPattern1("\\s+(?=[a-zäöüß])");
-                QStringList parts1 = current.split(splitPattern1, Qt::SkipEmptyParts);
-                if (parts1.size() > 1) {
-                    result = parts1;
-                    return result;
-                }
-                
-                // Dann versuche Trennung bei Leerzeichen + Großbuchstabe (für Namen ohne Rang)
-                // Aber nur wenn kein Rang am Anfang des zweiten Teils steht
-                QRegularExpression splitPattern2("\\s+(?=[A-ZÄÖÜ])");
-                QStringList parts2 = current.split(splitPattern2, Qt::SkipEmptyParts);
-                if (parts2.size() > 1) {
-                    // Prüfe ob Teile valide Namen sind (nicht nur einzelne Buchstaben)
-                    bool allValid = true;
-                    for (const QString &part : parts2) {
-                        if (part.trimmed().length() < 2) {
-                            allValid = false;
-                            break;
-                        }
-                    }
-                    if (allValid) {
-                        result = parts2;
-                        return result;
-                    }
-                }
-            }
-            
-            // Kein mehrfacher Rang gefunden, gebe Original zurück
-            if (result.isEmpty())
-                result << current;
-            return result;
-        };
-
-        // Kandidaten-Zeilen aus OCR extrahieren (Zeilen/Kommas), säubern und deduplizieren
-        QSet<QString> candidates;
-        const auto addCandidate = [&candidates](const QString &s)
-        {
-            QString c = s;
-            c.replace('\t', ' ');
-            c.replace(QRegularExpression("\\s+"), " ");
-            c = c.trimmed();
-            if (c.size() >= 3 && c.size() <= 48)
-                candidates.insert(c);
-        };
-
-        // Falls wir Status-Kategorien gefunden haben, verwende diese als Kandidaten
-        if (!allParsedPlayers.isEmpty())
-        {
-            for (const QString &player : allParsedPlayers)
-            {
-                QStringList subParts = splitByRanks(player);
-                for (const QString &sub : subParts)
-                    addCandidate(sub);
-            }
-        }
-        
-        // Falls keine Status-Kategorien gefunden wurden, verwende Fallback (alle Zeilen)
-        if (candidates.isEmpty()) {
-        const QStringList lines = textRaw.split(QRegularExpression("[\\r\\n]+"), Qt::SkipEmptyParts);
-        for (const QString &ln : lines)
-        {
-            const QStringList parts = ln.split(',', Qt::SkipEmptyParts);
-            if (parts.size() > 1)
-            {
-                for (const QString &p : parts)
-                {
-                    QStringList subParts = splitByRanks(p);
-                    for (const QString &sub : subParts)
-                        addCandidate(sub);
-                }
-            }
-            else
-            {
-                QStringList subParts = splitByRanks(ln);
-                for (const QString &sub : subParts)
-                    addCandidate(sub);
-            }
-        }
-        }
-
         // Unbekannte Spieler anlegen in Gruppe "Nicht zugewiesen" (mit Fuzzy-Matching)
         const QString unassignedGroup = QStringLiteral("Nicht zugewiesen");
         QSet<QString> createdKeys;
         QSet<QString> acceptedCreatedKeys;  // Neue Spieler die zugesagt haben
-        constexpr int fuzzyThreshold = 2;
-        if (!candidates.isEmpty())
-        {
-        for (const QString &cand : std::as_const(candidates))
+        const int fuzzyThreshold = fuzzyMatchThreshold;
+        if (!roster.candidates.isEmpty())
+        {
+        // Zusagen sind wenige: einmal als Liste aufbauen. Bekannte Namen kommen aus
+        // dem Fuzzy-Index der Spielerliste, neu angelegte Spieler landen dort mit.
+        EditDistance::Roster acceptedRoster;
+        for (const QString &acc : std::as_const(acceptedPlayers))
+            acceptedRoster.append(acc.toLower());
+        const FuzzyNameIndex &knownNames = list.fuzzyIndex();
+        QList<int> createdRows;
+        model->beginBatch();
+        for (const QString &cand : roster.candidates)
         {
             const QString lower = cand.toLower();
+            const QString key = PlayerList::foldKey(cand);
             // Exakte Übereinstimmung prüfen
-            if (existingByLower.contains(lower))
+            if (knownNames.contains(key))
             {
                 // Prüfe ob dieser existierende Spieler zugesagt hat
-                QString matchedPlayerName = existingByLower.value(lower);
-                bool isAccepted = false;
-                for (const QString &acc : acceptedPlayers)
-                {
-                    if (acc.toLower() == lower || levenshtein(acc.toLower(), lower) <= 1)
-                    {
-                        isAccepted = true;
-                        recognizedKeys.insert(matchedPlayerName);
-                        break;
-                    }
-                }
+                if (acceptedRoster.firstWithin(lower, 1) >= 0)
+                    recognizedKeys.insert(knownNames.value(key));
                 continue;
             }
-            // Fuzzy-Matching gegen alle vorhandenen Namen
-            bool fuzzyMatch = false;
-            for (auto it = existingByLower.cbegin(); it != existingByLower.cend(); ++it)
+            // Fuzzy-Matching gegen alle vorhandenen Namen (nächster Treffer)
+            FuzzyNameIndex::Match match;
+            if (knownNames.nearest(key, fuzzyThreshold, &match))
             {
-                if (levenshtein(lower, it.key()) <= fuzzyThreshold)
-                {
-                    fuzzyMatch = true;
-                    // Prüfe ob dieser Spieler zugesagt hat
-                    bool isAccepted = false;
-                    for (const QString &acc : acceptedPlayers)
-                    {
-                        if (levenshtein(acc.toLower(), lower) <= fuzzyThreshold)
-                        {
-                            isAccepted = true;
-                            break;
-                        }
-                    }
-                    if (isAccepted)
-                    {
-                        recognizedKeys.insert(it.value());
-                    }
-                    break;
-                }
-            }
-            if (fuzzyMatch)
+                // Prüfe ob dieser Spieler zugesagt hat
+                if (acceptedRoster.firstWithin(lower, fuzzyThreshold) >= 0)
+                    recognizedKeys.insert(match.value);
                 continue;
+            }
 
             // Prüfe ob neuer Spieler zugesagt hat
-            bool isAccepted = false;
-            for (const QString &acc : acceptedPlayers)
-            {
-                if (levenshtein(acc.toLower(), lower) <= 1)
-                {
-                    isAccepted = true;
-                    break;
-                }
-            }
+            const bool isAccepted = acceptedRoster.firstWithin(lower, 1) >= 0;
 
             // neuen Spieler anlegen
             Player np;
@@ -4795,11 +3885,9 @@ void MainWindow::assignAttendanceMulti()
             np.totalAttendance = qMax(np.totalAttendance, np.attendance);
             np.totalEvents = qMax(np.totalEvents, np.events);
             np.totalReserve = qMax(np.totalReserve, np.reserve);
-            list.players.push_back(np);
             if (ensureGroupRegistered(unassignedGroup))
                 saveGroups();
-            addPlayerToModel(np);
-            validateRow(model->rowCount() - 1);
+            createdRows << addPlayerToModel(np);
             createdKeys.insert(np.name);
             // Nur bei Zusagen markieren
             if (isAccepted)
@@ -4807,8 +3895,10 @@ void MainWindow::assignAttendanceMulti()
                 recognizedKeys.insert(np.name);
                 acceptedCreatedKeys.insert(np.name);
             }
-            existingByLower.insert(lower, np.name);
         }
+        model->endBatch();
+        for (int row : std::as_const(createdRows))
+            validateRow(row);
         if (!createdKeys.isEmpty())
             savePlayers();
         }
@@ -4968,7 +4058,7 @@ void MainWindow::assignAttendanceMulti()
     for (const Training &t : templates)
     {
         QString dateText = t.date.isValid() ? t.date.toString("yyyy-MM-dd") : QStringLiteral("?");
-        QString label = QStringLiteral("%1 · %2 · %3").arg(dateText, t.type, t.title);
+        QString label = QStringLiteral("%1 · %2 · %3").arg(dateText, t.type.toString(), t.title);
         existingCombo->addItem(label, t.id);
     }
     sessionForm->addRow("Vorlage", existingCombo);
@@ -5013,11 +4103,11 @@ void MainWindow::assignAttendanceMulti()
             rememberCheck->setChecked(true);
             return;
         }
-        int typeIdx = typeCombo->findText(tpl->type, Qt::MatchFixedString);
+        int typeIdx = typeCombo->findText(tpl->type.toString(), Qt::MatchFixedString);
         if (typeIdx >= 0)
             typeCombo->setCurrentIndex(typeIdx);
         else
-            typeCombo->setCurrentText(tpl->type);
+            typeCombo->setCurrentText(tpl->type.toString());
         nameEdit->setText(tpl->title);
         if (!tpl->maps.isEmpty())
             mapCombo->setCurrentText(tpl->maps.first());
@@ -5057,7 +4147,11 @@ void MainWindow::assignAttendanceMulti()
         dlg.accept(); });
     connect(buttons, &QDialogButtonBox::rejected, &dlg, &QDialog::reject);
 
-    if (dlg.exec() != QDialog::Accepted)
+    const int dialogResult = dlg.exec();
+    // Laufende Erkennung gehört zum Dialog
+    if (*dialogOcrJob)
+        ocrService->cancel(*dialogOcrJob);
+    if (dialogResult != QDialog::Accepted)
         return;
 
     QString type = typeCombo->currentText().trimmed();
@@ -5142,24 +4236,9 @@ void MainWindow::assignAttendanceMulti()
                 if (incrementCounterOnNoResponse)
                     player->noResponseCounter++;
                 int row = rowForPlayerKey(key);
+                // Einsätze-Anzeige (Counter) und rotes X neu zeichnen
                 if (row >= 0)
-                {
-                    // Update Einsätze-Anzeige mit neuem Counter
-                    if (QStandardItem *trainingItem = model->item(row, 5))
-                    {
-                        trainingItem->setText(formatTrainingDisplay(*player));
-                        trainingItem->setToolTip(trainingTooltip(*player));
-                    }
-                    // Setze rotes X wenn Counter >= threshold
-                    if (QStandardItem *statusItem = model->item(row, 1))
-                    {
-                        if (player->noResponseCounter >= noResponseThreshold)
-                        {
-                            statusItem->setText("❌");
-                            statusItem->setForeground(QBrush(Qt::red));
-                        }
-                    }
-                }
+                    model->playerChanged(row, PlayerTableModel::StatusColumn, PlayerTableModel::TrainingColumn);
             }
         }
     }
@@ -5187,6 +4266,13 @@ void MainWindow::saveCommentOptions() {}
 void MainWindow::loadTrainings()
 {
     trainings.clear();
+    if (startupSnapshot)
+    {
+        trainings = startupSnapshot->trainings;
+        purgeOldTrainings();
+        refreshSessionTemplates();
+        return;
+    }
     QFile f(dataFilePath("clan_sessions.json"));
     if (!f.exists())
         return;
@@ -5397,7 +4483,7 @@ void MainWindow::showCreateSessionDialog(const QStringList &preselect, bool forc
         refreshSessionMapCombo();
     }
 
-    QMessageBox::information(this, "Gespeichert", QStringLiteral("%1 am %2 wurde angelegt.").arg(entry.type, entry.date.toString("yyyy-MM-dd")));
+    QMessageBox::information(this, "Gespeichert", QStringLiteral("%1 am %2 wurde angelegt.").arg(entry.type.toString(), entry.date.toString("yyyy-MM-dd")));
 }
 void MainWindow::refreshSessionTemplates()
 {
@@ -5411,7 +4497,7 @@ void MainWindow::refreshSessionTemplates()
     for (const Training &t : templates)
     {
         QString dateText = t.date.isValid() ? t.date.toString("yyyy-MM-dd") : QStringLiteral("?");
-        QString label = QStringLiteral("%1 · %2 · %3").arg(dateText, t.type, t.title);
+        QString label = QStringLiteral("%1 · %2 · %3").arg(dateText, t.type.toString(), t.title);
         sessionTemplateCombo->addItem(label, t.id);
     }
     int idx = previousId.isEmpty() ? 0 : sessionTemplateCombo->findData(previousId);
@@ -5466,11 +4552,11 @@ void MainWindow::applySessionTemplateSelection()
 
     if (sessionTypeCombo)
     {
-        int typeIdx = sessionTypeCombo->findText(tpl->type, Qt::MatchFixedString);
+        int typeIdx = sessionTypeCombo->findText(tpl->type.toString(), Qt::MatchFixedString);
         if (typeIdx >= 0)
             sessionTypeCombo->setCurrentIndex(typeIdx);
         else
-            sessionTypeCombo->setCurrentText(tpl->type);
+            sessionTypeCombo->setCurrentText(tpl->type.toString());
     }
     if (sessionNameEdit)
         sessionNameEdit->setText(tpl->title);
@@ -5506,7 +4592,7 @@ void MainWindow::refreshSessionPlayerTable()
     QSet<QString> validKeys;
     for (const Player &player : sorted)
     {
-        QString grp = player.group.trimmed();
+        QString grp = player.group.toString().trimmed();
         if (grp.isEmpty())
             grp = noGroupLabel;
         groupedPlayers[grp].append(player);
@@ -5718,31 +4804,23 @@ void MainWindow::commitSessionAssignment()
             incrementPlayerCounters(key, type);
 
             // noResponseCounter zurücksetzen
-            for (Player &p : list.players)
-            {
-                if (p.name.compare(key, Qt::CaseInsensitive) == 0)
-                {
-                    p.noResponseCounter = 0;
-                    break;
-                }
-            }
+            if (Player *p = list.findByNameInsensitive(key))
+                p->noResponseCounter = 0;
         }
         else if (status == ResponseStatus::NoResponse)
         {
             // Keine Antwort: noResponseCounter erhöhen
-            for (Player &p : list.players)
-            {
-                if (p.name.compare(key, Qt::CaseInsensitive) == 0)
-                {
-                    p.noResponseCounter++;
-                    break;
-                }
-            }
+            if (Player *p = list.findByNameInsensitive(key))
+                p->noResponseCounter++;
         }
 
         int row = rowForPlayerKey(key);
         if (row >= 0)
+        {
+            // Zähler haben sich geändert: Status/Einsätze neu zeichnen, Eignung ggf. neu prüfen
+            model->playerChanged(row, PlayerTableModel::StatusColumn, PlayerTableModel::TrainingColumn);
             validateRow(row);
+        }
         affected << key;
     }
 
@@ -5770,29 +4848,8 @@ bool MainWindow::playerHasSessionRecord(const QString &playerKey, const QString
     if (playerKey.isEmpty() || !date.isValid())
         return false;
 
-    auto it = attendanceRecords.constFind(playerKey);
-    if (it == attendanceRecords.constEnd())
-        return false;
-
-    const QList<QJsonObject> &records = it.value();
-    for (const QJsonObject &entry : records)
-    {
-        const QString existingType = entry.value("type").toString();
-        if (existingType.compare(type, Qt::CaseInsensitive) != 0)
-            continue;
-
-        const QString existingName = entry.value("name").toString();
-        if (!name.isEmpty() && existingName.compare(name, Qt::CaseInsensitive) != 0)
-            continue;
-
-        const QDate existingDate = QDate::fromString(entry.value("date").toString(), Qt::ISODate);
-        if (!existingDate.isValid())
-            continue;
-
-        if (existingDate == date)
-            return true;
-    }
-    return false;
+    // Vergleich über internierte IDs und Julianische Tage statt Strings
+    return attendanceRecords.hasSession(playerKey, type, name, date);
 }
 
 void MainWindow::updateSessionSummary()
@@ -5845,7 +4902,7 @@ void MainWindow::showCreateLineupDialog()
     for (const Player &p : list.players)
     {
         players << p.name;
-        playerToGroup.insert(p.name, p.group);
+        playerToGroup.insert(p.name, p.group.toString());
     }
     dlg.setPlayerList(players, playerToGroup);
     if (dlg.exec() != QDialog::Accepted)
@@ -5870,9 +4927,14 @@ void MainWindow::showCreateLineupDialog()
 }
 void MainWindow::loadPlayers()
 {
-    list.players.clear();
+    list.clear();
     QFile f(dataFilePath("clan_players.json"));
-    if (f.exists())
+    if (startupSnapshot)
+    {
+        list.players = startupSnapshot->players;
+        list.reindex();
+    }
+    else if (f.exists())
     {
         if (!f.open(QIODevice::ReadOnly))
         {
@@ -5883,7 +4945,9 @@ void MainWindow::loadPlayers()
             QJsonDocument doc = QJsonDocument::fromJson(f.readAll());
             if (doc.isArray())
             {
-                for (const QJsonValue &val : doc.array())
+                const QJsonArray arr = doc.array();
+                list.reserve(arr.size());
+                for (const QJsonValue &val : arr)
                 {
                     if (!val.isObject())
                         continue;
@@ -5904,7 +4968,7 @@ void MainWindow::loadPlayers()
                     p.rank = obj.value("rank").toString();
                     p.lastPromotionDate = QDate::fromString(obj.value("lastPromotion").toString(), Qt::ISODate);
                     p.nextRank = obj.value("nextRank").toString();
-                    list.players.push_back(p);
+                    list.append(p);
                 }
             }
             else
@@ -5922,10 +4986,10 @@ void MainWindow::loadPlayers()
     {
         if (p.group.isEmpty())
             continue;
-        const QString lower = p.group.toLower();
+        const QString lower = p.group.toString().toLower();
         if (knownGroups.contains(lower))
             continue;
-        groups.append(p.group);
+        groups.append(p.group.toString());
         knownGroups.insert(lower);
         addedGroupsFromPlayers = true;
     }
@@ -5940,11 +5004,16 @@ void MainWindow::loadPlayers()
     }
     refreshGroupFilterCombo();
 
+    // Gruppenfarben folgen einmalig in loadDataFiles()
     refreshModelFromList();
-    updateGroupDecorations();
     validateAllRows();
 }
 void MainWindow::savePlayers()
+{
+    persistence.markDirty(PlayersStore);
+}
+
+void MainWindow::writePlayersFile()
 {
     QJsonArray arr;
     for (const Player &p : list.players)
@@ -5953,7 +5022,7 @@ void MainWindow::savePlayers()
         obj.insert("name", p.name);
         obj.insert("t17", p.t17name);
         obj.insert("level", p.level);
-        obj.insert("group", p.group);
+        obj.insert("group", p.group.toString());
         obj.insert("attendance", p.attendance);
         obj.insert("totalAttendance", p.totalAttendance);
         obj.insert("events", p.events);
@@ -5962,9 +5031,9 @@ void MainWindow::savePlayers()
         obj.insert("totalReserve", p.totalReserve);
         obj.insert("comment", p.comment);
         obj.insert("joinDate", p.joinDate.toString(Qt::ISODate));
-        obj.insert("rank", p.rank);
+        obj.insert("rank", p.rank.toString());
         obj.insert("lastPromotion", p.lastPromotionDate.toString(Qt::ISODate));
-        obj.insert("nextRank", p.nextRank);
+        obj.insert("nextRank", p.nextRank.toString());
         arr.append(obj);
     }
     QFile f(dataFilePath("clan_players.json"));
@@ -6005,6 +5074,10 @@ void MainWindow::loadSettings()
     incrementCounterOnNoResponse = obj.value("incrementCounterOnNoResponse").toBool(true);
     resetCounterOnResponse = obj.value("resetCounterOnResponse").toBool(true);
     showCounterInTable = obj.value("showCounterInTable").toBool(true);
+    useBinarySnapshot = obj.value("binarySnapshot").toBool(true);
+    incrementalSearch = obj.value("incrementalSearch").toBool(true);
+    csvFuzzyMerge = obj.value("csvFuzzyMerge").toBool(false);
+    ocrPreprocess = obj.value("ocrPreprocess").toBool(true);
     hintColumnName = obj.value("hintColumnName").toString("Hinweis");
 }
 
@@ -6021,6 +5094,10 @@ void MainWindow::saveSettings()
     obj.insert("incrementCounterOnNoResponse", incrementCounterOnNoResponse);
     obj.insert("resetCounterOnResponse", resetCounterOnResponse);
     obj.insert("showCounterInTable", showCounterInTable);
+    obj.insert("binarySnapshot", useBinarySnapshot);
+    obj.insert("incrementalSearch", incrementalSearch);
+    obj.insert("csvFuzzyMerge", csvFuzzyMerge);
+    obj.insert("ocrPreprocess", ocrPreprocess);
     obj.insert("hintColumnName", hintColumnName);
 
     QFile f(dataFilePath("clan_settings.json"));
@@ -6035,25 +5112,20 @@ void MainWindow::saveSettings()
 
 void MainWindow::applySettingsToUI()
 {
+    if (ocrService)
+    {
+        ocrService->setLanguage(ocrLanguage);
+        ocrService->setPreprocessing(ocrPreprocess);
+    }
+    if (proxy)
+        static_cast<SortProxy *>(proxy)->setIncrementalText(incrementalSearch);
     if (model)
     {
-        model->setHeaderData(1, Qt::Horizontal, hintColumnName);
-        // Aktualisiere Einsätze-Text je nach Anzeige der Klammer
-        for (int row = 0; row < model->rowCount(); ++row)
-        {
-            QString key = playerKeyForRow(row);
-            if (key.isEmpty())
-                continue;
-            const Player *p = findPlayerByKey(key);
-            if (!p)
-                continue;
-            if (QStandardItem *trainingItem = model->item(row, 5))
-            {
-                trainingItem->setText(formatTrainingDisplay(*p));
-                trainingItem->setToolTip(trainingTooltip(*p));
-            }
-            validateRow(row);
-        }
+        model->setHeaderData(PlayerTableModel::StatusColumn, Qt::Horizontal, hintColumnName);
+        // Einsätze-Text (Klammer) und Status (Schwelle) hängen an den Einstellungen
+        model->columnChanged(PlayerTableModel::TrainingColumn);
+        model->columnChanged(PlayerTableModel::StatusColumn);
+        validateAllRows();
     }
 }
 
@@ -6077,6 +5149,7 @@ void MainWindow::loadGroupColors()
 }
 void MainWindow::saveGroupColors()
 {
+    invalidateGroupDecorationCache();
     QJsonObject obj;
     for (auto it = groupColors.constBegin(); it != groupColors.constEnd(); ++it)
     {
@@ -6096,47 +5169,66 @@ void MainWindow::updateGroupDecorations()
         qWarning() << "updateGroupDecorations: model or table is null, skipping";
         return;
     }
-    
-    if (!model)
-        return;
-    for (int row = 0; row < model->rowCount(); ++row)
+
+    // Ein Durchlauf: jede Gruppe genau einmal berechnen, dann die Spalte neu zeichnen
+    invalidateGroupDecorationCache();
+    for (const QString &groupName : std::as_const(groups))
+        groupDecorationCache.insert(groupName, computeGroupDecoration(groupName));
+    for (const Player &p : list.players)
     {
-        QStandardItem *groupItem = model->item(row, 4);
-        if (!groupItem)
-            continue;
-        const QString groupName = groupItem->text();
-        QColor base = colorForGroup(groupName);
-        if (!base.isValid())
-        {
-            groupItem->setBackground(Qt::NoBrush);
-            groupItem->setForeground(QBrush());
-            continue;
-        }
-        QColor bg = base;
-        // Mild normalization so very dark/very light colors are shifted toward middle
-        if (bg.lightness() < 85)
-            bg = bg.lighter(140);
-        else if (bg.lightness() > 235)
-            bg = bg.darker(120);
-
-        auto srgbToLinear = [](double c)
-        {
-            return (c <= 0.04045) ? c / 12.92 : pow((c + 0.055) / 1.055, 2.4);
-        };
-        double r = srgbToLinear(bg.red() / 255.0);
-        double g = srgbToLinear(bg.green() / 255.0);
-        double b = srgbToLinear(bg.blue() / 255.0);
-        // Relative luminance (WCAG)
-        double L = 0.2126 * r + 0.7152 * g + 0.0722 * b;
-        // Contrast ratios with white and black
-        double contrastWhite = (1.0 + 0.05) / (L + 0.05);
-        double contrastBlack = (L + 0.05) / (0.0 + 0.05);
-        QColor fg = (contrastWhite >= contrastBlack) ? Qt::white : Qt::black;
-        groupItem->setBackground(bg);
-        groupItem->setForeground(QBrush(fg));
-    }
-    if (table)
-        table->viewport()->update();
+        if (!groupDecorationCache.contains(p.group.toString()))
+            groupDecorationCache.insert(p.group.toString(), computeGroupDecoration(p.group.toString()));
+    }
+    model->columnChanged(PlayerTableModel::GroupColumn, {Qt::BackgroundRole, Qt::ForegroundRole});
+}
+
+void MainWindow::invalidateGroupDecorationCache()
+{
+    groupDecorationCache.clear();
+}
+
+bool MainWindow::groupBrushes(const QString &groupName, QBrush &background, QBrush &foreground) const
+{
+    auto it = groupDecorationCache.constFind(groupName);
+    if (it == groupDecorationCache.constEnd())
+        it = groupDecorationCache.insert(groupName, computeGroupDecoration(groupName));
+    if (!it->valid)
+        return false;
+    background = it->background;
+    foreground = it->foreground;
+    return true;
+}
+
+MainWindow::GroupDecoration MainWindow::computeGroupDecoration(const QString &groupName) const
+{
+    GroupDecoration decoration;
+    QColor base = colorForGroup(groupName);
+    if (!base.isValid())
+        return decoration;
+    QColor bg = base;
+    // Mild normalization so very dark/very light colors are shifted toward middle
+    if (bg.lightness() < 85)
+        bg = bg.lighter(140);
+    else if (bg.lightness() > 235)
+        bg = bg.darker(120);
+
+    auto srgbToLinear = [](double c)
+    {
+        return (c <= 0.04045) ? c / 12.92 : pow((c + 0.055) / 1.055, 2.4);
+    };
+    double r = srgbToLinear(bg.red() / 255.0);
+    double g = srgbToLinear(bg.green() / 255.0);
+    double b = srgbToLinear(bg.blue() / 255.0);
+    // Relative luminance (WCAG)
+    double L = 0.2126 * r + 0.7152 * g + 0.0722 * b;
+    // Contrast ratios with white and black
+    double contrastWhite = (1.0 + 0.05) / (L + 0.05);
+    double contrastBlack = (L + 0.05) / (0.0 + 0.05);
+    QColor fg = (contrastWhite >= contrastBlack) ? Qt::white : Qt::black;
+    decoration.background = QBrush(bg);
+    decoration.foreground = QBrush(fg);
+    decoration.valid = true;
+    return decoration;
 }
 
 QColor MainWindow::colorForGroup(const QString &groupName) const
@@ -6190,44 +5282,49 @@ void MainWindow::applySortSettings()
 }
 void MainWindow::loadAttendance()
 {
-    attendanceRecords.clear();
-    QFile f(dataFilePath("clan_attendance_log.json"));
-    if (!f.exists())
-        return;
-    if (!f.open(QIODevice::ReadOnly))
-        return;
-    QJsonDocument doc = QJsonDocument::fromJson(f.readAll());
-    if (!doc.isObject())
-        return;
-    QJsonObject root = doc.object();
-    for (auto it = root.begin(); it != root.end(); ++it)
+    if (startupSnapshot)
     {
-        if (!it.value().isArray())
-            continue;
-        QList<QJsonObject> entries;
-        for (const QJsonValue &val : it.value().toArray())
-        {
-            if (val.isObject())
-                entries.append(val.toObject());
-        }
-        attendanceRecords.insert(it.key(), entries);
+        attendanceRecords = startupSnapshot->attendance;
+        attendanceJournal.restore(startupSnapshot->attendanceNextSeq, startupSnapshot->attendanceJournalLines);
+        return;
     }
+    // Snapshot plus Journal; ein langes Journal wird gleich wieder eingefaltet
+    if (!attendanceJournal.load(attendanceRecords))
+        appendErrorLog("loadAttendance", QStringLiteral("Datei konnte nicht geöffnet werden: %1").arg(attendanceJournal.errorString()));
+    if (attendanceJournal.droppedLineCount() > 0)
+        appendErrorLog("loadAttendance", QStringLiteral("%1 unvollständige Journalzeile(n) verworfen").arg(attendanceJournal.droppedLineCount()));
+    if (attendanceJournal.needsCompaction())
+        saveAttendance();
 }
-void MainWindow::saveAttendance()
+bool MainWindow::writeDataSnapshot()
 {
-    QJsonObject root;
-    for (auto it = attendanceRecords.constBegin(); it != attendanceRecords.constEnd(); ++it)
-    {
-        QJsonArray arr;
-        for (const QJsonObject &obj : it.value())
-            arr.append(obj);
-        root.insert(it.key(), arr);
+    // Erst alle offenen JSON-Schreibvorgänge, damit die Zeitstempel passen
+    persistence.flushAll();
+    if (!useBinarySnapshot)
+        return dataSnapshot.remove();
+
+    DataSnapshot::Contents contents;
+    contents.players = list.players;
+    contents.attendance = attendanceRecords;
+    contents.attendanceNextSeq = attendanceJournal.nextSequence();
+    contents.attendanceJournalLines = attendanceJournal.journalLength();
+    contents.trainings = trainings;
+    if (!dataSnapshot.write(contents))
+    {
+        appendErrorLog("writeDataSnapshot", QStringLiteral("Snapshot konnte nicht geschrieben werden: %1").arg(dataSnapshot.errorString()));
+        return false;
     }
-    QFile f(dataFilePath("clan_attendance_log.json"));
-    if (!f.open(QIODevice::WriteOnly))
-        return;
-    QJsonDocument doc(root);
-    f.write(doc.toJson(QJsonDocument::Indented));
+    return true;
+}
+void MainWindow::saveAttendance()
+{
+    persistence.markDirty(AttendanceStore);
+}
+void MainWindow::writeAttendanceFile()
+{
+    // Vollständiger Snapshot nur bei Löschungen/Umbauten oder zur Kompaktierung
+    if (!attendanceJournal.compact(attendanceRecords))
+        appendErrorLog("saveAttendance", QStringLiteral("Datei konnte nicht geschrieben werden: %1").arg(attendanceJournal.errorString()));
 }
 void MainWindow::recordAttendance() {}
 void MainWindow::appendAttendanceLog(const QString &playerKey, const QString &type, const QDateTime &when, const QString &trainingId, const QString &map)
@@ -6242,8 +5339,10 @@ void MainWindow::appendAttendanceLog(const QString &playerKey, const QString &ty
         entry.insert("name", trainingId);
     if (!map.isEmpty())
         entry.insert("map", map);
-    attendanceRecords[playerKey].append(entry);
-    saveAttendance();
+    attendanceRecords.append(playerKey, entry);
+    // Eine Journalzeile statt kompletter Neuschrift; bei Fehlern Snapshot schreiben
+    if (!attendanceJournal.append(playerKey, entry) || attendanceJournal.needsCompaction())
+        saveAttendance();
 }
 void MainWindow::appendSoldbuchEntry(const QString &playerKey, const QString &kind, const QJsonObject &data, const QDateTime &when)
 {
@@ -6253,49 +5352,14 @@ void MainWindow::appendSoldbuchEntry(const QString &playerKey, const QString &ki
     entry.insert("kind", kind);
     entry.insert("date", when.date().toString(Qt::ISODate));
     entry.insert("timestamp", when.toString(Qt::ISODate));
-    soldbuchRecords[playerKey].append(entry);
-    saveSoldbuch();
+    if (!soldbuchLog.append(playerKey, entry))
+        appendErrorLog("appendSoldbuchEntry", QStringLiteral("Eintrag konnte nicht geschrieben werden: %1").arg(soldbuchLog.errorString()));
 }
 void MainWindow::loadSoldbuch()
 {
-    soldbuchRecords.clear();
-    QFile f(dataFilePath("clan_soldbuch_log.json"));
-    if (!f.exists())
-        return;
-    if (!f.open(QIODevice::ReadOnly))
-        return;
-    QJsonDocument doc = QJsonDocument::fromJson(f.readAll());
-    if (!doc.isObject())
-        return;
-    QJsonObject root = doc.object();
-    for (auto it = root.begin(); it != root.end(); ++it)
-    {
-        if (!it.value().isArray())
-            continue;
-        QList<QJsonObject> entries;
-        for (const QJsonValue &val : it.value().toArray())
-        {
-            if (val.isObject())
-                entries.append(val.toObject());
-        }
-        soldbuchRecords.insert(it.key(), entries);
-    }
-}
-void MainWindow::saveSoldbuch()
-{
-    QJsonObject root;
-    for (auto it = soldbuchRecords.constBegin(); it != soldbuchRecords.constEnd(); ++it)
-    {
-        QJsonArray arr;
-        for (const QJsonObject &obj : it.value())
-            arr.append(obj);
-        root.insert(it.key(), arr);
-    }
-    QFile f(dataFilePath("clan_soldbuch_log.json"));
-    if (!f.open(QIODevice::WriteOnly))
-        return;
-    QJsonDocument doc(root);
-    f.write(doc.toJson(QJsonDocument::Indented));
+    // Liest nur den Offset-Index, Einträge folgen bei Bedarf
+    if (!soldbuchLog.open())
+        appendErrorLog("loadSoldbuch", QStringLiteral("Soldbuch konnte nicht geöffnet werden: %1").arg(soldbuchLog.errorString()));
 }
 void MainWindow::saveAttendancePercentToSoldbuch(const QString &playerKey, int percent, const QDateTime &when)
 {
@@ -6306,8 +5370,17 @@ void MainWindow::saveAttendancePercentToSoldbuch(const QString &playerKey, int p
     appendSoldbuchEntry(playerKey, "attendance-percent", payload, when);
 }
 
-void MainWindow::updateEligibilityForRow(int sourceRow) { Q_UNUSED(sourceRow); }
-void MainWindow::updateEligibilityForPlayerKey(const QString &playerKey) { Q_UNUSED(playerKey); }
+void MainWindow::updateEligibilityForRow(int sourceRow)
+{
+    eligibility.markDirty(playerKeyForRow(sourceRow));
+    validateRow(sourceRow);
+}
+void MainWindow::updateEligibilityForPlayerKey(const QString &playerKey)
+{
+    int row = rowForPlayerKey(playerKey);
+    if (row >= 0)
+        updateEligibilityForRow(row);
+}
 void MainWindow::updateAttendancePercentForPlayerKey(const QString &playerKey) { Q_UNUSED(playerKey); }
 void MainWindow::showPromotionDialogForRow(int sourceRow) { Q_UNUSED(sourceRow); }
 void MainWindow::promotePlayerAtRow(int sourceRow) { Q_UNUSED(sourceRow); }
@@ -6318,7 +5391,7 @@ void MainWindow::promotePlayerByKey(const QString &playerKey)
     if (!player)
         return;
     const QStringList ranks = MainWindow::rankOptions();
-    int idx = ranks.indexOf(player->rank);
+    int idx = ranks.indexOf(player->rank.toString());
     if (idx < 0 || idx + 1 >= ranks.size())
     {
         QMessageBox::information(this, "Beförderung", "Kein höherer Rang verfügbar.");
@@ -6328,7 +5401,7 @@ void MainWindow::promotePlayerByKey(const QString &playerKey)
     QString targetRank = ranks.at(idx + 1);
     QString question = QStringLiteral("%1 von %2 zu %3 befördern?")
                            .arg(player->name.isEmpty() ? playerKey : player->name)
-                           .arg(player->rank.isEmpty() ? QStringLiteral("-") : player->rank)
+                           .arg(player->rank.isEmpty() ? QStringLiteral("-") : player->rank.toString())
                            .arg(targetRank);
     if (QMessageBox::question(this, "Beförderung bestätigen", question, QMessageBox::Yes | QMessageBox::No, QMessageBox::No) != QMessageBox::Yes)
         return;
@@ -6342,18 +5415,7 @@ void MainWindow::promotePlayerByKey(const QString &playerKey)
 
     int row = rowForPlayerKey(playerKey);
     if (row >= 0)
-    {
-        if (QStandardItem *rankItem = model->item(row, 8))
-        {
-            rankItem->setData(player->rank, Qt::EditRole);
-            rankItem->setData(formatRankDisplay(*player, true), Qt::DisplayRole);
-        }
-        if (QStandardItem *trainingItem = model->item(row, 5))
-        {
-            trainingItem->setText(formatTrainingDisplay(*player));
-            trainingItem->setToolTip(trainingTooltip(*player));
-        }
-    }
+        model->playerChanged(row, PlayerTableModel::TrainingColumn, PlayerTableModel::RankColumn);
 
     savePlayers();
     if (row >= 0)
@@ -6365,7 +5427,7 @@ void MainWindow::demotePlayerByKey(const QString &playerKey)
     if (!player)
         return;
     const QStringList ranks = MainWindow::rankOptions();
-    int idx = ranks.indexOf(player->rank);
+    int idx = ranks.indexOf(player->rank.toString());
     if (idx <= 0)
     {
         QMessageBox::information(this, "Degradierung", "Kein niedrigerer Rang vorhanden.");
@@ -6374,7 +5436,7 @@ void MainWindow::demotePlayerByKey(const QString &playerKey)
     QString targetRank = ranks.at(idx - 1);
     QString question = QStringLiteral("%1 von %2 zu %3 degradieren?")
                            .arg(player->name.isEmpty() ? playerKey : player->name)
-                           .arg(player->rank.isEmpty() ? QStringLiteral("-") : player->rank)
+                           .arg(player->rank.isEmpty() ? QStringLiteral("-") : player->rank.toString())
                            .arg(targetRank);
     if (QMessageBox::question(this, "Degradierung bestätigen", question, QMessageBox::Yes | QMessageBox::No, QMessageBox::No) != QMessageBox::Yes)
         return;
@@ -6383,13 +5445,7 @@ void MainWindow::demotePlayerByKey(const QString &playerKey)
     player->nextRank = ranks.at(idx);
     int row = rowForPlayerKey(playerKey);
     if (row >= 0)
-    {
-        if (QStandardItem *rankItem = model->item(row, 8))
-        {
-            rankItem->setData(player->rank, Qt::EditRole);
-            rankItem->setData(formatRankDisplay(*player, false), Qt::DisplayRole);
-        }
-    }
+        model->playerChanged(row, PlayerTableModel::RankColumn, PlayerTableModel::RankColumn);
     savePlayers();
     if (row >= 0)
         validateRow(row);
@@ -6621,14 +5677,8 @@ void MainWindow::refreshSessionPlayerLists()
         case ResponseStatus::NoResponse:
         {
             int cnt = 0;
-            for (const Player &p : list.players)
-            {
-                if (p.name == playerName)
-                {
-                    cnt = p.noResponseCounter;
-                    break;
-                }
-            }
+            if (const Player *p = list.findByName(playerName))
+                cnt = p->noResponseCounter;
             sessionNoResponseList->addItem(QStringLiteral("%1 (NR: %2)").arg(playerName).arg(cnt));
         }
         break;
@@ -6684,7 +5734,7 @@ void MainWindow::addPlayerToSession()
     // Spieler als Kinder mit Checkboxen
     for (const Player &p : list.players)
     {
-        QString grp = p.group.isEmpty() ? unassignedGroupName : p.group;
+        QString grp = p.group.isEmpty() ? unassignedGroupName : p.group.toString();
         QTreeWidgetItem *parent = groupItems.value(grp, groupItems.value(unassignedGroupName));
         auto *pitem = new QTreeWidgetItem(QStringList{p.name});
         pitem->setFlags(pitem->flags() | Qt::ItemIsUserCheckable);
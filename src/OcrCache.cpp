@@ -0,0 +1,217 @@
+#include "OcrCache.h"
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+OcrCache::OcrCache(const QString &directory, qint64 maxBytes)
+    : m_dir(directory), m_maxBytes(maxBytes)
+{
+}
+
+QString OcrCache::defaultDirectory()
+{
+    QString dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    if (dir.isEmpty())
+        dir = QDir::homePath() + "/.clanmanager";
+    return dir + "/ocr-cache";
+}
+
+QByteArray OcrCache::imageHash(const QString &imagePath)
+{
+    QFile file(imagePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return QByteArray();
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    if (!hash.addData(&file))
+        return QByteArray();
+    return hash.result();
+}
+
+QString OcrCache::key(const QByteArray &imageHash, const QString &language, const QString &engineVersion)
+{
+    // Sprache und Version können beliebige Zeichen enthalten: mit hashen
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(imageHash);
+    hash.addData(QByteArray(1, '\0'));
+    hash.addData(language.toUtf8());
+    hash.addData(QByteArray(1, '\0'));
+    hash.addData(engineVersion.toUtf8());
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+QString OcrCache::filePath(const QString &key) const
+{
+    return m_dir + "/" + key + ".ocr";
+}
+
+qint64 OcrCache::nextStampLocked()
+{
+    m_lastStamp = qMax(m_lastStamp + 1, QDateTime::currentMSecsSinceEpoch());
+    return m_lastStamp;
+}
+
+void OcrCache::loadIndexLocked() const
+{
+    if (m_indexed)
+        return;
+    m_indexed = true;
+    // Zuletzt benutzt = Änderungszeit der Datei, bei Treffern neu gesetzt
+    const QFileInfoList files = QDir(m_dir).entryInfoList({QStringLiteral("*.ocr")}, QDir::Files);
+    for (const QFileInfo &info : files)
+    {
+        Item item;
+        item.size = info.size();
+        item.lastUsed = info.lastModified().toMSecsSinceEpoch();
+        m_items.insert(info.completeBaseName(), item);
+        m_totalBytes += item.size;
+        m_lastStamp = qMax(m_lastStamp, item.lastUsed);
+    }
+}
+
+void OcrCache::evictLocked()
+{
+    while (m_totalBytes > m_maxBytes && !m_items.isEmpty())
+    {
+        auto oldest = m_items.begin();
+        for (auto it = m_items.begin(); it != m_items.end(); ++it)
+        {
+            if (it->lastUsed < oldest->lastUsed)
+                oldest = it;
+        }
+        QFile::remove(filePath(oldest.key()));
+        m_totalBytes -= oldest->size;
+        m_items.erase(oldest);
+    }
+}
+
+bool OcrCache::lookup(const QString &key, OcrResult &result)
+{
+    QMutexLocker lock(&m_mutex);
+    loadIndexLocked();
+    auto item = m_items.find(key);
+    if (item == m_items.end())
+        return false;
+
+    QFile file(filePath(key));
+    bool ok = file.open(QIODevice::ReadOnly);
+    OcrResult cached;
+    if (ok)
+    {
+        QDataStream in(&file);
+        in.setVersion(QDataStream::Qt_6_0);
+        quint32 magic = 0, version = 0;
+        in >> magic >> version;
+        ok = magic == Magic && version == Version;
+        if (ok)
+        {
+            RosterTextParser::Result &roster = cached.roster;
+            QList<qint32> kinds;
+            in >> cached.text >> cached.lines >> cached.confidence;
+            in >> roster.eventName >> roster.date >> roster.map >> roster.training >> roster.accepted >> roster.rejected
+               >> roster.candidates >> kinds;
+            ok = in.status() == QDataStream::Ok && cached.lines.size() == cached.confidence.size()
+                 && kinds.size() == cached.lines.size();
+            for (const qint32 kind : std::as_const(kinds))
+            {
+                ok = ok && kind >= RosterTextParser::Preamble && kind <= RosterTextParser::Noise;
+                roster.kinds << RosterTextParser::LineKind(kind);
+            }
+        }
+        file.close();
+    }
+    if (!ok)
+    {
+        // Beschädigt oder fremde Version: verwerfen, neu erkennen
+        QFile::remove(filePath(key));
+        m_totalBytes -= item->size;
+        m_items.erase(item);
+        return false;
+    }
+
+    // Zugriffszeit auch auf der Platte festhalten, für den nächsten Start
+    item->lastUsed = nextStampLocked();
+    if (file.open(QIODevice::ReadWrite))
+        file.setFileTime(QDateTime::fromMSecsSinceEpoch(item->lastUsed), QFileDevice::FileModificationTime);
+    cached.job = result.job;
+    cached.imagePath = result.imagePath;
+    cached.fromCache = true;
+    result = cached;
+    return true;
+}
+
+bool OcrCache::store(const QString &key, const OcrResult &result)
+{
+    if (!result.ok())
+        return false;
+    QMutexLocker lock(&m_mutex);
+    loadIndexLocked();
+    if (!QDir().mkpath(m_dir))
+        return false;
+
+    QSaveFile file(filePath(key));
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << Magic << Version;
+    const RosterTextParser::Result &roster = result.roster;
+    QList<qint32> kinds;
+    for (const RosterTextParser::LineKind kind : roster.kinds)
+        kinds << kind;
+    out << result.text << result.lines << result.confidence;
+    out << roster.eventName << roster.date << roster.map << roster.training << roster.accepted << roster.rejected
+        << roster.candidates << kinds;
+    if (out.status() != QDataStream::Ok || !file.commit())
+        return false;
+
+    const qint64 size = QFileInfo(filePath(key)).size();
+    Item &item = m_items[key];
+    m_totalBytes += size - item.size;
+    item.size = size;
+    item.lastUsed = nextStampLocked();
+    evictLocked();
+    return true;
+}
+
+void OcrCache::clear()
+{
+    QMutexLocker lock(&m_mutex);
+    loadIndexLocked();
+    for (auto it = m_items.cbegin(); it != m_items.cend(); ++it)
+        QFile::remove(filePath(it.key()));
+    m_items.clear();
+    m_totalBytes = 0;
+}
+
+void OcrCache::setMaxBytes(qint64 maxBytes)
+{
+    QMutexLocker lock(&m_mutex);
+    m_maxBytes = maxBytes;
+    loadIndexLocked();
+    evictLocked();
+}
+
+qint64 OcrCache::maxBytes() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_maxBytes;
+}
+
+qint64 OcrCache::sizeBytes() const
+{
+    QMutexLocker lock(&m_mutex);
+    loadIndexLocked();
+    return m_totalBytes;
+}
+
+int OcrCache::count() const
+{
+    QMutexLocker lock(&m_mutex);
+    loadIndexLocked();
+    return int(m_items.size());
+}
@@ -0,0 +1,338 @@
+#include "OcrPreprocessor.h"
+#include <QtAlgorithms>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CLANMANAGER_OCR_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define CLANMANAGER_OCR_NEON
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+    // Helligkeitssprung, ab dem ein Pixelpaar als Schriftkante zählt
+    constexpr quint8 EdgeDelta = 40;
+
+    struct Run
+    {
+        int begin = 0;
+        int end = 0; // exklusiv
+        qint64 weight = 0;
+    };
+
+    // Zusammenhängende Bereiche mit profile >= minValue; Lücken bis maxGap
+    // werden überbrückt
+    std::vector<Run> runsOf(const std::vector<int> &profile, int minValue, int maxGap)
+    {
+        std::vector<Run> runs;
+        int gap = 0;
+        for (int i = 0; i < int(profile.size()); ++i)
+        {
+            if (profile[i] < minValue)
+            {
+                ++gap;
+                continue;
+            }
+            if (runs.empty() || gap > maxGap)
+                runs.push_back({i, i + 1, 0});
+            runs.back().end = i + 1;
+            runs.back().weight += profile[i];
+            gap = 0;
+        }
+        return runs;
+    }
+}
+
+namespace OcrPreprocessor
+{
+    void toGray(const quint32 *argb, quint8 *gray, int count)
+    {
+        int i = 0;
+#if defined(CLANMANAGER_OCR_SSE2)
+        // 8 Pixel pro Schritt: Kanäle in 16-Bit-Lanes, Summe passt in 16 Bit
+        const __m128i low = _mm_set1_epi32(0xff);
+        const __m128i wr = _mm_set1_epi16(77);
+        const __m128i wg = _mm_set1_epi16(150);
+        const __m128i wb = _mm_set1_epi16(29);
+        const __m128i round = _mm_set1_epi16(128);
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m128i p0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(argb + i));
+            const __m128i p1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(argb + i + 4));
+            const __m128i b = _mm_packs_epi32(_mm_and_si128(p0, low), _mm_and_si128(p1, low));
+            const __m128i g = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(p0, 8), low), _mm_and_si128(_mm_srli_epi32(p1, 8), low));
+            const __m128i r = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(p0, 16), low), _mm_and_si128(_mm_srli_epi32(p1, 16), low));
+            __m128i y = _mm_add_epi16(_mm_mullo_epi16(r, wr), _mm_mullo_epi16(g, wg));
+            y = _mm_add_epi16(y, _mm_add_epi16(_mm_mullo_epi16(b, wb), round));
+            y = _mm_srli_epi16(y, 8);
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(gray + i), _mm_packus_epi16(y, y));
+        }
+#elif defined(CLANMANAGER_OCR_NEON)
+        // vld4 trennt die Bytes B, G, R, A von 8 Pixeln
+        for (; i + 8 <= count; i += 8)
+        {
+            const uint8x8x4_t p = vld4_u8(reinterpret_cast<const uint8_t *>(argb + i));
+            uint16x8_t y = vmull_u8(p.val[2], vdup_n_u8(77));
+            y = vmlal_u8(y, p.val[1], vdup_n_u8(150));
+            y = vmlal_u8(y, p.val[0], vdup_n_u8(29));
+            vst1_u8(gray + i, vrshrn_n_u16(y, 8));
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            const quint32 p = argb[i];
+            gray[i] = quint8((77 * ((p >> 16) & 0xff) + 150 * ((p >> 8) & 0xff) + 29 * (p & 0xff) + 128) >> 8);
+        }
+    }
+
+    void threshold(const quint8 *src, quint8 *dst, int count, quint8 level, bool invert)
+    {
+        int i = 0;
+#if defined(CLANMANAGER_OCR_SSE2)
+        // Vorzeichenloses v > level als max(v, level + 1) == v
+        if (level < 255)
+        {
+            const __m128i above = _mm_set1_epi8(char(level + 1));
+            const __m128i flip = invert ? _mm_set1_epi8(char(0xff)) : _mm_setzero_si128();
+            for (; i + 16 <= count; i += 16)
+            {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+                const __m128i bright = _mm_cmpeq_epi8(_mm_max_epu8(v, above), v);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_xor_si128(bright, flip));
+            }
+        }
+#elif defined(CLANMANAGER_OCR_NEON)
+        const uint8x16_t lv = vdupq_n_u8(level);
+        const uint8x16_t flip = vdupq_n_u8(invert ? 0xff : 0);
+        for (; i + 16 <= count; i += 16)
+            vst1q_u8(dst + i, veorq_u8(vcgtq_u8(vld1q_u8(src + i), lv), flip));
+#endif
+        const quint8 on = invert ? 0 : 255;
+        for (; i < count; ++i)
+            dst[i] = src[i] > level ? on : quint8(255 - on);
+    }
+
+    int edgeMask(const quint8 *row, quint8 *mask, int width, quint8 minDelta)
+    {
+        if (width <= 0)
+            return 0;
+        // Paare (x, x + 1) für x < last
+        const int last = width - 1;
+        int count = 0;
+        int x = 0;
+#if defined(CLANMANAGER_OCR_SSE2)
+        const __m128i delta = _mm_set1_epi8(char(minDelta));
+        const __m128i one = _mm_set1_epi8(1);
+        const __m128i zero = _mm_setzero_si128();
+        for (; x + 16 <= last; x += 16)
+        {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + x));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + x + 1));
+            const __m128i diff = _mm_or_si128(_mm_subs_epu8(a, b), _mm_subs_epu8(b, a));
+            // diff > minDelta, genau wenn diff - minDelta (gesättigt) nicht 0 ist
+            const __m128i flat = _mm_cmpeq_epi8(_mm_subs_epu8(diff, delta), zero);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(mask + x), _mm_andnot_si128(flat, one));
+            count += qPopulationCount(quint32(~_mm_movemask_epi8(flat) & 0xffff));
+        }
+#elif defined(CLANMANAGER_OCR_NEON)
+        const uint8x16_t delta = vdupq_n_u8(minDelta);
+        const uint8x16_t one = vdupq_n_u8(1);
+        for (; x + 16 <= last; x += 16)
+        {
+            const uint8x16_t diff = vabdq_u8(vld1q_u8(row + x), vld1q_u8(row + x + 1));
+            const uint8x16_t edge = vandq_u8(vcgtq_u8(diff, delta), one);
+            vst1q_u8(mask + x, edge);
+            count += vaddvq_u8(edge);
+        }
+#endif
+        for (; x < last; ++x)
+        {
+            mask[x] = std::abs(int(row[x + 1]) - int(row[x])) > minDelta ? 1 : 0;
+            count += mask[x];
+        }
+        mask[last] = 0;
+        return count;
+    }
+
+    void histogram(const quint8 *src, int count, quint32 *hist)
+    {
+        // Vier Teilhistogramme: gleiche Nachbarwerte (Hintergrund) warten
+        // sonst aufeinander, weil sie denselben Zähler erhöhen
+        quint32 sub[4][256] = {};
+        int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            ++sub[0][src[i]];
+            ++sub[1][src[i + 1]];
+            ++sub[2][src[i + 2]];
+            ++sub[3][src[i + 3]];
+        }
+        for (; i < count; ++i)
+            ++sub[0][src[i]];
+        for (int v = 0; v < 256; ++v)
+            hist[v] += sub[0][v] + sub[1][v] + sub[2][v] + sub[3][v];
+    }
+
+    int otsuThreshold(const quint32 *hist)
+    {
+        double total = 0;
+        double sum = 0;
+        for (int v = 0; v < 256; ++v)
+        {
+            total += hist[v];
+            sum += double(v) * hist[v];
+        }
+        if (total == 0)
+            return 127;
+        // Schwelle mit der größten Varianz zwischen den beiden Klassen
+        double weightBelow = 0;
+        double sumBelow = 0;
+        double best = -1;
+        int level = 0;
+        for (int t = 0; t < 256; ++t)
+        {
+            weightBelow += hist[t];
+            if (weightBelow == 0)
+                continue;
+            const double weightAbove = total - weightBelow;
+            if (weightAbove == 0)
+                break;
+            sumBelow += double(t) * hist[t];
+            const double meanBelow = sumBelow / weightBelow;
+            const double meanAbove = (sum - sumBelow) / weightAbove;
+            const double between = weightBelow * weightAbove * (meanBelow - meanAbove) * (meanBelow - meanAbove);
+            if (between > best)
+            {
+                best = between;
+                level = t;
+            }
+        }
+        return level;
+    }
+
+    Result process(const QImage &source, const Options &options)
+    {
+        Result result;
+        if (source.isNull())
+            return result;
+        const QImage rgb = source.convertToFormat(QImage::Format_RGB32);
+        const int width = rgb.width();
+        const int height = rgb.height();
+        QImage gray(width, height, QImage::Format_Grayscale8);
+        for (int y = 0; y < height; ++y)
+            toGray(reinterpret_cast<const quint32 *>(rgb.constScanLine(y)), gray.scanLine(y), width);
+        result.region = gray.rect();
+
+        // Kantenprofil: Spalten nur aus Zeilen, in denen Schrift vorkommt
+        std::vector<quint8> mask(width);
+        std::vector<int> rowEdges(height);
+        std::vector<int> colEdges(width);
+        int minRowEdges = qMax(2, width / 200);
+        int textRows = 0;
+        for (int y = 0; y < height; ++y)
+        {
+            rowEdges[y] = edgeMask(gray.constScanLine(y), mask.data(), width, EdgeDelta);
+            if (rowEdges[y] < minRowEdges)
+                continue;
+            ++textRows;
+            for (int x = 0; x < width; ++x)
+                colEdges[x] += mask[x];
+        }
+
+        if (options.crop && textRows > 0)
+        {
+            // Dichtester Spaltenblock ist die Liste; Seitenleisten liegen
+            // durch eine breitere Lücke getrennt daneben
+            const std::vector<Run> columns = runsOf(colEdges, qMax(2, textRows / 50), qMax(8, width / 40));
+            if (!columns.empty())
+            {
+                const Run list = *std::max_element(columns.begin(), columns.end(), [](const Run &a, const Run &b)
+                                                   { return a.weight < b.weight; });
+                // Zeilen neu im gewählten Spaltenblock zählen
+                const int listWidth = list.end - list.begin;
+                minRowEdges = qMax(2, listWidth / 200);
+                int top = -1;
+                int bottom = -1;
+                for (int y = 0; y < height; ++y)
+                {
+                    rowEdges[y] = edgeMask(gray.constScanLine(y) + list.begin, mask.data(), listWidth, EdgeDelta);
+                    if (rowEdges[y] < minRowEdges)
+                        continue;
+                    if (top < 0)
+                        top = y;
+                    bottom = y;
+                }
+                if (top >= 0)
+                {
+                    const int margin = 8;
+                    result.region = QRect(QPoint(list.begin - margin, top - margin), QPoint(list.end - 1 + margin, bottom + margin))
+                                        .intersected(gray.rect());
+                }
+            }
+        }
+
+        // Zeilenhöhe: Median der Läufe zusammenhängender Schriftzeilen
+        std::vector<int> heights;
+        int runLength = 0;
+        for (int y = result.region.top(); y <= result.region.bottom() + 1; ++y)
+        {
+            if (y <= result.region.bottom() && rowEdges[y] >= minRowEdges)
+            {
+                ++runLength;
+                continue;
+            }
+            if (runLength >= 3)
+                heights.push_back(runLength);
+            runLength = 0;
+        }
+        if (!heights.empty())
+        {
+            std::nth_element(heights.begin(), heights.begin() + heights.size() / 2, heights.end());
+            result.textHeight = heights[heights.size() / 2];
+        }
+
+        QImage work = result.region == gray.rect() ? gray : gray.copy(result.region);
+        quint32 hist[256] = {};
+        if (options.binarize)
+        {
+            for (int y = 0; y < work.height(); ++y)
+                histogram(work.constScanLine(y), work.width(), hist);
+        }
+
+        if (result.textHeight > 0 && result.textHeight < options.minTextHeight)
+        {
+            result.scale = qMin(double(options.maxScale), double(options.targetTextHeight) / result.textHeight);
+            work = work.scaled(qRound(work.width() * result.scale), qRound(work.height() * result.scale),
+                               Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+            if (work.format() != QImage::Format_Grayscale8)
+                work = work.convertToFormat(QImage::Format_Grayscale8);
+        }
+
+        if (options.binarize)
+        {
+            result.threshold = otsuThreshold(hist);
+            // Überwiegend dunkler Grund (dunkles Design): umdrehen, damit
+            // Tesseract dunkle Schrift auf hellem Grund bekommt
+            quint64 bright = 0;
+            quint64 total = 0;
+            for (int v = 0; v < 256; ++v)
+            {
+                total += hist[v];
+                if (v > result.threshold)
+                    bright += hist[v];
+            }
+            result.inverted = bright * 2 < total;
+            for (int y = 0; y < work.height(); ++y)
+            {
+                quint8 *line = work.scanLine(y);
+                threshold(line, line, work.width(), quint8(result.threshold), result.inverted);
+            }
+        }
+        result.image = work;
+        return result;
+    }
+}
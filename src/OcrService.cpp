@@ -0,0 +1,685 @@
+#include "OcrService.h"
+#include "OcrCache.h"
+#include "OcrPreprocessor.h"
+#include "PlayerList.h"
+#include "RosterTextParser.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QImage>
+#include <QMutex>
+#include <QProcess>
+#include <QProcessEnvironment>
+#include <QPromise>
+#include <QRegularExpression>
+#include <QSet>
+#include <QTemporaryFile>
+#include <QThread>
+#include <QtConcurrent/QtConcurrentRun>
+#include <vector>
+
+#ifdef CLANMANAGER_HAVE_TESSERACT
+#include <tesseract/baseapi.h>
+#include <tesseract/ocrclass.h>
+#include <tesseract/resultiterator.h>
+#endif
+
+// Zustand einer Engine; gehört immer genau einem laufenden Auftrag
+struct OcrEngine
+{
+#ifdef CLANMANAGER_HAVE_TESSERACT
+    tesseract::TessBaseAPI api;
+    QString apiLanguage; // leer = api nicht initialisiert
+#endif
+};
+
+// Vorrat freier Engines, von allen Worker-Threads geteilt
+struct OcrEnginePool
+{
+    QMutex mutex;
+    std::vector<std::unique_ptr<OcrEngine>> idle;
+    QString languagesProgram; // für welches Programm languages und version gelten
+    QStringList languages;    // installierte Sprachdaten laut --list-langs
+    QString version;          // erste Zeile von --version, Teil des Cache-Schlüssels
+
+    std::unique_ptr<OcrEngine> acquire()
+    {
+        QMutexLocker lock(&mutex);
+        if (idle.empty())
+            return std::make_unique<OcrEngine>();
+        std::unique_ptr<OcrEngine> engine = std::move(idle.back());
+        idle.pop_back();
+        return engine;
+    }
+
+    void release(std::unique_ptr<OcrEngine> engine)
+    {
+        QMutexLocker lock(&mutex);
+        idle.push_back(std::move(engine));
+    }
+};
+
+namespace
+{
+    void finishText(OcrResult &result, const QString &text)
+    {
+        result.text = text;
+        for (const QString &line : text.split(QRegularExpression(QStringLiteral("[\\r\\n]+")), Qt::SkipEmptyParts))
+        {
+            const QString trimmed = line.trimmed();
+            if (!trimmed.isEmpty())
+            {
+                result.lines << trimmed;
+                result.confidence << -1;
+            }
+        }
+    }
+
+    void finishLines(OcrResult &result, const QStringList &lines, const QList<int> &confidence)
+    {
+        for (int i = 0; i < lines.size(); ++i)
+        {
+            const QString trimmed = lines.at(i).trimmed();
+            if (trimmed.isEmpty())
+                continue;
+            result.lines << trimmed;
+            result.confidence << confidence.value(i, -1);
+        }
+        result.text = result.lines.join('\n');
+    }
+
+    // TSV-Ausgabe: eine Zeile pro Wort mit Konfidenz; Wörter derselben
+    // Textzeile (Seite, Block, Absatz, Zeile) werden wieder zusammengesetzt.
+    // Ohne TSV-Kopf (alte Versionen) als reiner Text behandeln.
+    void finishTsv(OcrResult &result, const QString &output)
+    {
+        const QStringList rows = output.split('\n');
+        if (rows.isEmpty() || !rows.first().startsWith(QStringLiteral("level\t")))
+        {
+            finishText(result, output);
+            return;
+        }
+        QStringList lines;
+        QList<int> confidence;
+        QList<int> wordCounts;
+        QString lastLineKey;
+        for (int r = 1; r < rows.size(); ++r)
+        {
+            const QStringList cols = rows.at(r).split('\t');
+            if (cols.size() < 12 || cols.at(0) != QLatin1String("5"))
+                continue;
+            const QString word = cols.at(11).trimmed();
+            const double conf = cols.at(10).toDouble();
+            if (word.isEmpty() || conf < 0)
+                continue;
+            const QString lineKey = QStringLiteral("%1/%2/%3/%4").arg(cols.at(1), cols.at(2), cols.at(3), cols.at(4));
+            if (lineKey != lastLineKey)
+            {
+                lastLineKey = lineKey;
+                lines << word;
+                confidence << 0;
+                wordCounts << 0;
+            }
+            else
+            {
+                lines.last() += QLatin1Char(' ') + word;
+            }
+            // Summe der Wortkonfidenzen, unten zum Mittel der Zeile geteilt
+            confidence.last() += qRound(conf);
+            ++wordCounts.last();
+        }
+        for (int i = 0; i < confidence.size(); ++i)
+            confidence[i] /= wordCounts.at(i);
+        finishLines(result, lines, confidence);
+    }
+
+    void fail(OcrResult &result, OcrResult::Error error, const QString &message)
+    {
+        result.error = error;
+        result.errorString = message;
+    }
+
+    // Bricht einen laufenden Prozess ab, sobald der Auftrag storniert wird
+    bool waitOrCancel(QProcess &proc, QPromise<OcrResult> &promise, int timeoutMsecs = -1)
+    {
+        int waited = 0;
+        while (proc.state() != QProcess::NotRunning && !proc.waitForFinished(50))
+        {
+            waited += 50;
+            if (promise.isCanceled() || (timeoutMsecs >= 0 && waited >= timeoutMsecs))
+            {
+                proc.kill();
+                proc.waitForFinished(1000);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Startet program mit einem Info-Schalter und liefert stdout + stderr
+    bool queryProgram(const QString &program, const QString &option, QPromise<OcrResult> &promise, OcrResult &result, QString *output)
+    {
+        QProcess proc;
+        proc.start(program, {option});
+        if (!proc.waitForStarted(5000))
+        {
+            fail(result, OcrResult::EngineMissing, QStringLiteral("Tesseract konnte nicht gestartet werden. Bitte installieren (z.B. via Homebrew: brew install tesseract)."));
+            return false;
+        }
+        if (!waitOrCancel(proc, promise, 10000))
+        {
+            fail(result, OcrResult::Canceled, QString());
+            return false;
+        }
+        // Ältere Versionen schreiben die Infos nach stderr
+        *output = QString::fromUtf8(proc.readAllStandardOutput() + '\n' + proc.readAllStandardError());
+        return true;
+    }
+
+    // Sprachliste und Version einmal pro Programm abfragen statt bei jedem
+    // Bild; die Sperre hält parallele Aufträge an, bis beides da ist
+    bool ensureProgramInfo(OcrEnginePool &pool, const QString &program, QPromise<OcrResult> &promise, OcrResult &result,
+                           QStringList *languagesOut, QString *versionOut)
+    {
+        QMutexLocker lock(&pool.mutex);
+        if (pool.languagesProgram != program)
+        {
+            QString output;
+            if (!queryProgram(program, QStringLiteral("--list-langs"), promise, result, &output))
+                return false;
+            // Erste Zeile ist eine Überschrift ("List of available languages ...")
+            QStringList languages;
+            const QStringList lines = output.split('\n', Qt::SkipEmptyParts);
+            for (int i = 1; i < lines.size(); ++i)
+            {
+                const QString language = lines.at(i).trimmed();
+                if (!language.isEmpty())
+                    languages << language;
+            }
+            if (!queryProgram(program, QStringLiteral("--version"), promise, result, &output))
+                return false;
+            pool.languages = languages;
+            pool.version = output.section('\n', 0, 0).trimmed();
+            pool.languagesProgram = program;
+        }
+        *languagesOut = pool.languages;
+        *versionOut = pool.version;
+        return true;
+    }
+
+    // Prüft Programm und Sprachdaten, bevor ein Bild erkannt wird
+    bool prepareProgram(QPromise<OcrResult> &promise, OcrEnginePool &pool, const QString &program, const QString &language, OcrResult &result, QString *version)
+    {
+        QStringList languages;
+        if (!ensureProgramInfo(pool, program, promise, result, &languages, version))
+            return false;
+        // Leere Liste: ältere Versionen ohne --list-langs, dann einfach versuchen
+        if (!languages.isEmpty())
+        {
+            for (const QString &part : language.split('+', Qt::SkipEmptyParts))
+            {
+                if (!languages.contains(part))
+                {
+                    fail(result, OcrResult::LanguageMissing, QStringLiteral("Sprachdaten für '%1' sind nicht installiert.").arg(part));
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    void recognizeWithProgram(QPromise<OcrResult> &promise, const QString &program, const QString &language, const QString &inputPath, OcrResult &result)
+    {
+        promise.setProgressValue(10);
+
+        // Der Pool startet einen Prozess pro Kern; ohne Limit öffnet jeder
+        // zusätzlich eigene OpenMP-Threads und die CPU ist mehrfach überbucht
+        QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+        env.insert(QStringLiteral("OMP_THREAD_LIMIT"), QStringLiteral("1"));
+        QProcess proc;
+        proc.setProcessEnvironment(env);
+        proc.start(program, {inputPath, QStringLiteral("stdout"), QStringLiteral("-l"), language, QStringLiteral("tsv")});
+        if (!proc.waitForStarted(5000))
+        {
+            fail(result, OcrResult::EngineMissing, QStringLiteral("Tesseract konnte nicht gestartet werden. Bitte installieren (z.B. via Homebrew: brew install tesseract)."));
+            return;
+        }
+        if (!waitOrCancel(proc, promise))
+        {
+            fail(result, OcrResult::Canceled, QString());
+            return;
+        }
+        promise.setProgressValue(90);
+        const QByteArray out = proc.readAllStandardOutput();
+        const QByteArray err = proc.readAllStandardError();
+        if (proc.exitStatus() != QProcess::NormalExit || proc.exitCode() != 0)
+        {
+            fail(result, OcrResult::Failed, QString::fromUtf8(err));
+            return;
+        }
+        finishTsv(result, QString::fromUtf8(out));
+    }
+
+#ifdef CLANMANAGER_HAVE_TESSERACT
+    struct MonitorContext
+    {
+        QPromise<OcrResult> *promise;
+        ETEXT_DESC *monitor;
+    };
+
+    // Tesseract ruft das regelmäßig während Recognize() auf
+    bool monitorCallback(void *context, int)
+    {
+        auto *ctx = static_cast<MonitorContext *>(context);
+        ctx->promise->setProgressValue(10 + qBound(0, int(ctx->monitor->progress), 100) * 80 / 100);
+        return ctx->promise->isCanceled();
+    }
+
+    void recognizeInProcess(QPromise<OcrResult> &promise, OcrEngine &engine, const QString &language, bool preprocess, OcrResult &result)
+    {
+        // Sprachdaten bleiben geladen, bis eine andere Sprache verlangt wird
+        if (engine.apiLanguage != language)
+        {
+            engine.api.End();
+            engine.apiLanguage.clear();
+            if (engine.api.Init(nullptr, language.toUtf8().constData()) != 0)
+            {
+                fail(result, OcrResult::LanguageMissing, QStringLiteral("Sprachdaten für '%1' konnten nicht geladen werden.").arg(language));
+                return;
+            }
+            engine.apiLanguage = language;
+        }
+
+        QImage image(result.imagePath);
+        if (image.isNull())
+        {
+            fail(result, OcrResult::ImageUnreadable, QStringLiteral("Bild konnte nicht gelesen werden: %1").arg(result.imagePath));
+            return;
+        }
+        if (preprocess)
+            image = OcrPreprocessor::process(image).image;
+        else
+            image = image.convertToFormat(QImage::Format_Grayscale8);
+        promise.setProgressValue(10);
+
+        engine.api.SetImage(image.constBits(), image.width(), image.height(), 1, int(image.bytesPerLine()));
+        ETEXT_DESC monitor;
+        MonitorContext context{&promise, &monitor};
+        monitor.cancel = &monitorCallback;
+        monitor.cancel_this = &context;
+        const int status = engine.api.Recognize(&monitor);
+        if (promise.isCanceled())
+        {
+            engine.api.Clear();
+            fail(result, OcrResult::Canceled, QString());
+            return;
+        }
+        if (status != 0)
+        {
+            engine.api.Clear();
+            fail(result, OcrResult::Failed, QStringLiteral("Tesseract meldet Fehler %1").arg(status));
+            return;
+        }
+        // Zeilenweise mit Konfidenz statt GetUTF8Text() am Stück
+        QStringList lines;
+        QList<int> confidence;
+        std::unique_ptr<tesseract::ResultIterator> it(engine.api.GetIterator());
+        if (it)
+        {
+            do
+            {
+                std::unique_ptr<char[]> line(it->GetUTF8Text(tesseract::RIL_TEXTLINE));
+                if (!line)
+                    continue;
+                lines << QString::fromUtf8(line.get());
+                confidence << qRound(it->Confidence(tesseract::RIL_TEXTLINE));
+            } while (it->Next(tesseract::RIL_TEXTLINE));
+        }
+        it.reset();
+        engine.api.Clear();
+        promise.setProgressValue(90);
+        finishLines(result, lines, confidence);
+    }
+#endif
+
+    // Erst im Cache nachsehen, sonst erkennen, Zeilen auswerten und ablegen
+    void recognizeCached(QPromise<OcrResult> &promise, OcrEnginePool &engines, OcrCache *cache, const RosterTextParser &roster,
+                         const QString &program, const QString &language, bool preprocess, OcrResult &result)
+    {
+        if (!QFileInfo::exists(result.imagePath))
+        {
+            fail(result, OcrResult::ImageUnreadable, QStringLiteral("Bild nicht gefunden: %1").arg(result.imagePath));
+            return;
+        }
+        QString version;
+#ifdef CLANMANAGER_HAVE_TESSERACT
+        Q_UNUSED(program);
+        version = QStringLiteral("libtesseract %1").arg(QString::fromUtf8(tesseract::TessBaseAPI::Version()));
+#else
+        if (!prepareProgram(promise, engines, program, language, result, &version))
+            return;
+#endif
+        // Vorbereitetes Bild ergibt anderen Text: eigener Cache-Schlüssel
+        if (preprocess)
+            version += QStringLiteral(" +prep%1").arg(OcrPreprocessor::Version);
+        // Andere Ränge trennen Namen anders
+        version += QStringLiteral(" +roster%1").arg(roster.signature());
+        QString key;
+        if (cache)
+        {
+            const QByteArray hash = OcrCache::imageHash(result.imagePath);
+            if (!hash.isEmpty())
+                key = OcrCache::key(hash, language, version);
+            if (!key.isEmpty() && cache->lookup(key, result))
+                return;
+        }
+#ifdef CLANMANAGER_HAVE_TESSERACT
+        std::unique_ptr<OcrEngine> engine = engines.acquire();
+        recognizeInProcess(promise, *engine, language, preprocess, result);
+        engines.release(std::move(engine));
+#else
+        // Vorbereitetes Bild als unkomprimiertes PGM übergeben; Bilder, die
+        // Qt nicht lesen kann, bekommt Tesseract unverändert
+        QString inputPath = result.imagePath;
+        QTemporaryFile prepared(QDir::tempPath() + QStringLiteral("/clanmanager-ocr-XXXXXX.pgm"));
+        if (preprocess)
+        {
+            const QImage source(result.imagePath);
+            if (!source.isNull() && prepared.open() && OcrPreprocessor::process(source).image.save(&prepared, "PGM"))
+            {
+                prepared.close();
+                inputPath = prepared.fileName();
+            }
+        }
+        recognizeWithProgram(promise, program, language, inputPath, result);
+#endif
+        if (!result.ok())
+            return;
+        result.roster = roster.parse(result.lines);
+        if (!key.isEmpty())
+            cache->store(key, result);
+    }
+
+    void runJob(QPromise<OcrResult> &promise, const std::shared_ptr<OcrEnginePool> &engines, const std::shared_ptr<OcrCache> &cache,
+                const std::shared_ptr<const RosterTextParser> &roster, OcrResult result, const QString &program,
+                const QString &language, bool preprocess)
+    {
+        promise.setProgressRange(0, 100);
+        promise.setProgressValue(0);
+        recognizeCached(promise, *engines, cache.get(), *roster, program, language, preprocess, result);
+        if (result.ok())
+            promise.setProgressValue(100);
+        promise.addResult(result);
+    }
+}
+
+OcrService::OcrService(QObject *parent)
+    : QObject(parent), m_engines(std::make_shared<OcrEnginePool>()),
+      m_roster(std::make_shared<const RosterTextParser>())
+{
+    // Ein Worker pro Kern, die nicht auslaufen; die Engines im Vorrat
+    // behalten ihre geladene Sprache zwischen den Bildern
+    m_pool.setMaxThreadCount(qMax(1, QThread::idealThreadCount()));
+    m_pool.setExpiryTimeout(-1);
+}
+
+OcrService::~OcrService()
+{
+    cancelAll();
+    m_pool.waitForDone();
+}
+
+void OcrService::setLanguage(const QString &language)
+{
+    const QString trimmed = language.trimmed();
+    m_language = trimmed.isEmpty() ? QStringLiteral("deu") : trimmed;
+}
+
+void OcrService::setProgram(const QString &program)
+{
+    m_program = program;
+}
+
+void OcrService::setPreprocessing(bool enabled)
+{
+    m_preprocess = enabled;
+}
+
+void OcrService::setCache(const std::shared_ptr<OcrCache> &cache)
+{
+    m_cache = cache;
+}
+
+void OcrService::setRosterParser(const std::shared_ptr<const RosterTextParser> &parser)
+{
+    // Laufende Aufträge behalten ihren Parser über den shared_ptr
+    m_roster = parser ? parser : std::make_shared<const RosterTextParser>();
+}
+
+bool OcrService::hasInProcessEngine()
+{
+#ifdef CLANMANAGER_HAVE_TESSERACT
+    return true;
+#else
+    return false;
+#endif
+}
+
+quint64 OcrService::recognize(const QString &imagePath)
+{
+    return submit(imagePath);
+}
+
+quint64 OcrService::submit(const QString &imagePath)
+{
+    const quint64 job = m_nextJob++;
+    OcrResult request;
+    request.job = job;
+    request.imagePath = imagePath;
+
+    auto *watcher = new QFutureWatcher<OcrResult>(this);
+    m_jobs.insert(job, watcher);
+    connect(watcher, &QFutureWatcherBase::progressValueChanged, this, [this, job](int percent)
+            {
+        emit progress(job, percent);
+        const quint64 batchId = m_batchOfJob.value(job);
+        auto it = m_batches.find(batchId);
+        if (it == m_batches.end())
+            return;
+        const int page = it->jobs.indexOf(job);
+        it->percent[page] = percent;
+        int sum = 0;
+        for (int p : std::as_const(it->percent))
+            sum += p;
+        emit progress(batchId, sum / int(it->percent.size())); });
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, job, watcher, request]()
+            {
+        m_jobs.remove(job);
+        watcher->deleteLater();
+        OcrResult result = request;
+        const QFuture<OcrResult> future = watcher->future();
+        // Storniert ist storniert, auch wenn der Worker noch fertig wurde
+        if (future.isCanceled())
+            result.error = OcrResult::Canceled;
+        else if (future.resultCount() > 0)
+            result = future.result();
+        else
+            fail(result, OcrResult::Failed, QStringLiteral("Kein Ergebnis"));
+        emit finished(result);
+        if (m_batchOfJob.contains(job))
+            pageFinished(result); });
+    watcher->setFuture(QtConcurrent::run(&m_pool, runJob, m_engines, m_cache, m_roster, request, m_program, m_language, m_preprocess));
+    return job;
+}
+
+quint64 OcrService::recognizeBatch(const QStringList &imagePaths)
+{
+    const quint64 batchId = m_nextJob++;
+    if (imagePaths.isEmpty())
+    {
+        // Nichts zu tun, das Ergebnis trotzdem erst nach der Rückkehr melden
+        QMetaObject::invokeMethod(this, [this, batchId]()
+                                  {
+            OcrResult merged = mergePages({}, *m_roster);
+            merged.job = batchId;
+            emit finished(merged); }, Qt::QueuedConnection);
+        return batchId;
+    }
+    Batch &batch = m_batches[batchId];
+    batch.remaining = int(imagePaths.size());
+    // Signale der Watcher kommen erst über die Ereignisschleife, die
+    // Zuordnung steht also, bevor die erste Seite etwas meldet
+    for (const QString &path : imagePaths)
+    {
+        const quint64 job = submit(path);
+        m_batchOfJob.insert(job, batchId);
+        batch.jobs << job;
+        OcrResult page;
+        page.job = job;
+        page.imagePath = path;
+        batch.pages << page;
+        batch.percent << 0;
+    }
+    return batchId;
+}
+
+void OcrService::pageFinished(const OcrResult &page)
+{
+    const quint64 batchId = m_batchOfJob.take(page.job);
+    auto it = m_batches.find(batchId);
+    if (it == m_batches.end())
+        return;
+    const int index = it->jobs.indexOf(page.job);
+    it->pages[index] = page;
+    if (--it->remaining > 0)
+        return;
+
+    const Batch batch = *it;
+    m_batches.erase(it);
+    OcrResult merged = mergePages(batch.pages, *m_roster);
+    merged.job = batchId;
+    for (const OcrResult &p : batch.pages)
+    {
+        if (p.error == OcrResult::Canceled)
+            merged.error = OcrResult::Canceled;
+    }
+    emit finished(merged);
+}
+
+void OcrService::cancel(quint64 job)
+{
+    if (QFutureWatcher<OcrResult> *watcher = m_jobs.value(job))
+        watcher->cancel();
+    const auto batch = m_batches.constFind(job);
+    if (batch != m_batches.constEnd())
+    {
+        for (quint64 page : batch->jobs)
+            cancel(page);
+    }
+}
+
+void OcrService::cancelAll()
+{
+    for (QFutureWatcher<OcrResult> *watcher : std::as_const(m_jobs))
+        watcher->cancel();
+}
+
+OcrResult OcrService::mergePages(const QList<OcrResult> &pages, const RosterTextParser &parser)
+{
+    struct Entry
+    {
+        QString line;
+        int section;
+        int confidence;
+    };
+    OcrResult merged;
+    QStringList preamble; // alles vor der ersten Überschrift (Titel, Datum, Map)
+    QList<int> preambleConfidence;
+    QSet<QString> preambleKeys;
+    QList<Entry> entries;
+    QHash<QString, int> entryByKey;
+    QStringList failures;
+    OcrResult::Error firstError = OcrResult::NoError;
+    bool anyPageOk = false;
+    bool allFromCache = true;
+    int section = -1;
+
+    if (!pages.isEmpty())
+        merged.imagePath = pages.first().imagePath;
+    for (const OcrResult &page : pages)
+    {
+        if (!page.ok())
+        {
+            if (firstError == OcrResult::NoError)
+                firstError = page.error;
+            if (page.error != OcrResult::Canceled)
+                failures << QStringLiteral("%1: %2").arg(page.imagePath, page.errorString);
+            continue;
+        }
+        anyPageOk = true;
+        allFromCache = allFromCache && page.fromCache;
+        for (int i = 0; i < page.lines.size(); ++i)
+        {
+            const QString &line = page.lines.at(i);
+            const int confidence = page.confidence.value(i, -1);
+            const int header = RosterTextParser::sectionOf(line);
+            if (header >= 0)
+            {
+                section = header;
+                continue;
+            }
+            const QString key = PlayerList::foldKey(line);
+            // Wiederholter Kopf einer Folgeseite
+            if (preambleKeys.contains(key))
+                continue;
+            if (section < 0)
+            {
+                preambleKeys.insert(key);
+                preamble << line;
+                preambleConfidence << confidence;
+                continue;
+            }
+            if (!RosterTextParser::isNameLine(line))
+                continue;
+            const auto found = entryByKey.constFind(key);
+            if (found == entryByKey.constEnd())
+            {
+                entryByKey.insert(key, int(entries.size()));
+                entries.append({line, section, confidence});
+            }
+            // Bei gleicher Konfidenz gilt die zuerst gesehene Stelle
+            else if (confidence > entries.at(*found).confidence)
+            {
+                entries[*found] = {line, section, confidence};
+            }
+        }
+    }
+
+    // Einzelne unlesbare Seiten stehen nur in errorString, der Rest zählt
+    merged.error = anyPageOk ? OcrResult::NoError : firstError;
+    merged.errorString = failures.join('\n');
+    merged.lines = preamble;
+    merged.confidence = preambleConfidence;
+    for (int s = 0; s < RosterTextParser::SectionCount; ++s)
+    {
+        QStringList names;
+        QList<int> confidence;
+        for (const Entry &e : std::as_const(entries))
+        {
+            if (e.section != s)
+                continue;
+            names << e.line;
+            confidence << e.confidence;
+        }
+        if (names.isEmpty())
+            continue;
+        merged.lines << QStringLiteral("%1 (%2)").arg(RosterTextParser::sectionHeader(s)).arg(names.size());
+        merged.confidence << -1;
+        merged.lines << names;
+        merged.confidence << confidence;
+    }
+    merged.text = merged.lines.join('\n');
+    merged.fromCache = anyPageOk && allFromCache;
+    merged.roster = parser.parse(merged.lines);
+    return merged;
+}
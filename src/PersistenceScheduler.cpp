@@ -0,0 +1,129 @@
+#include "PersistenceScheduler.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QtGlobal>
+
+PersistenceScheduler::PersistenceScheduler(QObject *parent)
+    : QObject(parent)
+{
+    m_timer.setSingleShot(true);
+    m_timer.setInterval(0);
+    connect(&m_timer, &QTimer::timeout, this, &PersistenceScheduler::flushAll);
+    if (QCoreApplication *app = QCoreApplication::instance())
+        connect(app, &QCoreApplication::aboutToQuit, this, &PersistenceScheduler::flushAll);
+}
+
+PersistenceScheduler::~PersistenceScheduler()
+{
+    flushAll();
+}
+
+void PersistenceScheduler::registerStore(const QString &store, const Writer &writer)
+{
+    m_stores[store].writer = writer;
+}
+
+void PersistenceScheduler::markDirty(const QString &store)
+{
+    auto it = m_stores.find(store);
+    if (it == m_stores.end())
+    {
+        qWarning() << "PersistenceScheduler: unbekannter Speicher" << store;
+        return;
+    }
+    it->dirty = true;
+    ++it->marks;
+    // Timer nicht neu starten, sonst verhungert der Flush bei Dauerlast
+    if (!m_timer.isActive())
+        m_timer.start();
+}
+
+bool PersistenceScheduler::isDirty(const QString &store) const
+{
+    auto it = m_stores.constFind(store);
+    return it != m_stores.constEnd() && it->dirty;
+}
+
+bool PersistenceScheduler::hasPending() const
+{
+    for (auto it = m_stores.constBegin(); it != m_stores.constEnd(); ++it)
+    {
+        if (it->dirty)
+            return true;
+    }
+    return false;
+}
+
+void PersistenceScheduler::flush(const QString &store)
+{
+    auto it = m_stores.find(store);
+    if (it != m_stores.end() && it->dirty)
+        flushStore(it.key(), *it);
+}
+
+void PersistenceScheduler::flushAll()
+{
+    m_timer.stop();
+    // Writer dürfen erneut markDirty() aufrufen; das landet im nächsten Fenster
+    if (m_flushing)
+        return;
+    m_flushing = true;
+    for (auto it = m_stores.begin(); it != m_stores.end(); ++it)
+    {
+        if (it->dirty)
+            flushStore(it.key(), *it);
+    }
+    m_flushing = false;
+}
+
+void PersistenceScheduler::flushStore(const QString &name, Store &store)
+{
+    store.dirty = false;
+    if (!store.writer)
+        return;
+    QElapsedTimer timer;
+    timer.start();
+    store.writer();
+    const qint64 nsecs = timer.nsecsElapsed();
+    ++store.flushes;
+    store.lastNsecs = nsecs;
+    store.totalNsecs += nsecs;
+    emit flushed(name, nsecs);
+}
+
+void PersistenceScheduler::setDebounceInterval(int msec)
+{
+    m_timer.setInterval(qMax(0, msec));
+}
+
+int PersistenceScheduler::markCount(const QString &store) const
+{
+    return m_stores.value(store).marks;
+}
+
+int PersistenceScheduler::flushCount(const QString &store) const
+{
+    return m_stores.value(store).flushes;
+}
+
+qint64 PersistenceScheduler::lastFlushNsecs(const QString &store) const
+{
+    return m_stores.value(store).lastNsecs;
+}
+
+qint64 PersistenceScheduler::totalFlushNsecs(const QString &store) const
+{
+    return m_stores.value(store).totalNsecs;
+}
+
+void PersistenceScheduler::resetStats()
+{
+    for (auto it = m_stores.begin(); it != m_stores.end(); ++it)
+    {
+        it->marks = 0;
+        it->flushes = 0;
+        it->lastNsecs = 0;
+        it->totalNsecs = 0;
+    }
+}
@@ -7,13 +7,13 @@ QString Player::toCsvLine() const
     parts << name
           << t17name
           << QString::number(level)
-          << group
+          << group.toString()
           << QString::number(attendance)
           << comment
           << joinDate.toString(Qt::ISODate)
-          << rank
+          << rank.toString()
           << lastPromotionDate.toString(Qt::ISODate)
-          << nextRank;
+          << nextRank.toString();
     // append counters so exports retain per-rank tracking
     parts << QString::number(totalAttendance)
           << QString::number(events)
@@ -0,0 +1,188 @@
+#include "PlayerFilterIndex.h"
+#include <algorithm>
+#include <iterator>
+
+void PlayerFilterIndex::reset(int rows)
+{
+    m_rows = QVector<Folded>(rows);
+    m_groupBits.clear();
+    m_rankBits.clear();
+    m_postings.clear();
+    m_lastCandidates = 0;
+}
+
+quint64 PlayerFilterIndex::trigramKey(const QChar *s)
+{
+    return (quint64(s[0].unicode()) << 32) | (quint64(s[1].unicode()) << 16) | quint64(s[2].unicode());
+}
+
+void PlayerFilterIndex::collectTrigrams(const QString &folded, QSet<quint64> &out)
+{
+    for (int i = 0; i + 3 <= folded.size(); ++i)
+        out.insert(trigramKey(folded.constData() + i));
+}
+
+QSet<quint64> PlayerFilterIndex::trigramsOf(const Folded &row)
+{
+    // Pro Feld getrennt, damit keine Trigramme über Feldgrenzen entstehen
+    QSet<quint64> grams;
+    collectTrigrams(row.name, grams);
+    collectTrigrams(row.t17name, grams);
+    collectTrigrams(row.group, grams);
+    return grams;
+}
+
+void PlayerFilterIndex::setBit(QHash<quint32, QBitArray> &bits, quint32 id, int row, bool on)
+{
+    auto it = bits.find(id);
+    if (it == bits.end())
+    {
+        if (!on)
+            return;
+        it = bits.insert(id, QBitArray(m_rows.size()));
+    }
+    it->setBit(row, on);
+}
+
+void PlayerFilterIndex::addPosting(quint64 key, int row)
+{
+    QVector<int> &rows = m_postings[key];
+    const auto pos = std::lower_bound(rows.begin(), rows.end(), row);
+    if (pos == rows.end() || *pos != row)
+        rows.insert(pos, row);
+}
+
+void PlayerFilterIndex::removePosting(quint64 key, int row)
+{
+    const auto it = m_postings.find(key);
+    if (it == m_postings.end())
+        return;
+    const auto pos = std::lower_bound(it->begin(), it->end(), row);
+    if (pos != it->end() && *pos == row)
+        it->erase(pos);
+    if (it->isEmpty())
+        m_postings.erase(it);
+}
+
+void PlayerFilterIndex::setRow(int row, const Row &data)
+{
+    if (row < 0 || row >= m_rows.size())
+        return;
+    Folded &slot = m_rows[row];
+    const QSet<quint64> oldGrams = trigramsOf(slot);
+    setBit(m_groupBits, slot.groupId, row, false);
+    setBit(m_rankBits, slot.rankId, row, false);
+
+    slot.name = data.name.toCaseFolded();
+    slot.t17name = data.t17name.toCaseFolded();
+    slot.group = data.group.toCaseFolded();
+    slot.groupId = data.groupId;
+    slot.rankId = data.rankId;
+
+    const QSet<quint64> newGrams = trigramsOf(slot);
+    for (quint64 key : oldGrams)
+    {
+        if (!newGrams.contains(key))
+            removePosting(key, row);
+    }
+    for (quint64 key : newGrams)
+    {
+        if (!oldGrams.contains(key))
+            addPosting(key, row);
+    }
+    setBit(m_groupBits, slot.groupId, row, true);
+    setBit(m_rankBits, slot.rankId, row, true);
+}
+
+QBitArray PlayerFilterIndex::matchGroup(quint32 groupId) const
+{
+    return m_groupBits.value(groupId, QBitArray(m_rows.size()));
+}
+
+QBitArray PlayerFilterIndex::matchRanks(const QSet<quint32> &rankIds) const
+{
+    QBitArray result(m_rows.size());
+    for (quint32 id : rankIds)
+    {
+        const auto it = m_rankBits.constFind(id);
+        if (it != m_rankBits.constEnd())
+            result |= *it;
+    }
+    return result;
+}
+
+bool PlayerFilterIndex::rowContains(int row, const QString &foldedQuery) const
+{
+    const Folded &r = m_rows.at(row);
+    return r.name.contains(foldedQuery) || r.t17name.contains(foldedQuery) || r.group.contains(foldedQuery);
+}
+
+QBitArray PlayerFilterIndex::matchText(const QString &query) const
+{
+    const QString folded = query.toCaseFolded();
+    QBitArray result(m_rows.size());
+    if (folded.isEmpty())
+    {
+        m_lastCandidates = 0;
+        result.fill(true);
+        return result;
+    }
+
+    if (folded.size() < 3)
+    {
+        // Zu kurz für Trigramme: die gefalteten Felder direkt prüfen
+        m_lastCandidates = m_rows.size();
+        for (int row = 0; row < m_rows.size(); ++row)
+            result.setBit(row, rowContains(row, folded));
+        return result;
+    }
+
+    // Kürzeste Liste zuerst, dann schneiden
+    QVector<const QVector<int> *> lists;
+    QSet<quint64> grams;
+    collectTrigrams(folded, grams);
+    for (quint64 key : grams)
+    {
+        const auto it = m_postings.constFind(key);
+        if (it == m_postings.constEnd())
+        {
+            m_lastCandidates = 0;
+            return result;
+        }
+        lists.append(&it.value());
+    }
+    std::sort(lists.begin(), lists.end(), [](const QVector<int> *a, const QVector<int> *b)
+              { return a->size() < b->size(); });
+    QVector<int> candidates = *lists.first();
+    for (int i = 1; i < lists.size() && !candidates.isEmpty(); ++i)
+    {
+        QVector<int> next;
+        std::set_intersection(candidates.cbegin(), candidates.cend(), lists.at(i)->cbegin(), lists.at(i)->cend(), std::back_inserter(next));
+        candidates = std::move(next);
+    }
+
+    // Trigramme können aus verschiedenen Feldern stammen: Kandidaten bestätigen
+    m_lastCandidates = candidates.size();
+    for (int row : std::as_const(candidates))
+        result.setBit(row, rowContains(row, folded));
+    return result;
+}
+
+QBitArray PlayerFilterIndex::refineText(const QString &query, const QBitArray &within) const
+{
+    const QString folded = query.toCaseFolded();
+    if (folded.isEmpty())
+        return within;
+    QBitArray result(m_rows.size());
+    int candidates = 0;
+    const int rows = qMin(int(m_rows.size()), int(within.size()));
+    for (int row = 0; row < rows; ++row)
+    {
+        if (!within.testBit(row))
+            continue;
+        ++candidates;
+        result.setBit(row, rowContains(row, folded));
+    }
+    m_lastCandidates = candidates;
+    return result;
+}
@@ -1,55 +1,254 @@
 #include "PlayerList.h"
 #include "Player.h"
-#include "PlayerList.h"
 #include <QStringList>
+#include <algorithm>
+
+static void mergeInto(Player &existing, const Player &p)
+{
+    // merge fields conservatively
+    existing.level = qMax(existing.level, p.level);
+    existing.attendance += p.attendance;
+    existing.totalAttendance += p.totalAttendance;
+    existing.events += p.events;
+    existing.totalEvents += p.totalEvents;
+    existing.reserve += p.reserve;
+    existing.totalReserve += p.totalReserve;
+    if (existing.joinDate.isNull() && !p.joinDate.isNull())
+        existing.joinDate = p.joinDate;
+    if (existing.comment.isEmpty())
+        existing.comment = p.comment;
+    if (existing.rank.isEmpty())
+        existing.rank = p.rank;
+}
+
+QString PlayerList::foldKey(const QString &name)
+{
+    return name.trimmed().toCaseFolded();
+}
 
 void PlayerList::clear()
 {
     players.clear();
+    m_byName.clear();
+    m_byT17.clear();
+    m_byFolded.clear();
+    m_fuzzy.clear();
+    m_fuzzyBuilt = false;
+}
+
+void PlayerList::reserve(int count)
+{
+    players.reserve(static_cast<size_t>(count));
+    m_byName.reserve(count);
+    m_byT17.reserve(count);
+    m_byFolded.reserve(count);
+}
+
+void PlayerList::indexPlayer(int index)
+{
+    const Player &p = players[static_cast<size_t>(index)];
+    // Bei Duplikaten gewinnt der erste Eintrag (wie beim linearen Suchen)
+    if (!m_byName.contains(p.name))
+        m_byName.insert(p.name, index);
+    if (!p.t17name.isEmpty() && !m_byT17.contains(p.t17name))
+        m_byT17.insert(p.t17name, index);
+    const QString folded = foldKey(p.name);
+    if (!folded.isEmpty() && !m_byFolded.contains(folded))
+        m_byFolded.insert(folded, index);
+}
+
+void PlayerList::rebuildHashes()
+{
+    m_byName.clear();
+    m_byT17.clear();
+    m_byFolded.clear();
+    for (int i = 0; i < static_cast<int>(players.size()); ++i)
+        indexPlayer(i);
+}
+
+void PlayerList::reindex()
+{
+    rebuildHashes();
+    // players wurde von außen umgebaut: Fuzzy-Index bei Bedarf neu
+    m_fuzzy.clear();
+    m_fuzzyBuilt = false;
+}
+
+void PlayerList::addFuzzyKeys(const Player &p) const
+{
+    if (!m_fuzzyBuilt)
+        return;
+    m_fuzzy.insert(foldKey(p.name), p.name);
+    if (!p.t17name.isEmpty())
+        m_fuzzy.insert(foldKey(p.t17name), p.name);
+}
+
+void PlayerList::removeFuzzyKeys(const Player &p) const
+{
+    if (!m_fuzzyBuilt)
+        return;
+    m_fuzzy.remove(foldKey(p.name), p.name);
+    if (!p.t17name.isEmpty())
+        m_fuzzy.remove(foldKey(p.t17name), p.name);
+}
+
+const FuzzyNameIndex &PlayerList::fuzzyIndex() const
+{
+    if (!m_fuzzyBuilt)
+    {
+        m_fuzzy.clear();
+        m_fuzzyBuilt = true;
+        for (const Player &p : players)
+            addFuzzyKeys(p);
+    }
+    return m_fuzzy;
+}
+
+int PlayerList::indexOfNameFuzzy(const QString &name, int maxDistance) const
+{
+    const QString folded = foldKey(name);
+    if (folded.isEmpty() || maxDistance < 0)
+        return -1;
+    const QVector<FuzzyNameIndex::Match> matches = fuzzyIndex().within(folded, maxDistance);
+    int found = -1;
+    for (const FuzzyNameIndex::Match &m : matches)
+    {
+        const int idx = indexOfName(m.value);
+        if (idx < 0 || idx == found)
+            continue;
+        if (found >= 0)
+            return -1; // mehrdeutig
+        found = idx;
+    }
+    return found;
 }
 
 void PlayerList::addOrMerge(const Player &p)
 {
-    // Merge by name + t17name if possible
-    for (auto &existing : players)
+    // Merge by t17name if present, otherwise by name
+    const int idx = p.t17name.isEmpty() ? indexOfName(p.name) : indexOfT17(p.t17name);
+    if (idx >= 0)
     {
-        if (!p.t17name.isEmpty() && existing.t17name == p.t17name)
-        {
-            // merge fields conservatively
-            existing.level = qMax(existing.level, p.level);
-            existing.attendance += p.attendance;
-            existing.totalAttendance += p.totalAttendance;
-            existing.events += p.events;
-            existing.totalEvents += p.totalEvents;
-            existing.reserve += p.reserve;
-            existing.totalReserve += p.totalReserve;
-            if (existing.joinDate.isNull() && !p.joinDate.isNull())
-                existing.joinDate = p.joinDate;
-            if (existing.comment.isEmpty())
-                existing.comment = p.comment;
-            if (existing.rank.isEmpty())
-                existing.rank = p.rank;
-            return;
-        }
-        if (existing.name == p.name && p.t17name.isEmpty())
-        {
-            existing.level = qMax(existing.level, p.level);
-            existing.attendance += p.attendance;
-            existing.totalAttendance += p.totalAttendance;
-            existing.events += p.events;
-            existing.totalEvents += p.totalEvents;
-            existing.reserve += p.reserve;
-            existing.totalReserve += p.totalReserve;
-            if (existing.joinDate.isNull() && !p.joinDate.isNull())
-                existing.joinDate = p.joinDate;
-            if (existing.comment.isEmpty())
-                existing.comment = p.comment;
-            if (existing.rank.isEmpty())
-                existing.rank = p.rank;
-            return;
-        }
+        mergeInto(players[static_cast<size_t>(idx)], p);
+        return;
     }
+    append(p);
+}
+
+void PlayerList::mergeAt(int index, const Player &p)
+{
+    if (index < 0 || index >= static_cast<int>(players.size()))
+        return;
+    mergeInto(players[static_cast<size_t>(index)], p);
+}
+
+int PlayerList::append(const Player &p)
+{
     players.push_back(p);
+    const int idx = static_cast<int>(players.size()) - 1;
+    indexPlayer(idx);
+    addFuzzyKeys(p);
+    return idx;
+}
+
+void PlayerList::replace(int index, const Player &p)
+{
+    if (index < 0 || index >= static_cast<int>(players.size()))
+        return;
+    Player &slot = players[static_cast<size_t>(index)];
+    const bool keysChanged = slot.name != p.name || slot.t17name != p.t17name;
+    if (keysChanged)
+        removeFuzzyKeys(slot);
+    slot = p;
+    if (keysChanged)
+    {
+        rebuildHashes();
+        addFuzzyKeys(slot);
+    }
+}
+
+bool PlayerList::rename(const QString &oldName, const QString &newName)
+{
+    const int idx = indexOfName(oldName);
+    if (idx < 0)
+        return false;
+    Player copy = players[static_cast<size_t>(idx)];
+    copy.name = newName;
+    replace(idx, copy);
+    return true;
+}
+
+void PlayerList::removeAt(int index)
+{
+    if (index < 0 || index >= static_cast<int>(players.size()))
+        return;
+    removeFuzzyKeys(players[static_cast<size_t>(index)]);
+    players.erase(players.begin() + index);
+    // Nachfolgende Indizes verschieben sich, Duplikate rücken evtl. nach
+    rebuildHashes();
+}
+
+bool PlayerList::removeByName(const QString &name)
+{
+    const int idx = indexOfName(name);
+    if (idx < 0)
+        return false;
+    // Alle Einträge mit diesem Namen entfernen (wie das frühere remove_if)
+    for (const Player &p : players)
+    {
+        if (p.name == name)
+            removeFuzzyKeys(p);
+    }
+    players.erase(std::remove_if(players.begin(), players.end(),
+                                 [&name](const Player &p)
+                                 { return p.name == name; }),
+                  players.end());
+    rebuildHashes();
+    return true;
+}
+
+int PlayerList::indexOfName(const QString &name) const
+{
+    return m_byName.value(name, -1);
+}
+
+int PlayerList::indexOfT17(const QString &t17name) const
+{
+    if (t17name.isEmpty())
+        return -1;
+    return m_byT17.value(t17name, -1);
+}
+
+int PlayerList::indexOfNameInsensitive(const QString &name) const
+{
+    const QString folded = foldKey(name);
+    if (folded.isEmpty())
+        return -1;
+    return m_byFolded.value(folded, -1);
+}
+
+Player *PlayerList::findByName(const QString &name)
+{
+    const int idx = indexOfName(name);
+    return idx >= 0 ? &players[static_cast<size_t>(idx)] : nullptr;
+}
+
+const Player *PlayerList::findByName(const QString &name) const
+{
+    const int idx = indexOfName(name);
+    return idx >= 0 ? &players[static_cast<size_t>(idx)] : nullptr;
+}
+
+Player *PlayerList::findByT17(const QString &t17name)
+{
+    const int idx = indexOfT17(t17name);
+    return idx >= 0 ? &players[static_cast<size_t>(idx)] : nullptr;
+}
+
+Player *PlayerList::findByNameInsensitive(const QString &name)
+{
+    const int idx = indexOfNameInsensitive(name);
+    return idx >= 0 ? &players[static_cast<size_t>(idx)] : nullptr;
 }
 
 QString PlayerList::toCsv() const
@@ -62,10 +261,10 @@ QString PlayerList::toCsv() const
 
 void PlayerList::fromCsv(const QString &text)
 {
-    players.clear();
+    clear();
     QStringList lines = text.split('\n', Qt::SkipEmptyParts);
     for (const auto &ln : lines)
     {
-        players.push_back(Player::fromCsvLine(ln));
+        append(Player::fromCsvLine(ln));
     }
 }
@@ -0,0 +1,303 @@
+#include "PlayerTableModel.h"
+#include "MainWindow.h"
+#include <QBrush>
+#include <QColor>
+#include <QDate>
+
+PlayerTableModel::PlayerTableModel(PlayerList *players, MainWindow *main, QObject *parent)
+    : QAbstractTableModel(parent), m_players(players), m_main(main)
+{
+    m_headers = {"Spielername", QString(), "T17-Name", "Level", "Gruppe", "Einsätze", "Kommentar", "Beitrittsdatum", "Dienstrang", "Aktion"};
+}
+
+int PlayerTableModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_rowCount;
+}
+
+int PlayerTableModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+const Player *PlayerTableModel::playerAt(int row) const
+{
+    if (!m_players || row < 0 || row >= m_rowCount || row >= static_cast<int>(m_players->players.size()))
+        return nullptr;
+    return &m_players->players[static_cast<size_t>(row)];
+}
+
+QVariant PlayerTableModel::data(const QModelIndex &index, int role) const
+{
+    const Player *p = index.isValid() ? playerAt(index.row()) : nullptr;
+    if (!p || !m_main)
+        return QVariant();
+    if (role == PlayerKeyRole)
+        return p->name;
+
+    const bool displayOrEdit = (role == Qt::DisplayRole || role == Qt::EditRole);
+    switch (index.column())
+    {
+    case NameColumn:
+        if (displayOrEdit)
+            return p->name;
+        break;
+    case StatusColumn:
+    {
+        // Priorität: Rotes X bei noResponseCounter >= threshold, sonst Stern bei Beförderungsreife
+        const bool flagged = p->noResponseCounter >= m_main->noResponseThreshold;
+        const bool eligible = isEligible(index.row());
+        if (role == Qt::DisplayRole)
+            return flagged ? QStringLiteral("❌") : (eligible ? QStringLiteral("★") : QString());
+        if (role == Qt::ForegroundRole)
+        {
+            if (flagged)
+                return QBrush(Qt::red);
+            if (eligible)
+                return QBrush(QColor(255, 215, 0));
+        }
+        if (role == Qt::ToolTipRole)
+        {
+            if (flagged)
+                return QStringLiteral("Keine Rückmeldungen: %1 Mal").arg(p->noResponseCounter);
+            if (eligible)
+                return QStringLiteral("Beförderungsvoraussetzungen erfüllt");
+        }
+        if (role == Qt::TextAlignmentRole)
+            return static_cast<int>(Qt::AlignCenter);
+        break;
+    }
+    case T17Column:
+        if (displayOrEdit)
+            return p->t17name;
+        break;
+    case LevelColumn:
+        if (displayOrEdit)
+            return p->level;
+        break;
+    case GroupColumn:
+        if (displayOrEdit)
+            return p->group.toString();
+        if (role == SymbolRole)
+            return p->group.id();
+        if (role == Qt::BackgroundRole || role == Qt::ForegroundRole)
+        {
+            QBrush background;
+            QBrush foreground;
+            if (!m_main->groupBrushes(p->group.toString(), background, foreground))
+                break;
+            return role == Qt::BackgroundRole ? background : foreground;
+        }
+        break;
+    case TrainingColumn:
+        if (role == Qt::DisplayRole)
+            return m_main->formatTrainingDisplay(*p);
+        if (role == Qt::ToolTipRole)
+            return m_main->trainingTooltip(*p);
+        break;
+    case CommentColumn:
+        if (displayOrEdit)
+            return p->comment;
+        break;
+    case JoinDateColumn:
+        if (displayOrEdit)
+            return p->joinDate.toString(Qt::ISODate);
+        break;
+    case RankColumn:
+        if (role == Qt::DisplayRole)
+            return m_main->formatRankDisplay(*p, isEligible(index.row()));
+        if (role == Qt::EditRole)
+            return p->rank.toString();
+        if (role == SymbolRole)
+            return p->rank.id();
+        break;
+    default:
+        break;
+    }
+    return QVariant();
+}
+
+bool PlayerTableModel::setData(const QModelIndex &index, const QVariant &value, int role)
+{
+    if (!index.isValid() || role != Qt::EditRole || !playerAt(index.row()))
+        return false;
+    const int row = index.row();
+    Player &p = m_players->players[static_cast<size_t>(row)];
+    const QString text = value.toString().trimmed();
+    switch (index.column())
+    {
+    case T17Column:
+    {
+        // T17-Name ist indiziert, daher über replace()
+        Player copy = p;
+        copy.t17name = text;
+        m_players->replace(row, copy);
+        break;
+    }
+    case LevelColumn:
+    {
+        bool ok = false;
+        const int level = text.toInt(&ok);
+        if (!ok)
+            return false;
+        p.level = level;
+        break;
+    }
+    case GroupColumn:
+        p.group = text;
+        break;
+    case CommentColumn:
+        p.comment = value.toString();
+        break;
+    case JoinDateColumn:
+    {
+        const QDate date = QDate::fromString(text, Qt::ISODate);
+        if (!text.isEmpty() && !date.isValid())
+            return false;
+        p.joinDate = date;
+        break;
+    }
+    case RankColumn:
+        p.rank = text;
+        break;
+    default:
+        return false;
+    }
+
+    emit dataChanged(index, index);
+    // Level fließt in die Rang-Anzeige ein
+    if (index.column() == LevelColumn)
+        playerChanged(row, RankColumn, RankColumn);
+    emit playerEdited(row);
+    return true;
+}
+
+Qt::ItemFlags PlayerTableModel::flags(const QModelIndex &index) const
+{
+    Qt::ItemFlags f = QAbstractTableModel::flags(index);
+    if (!index.isValid())
+        return f;
+    switch (index.column())
+    {
+    case T17Column:
+    case LevelColumn:
+    case GroupColumn:
+    case CommentColumn:
+    case JoinDateColumn:
+    case RankColumn:
+        f |= Qt::ItemIsEditable;
+        break;
+    case ActionColumn:
+        // Buttons im Delegate brauchen Maus-Events, aber keinen Editor
+        break;
+    default:
+        break;
+    }
+    return f;
+}
+
+QVariant PlayerTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation == Qt::Horizontal && role == Qt::DisplayRole && section >= 0 && section < m_headers.size())
+        return m_headers.at(section);
+    return QAbstractTableModel::headerData(section, orientation, role);
+}
+
+bool PlayerTableModel::setHeaderData(int section, Qt::Orientation orientation, const QVariant &value, int role)
+{
+    if (orientation != Qt::Horizontal || (role != Qt::DisplayRole && role != Qt::EditRole) || section < 0 || section >= m_headers.size())
+        return false;
+    m_headers[section] = value.toString();
+    emit headerDataChanged(orientation, section, section);
+    return true;
+}
+
+void PlayerTableModel::resetFromList()
+{
+    beginResetModel();
+    m_rowCount = m_players ? static_cast<int>(m_players->players.size()) : 0;
+    m_eligible.fill(false, m_rowCount);
+    endResetModel();
+}
+
+int PlayerTableModel::appendPlayer(const Player &p)
+{
+    if (!m_players)
+        return -1;
+    if (m_batchDepth > 0)
+        return m_players->append(p);
+    // Liste wurde ohne Modell erweitert: erst nachziehen
+    if (static_cast<int>(m_players->players.size()) != m_rowCount)
+        resetFromList();
+    const int row = m_rowCount;
+    beginInsertRows(QModelIndex(), row, row);
+    m_players->append(p);
+    ++m_rowCount;
+    m_eligible.append(false);
+    endInsertRows();
+    return row;
+}
+
+void PlayerTableModel::beginBatch()
+{
+    if (m_batchDepth++ == 0 && m_players && static_cast<int>(m_players->players.size()) != m_rowCount)
+        resetFromList();
+}
+
+void PlayerTableModel::endBatch()
+{
+    if (m_batchDepth == 0 || --m_batchDepth > 0 || !m_players)
+        return;
+    const int total = static_cast<int>(m_players->players.size());
+    if (total < m_rowCount)
+    {
+        resetFromList();
+        return;
+    }
+    if (total == m_rowCount)
+        return;
+    beginInsertRows(QModelIndex(), m_rowCount, total - 1);
+    m_rowCount = total;
+    m_eligible.resize(total);
+    endInsertRows();
+}
+
+bool PlayerTableModel::removePlayerAt(int row)
+{
+    if (!playerAt(row))
+        return false;
+    beginRemoveRows(QModelIndex(), row, row);
+    m_players->removeAt(row);
+    --m_rowCount;
+    m_eligible.remove(row);
+    endRemoveRows();
+    return true;
+}
+
+void PlayerTableModel::playerChanged(int row, int firstColumn, int lastColumn)
+{
+    if (row < 0 || row >= m_rowCount)
+        return;
+    emit dataChanged(index(row, firstColumn), index(row, lastColumn));
+}
+
+void PlayerTableModel::columnChanged(int column, const QList<int> &roles)
+{
+    if (m_rowCount <= 0 || column < 0 || column >= ColumnCount)
+        return;
+    emit dataChanged(index(0, column), index(m_rowCount - 1, column), roles);
+}
+
+bool PlayerTableModel::isEligible(int row) const
+{
+    return row >= 0 && row < m_eligible.size() && m_eligible.at(row);
+}
+
+void PlayerTableModel::setEligible(int row, bool eligible)
+{
+    if (row < 0 || row >= m_eligible.size() || m_eligible.at(row) == eligible)
+        return;
+    m_eligible[row] = eligible;
+    playerChanged(row, StatusColumn, StatusColumn);
+    playerChanged(row, RankColumn, RankColumn);
+}
@@ -0,0 +1,286 @@
+#include "RosterTextParser.h"
+#include <algorithm>
+
+namespace
+{
+    // Übersetzt sofort statt beim ersten match()
+    QRegularExpression compiled(const QString &pattern, QRegularExpression::PatternOptions options = QRegularExpression::NoPatternOption)
+    {
+        QRegularExpression rx(pattern, options);
+        rx.optimize();
+        return rx;
+    }
+
+    const QRegularExpression &headerRx()
+    {
+        static const QRegularExpression rx = compiled(QStringLiteral(R"((Akzeptiert|Tank|Abgelehnt)\s*\(\d+\))"),
+                                                      QRegularExpression::CaseInsensitiveOption);
+        return rx;
+    }
+
+    const QRegularExpression &dateRx()
+    {
+        static const QRegularExpression rx = compiled(QStringLiteral(R"(\b(\d{1,2})[\.\-/](\d{1,2})[\.\-/](\d{4})\b)"));
+        return rx;
+    }
+
+    // Trainings-Schlüsselwörter; alles andere gilt als Event. "training"
+    // deckt auch Clan-, Freitags- und Montagstraining ab.
+    const QRegularExpression &trainingRx()
+    {
+        static const QRegularExpression rx = compiled(QStringLiteral("training|übung|practice|drill"),
+                                                      QRegularExpression::CaseInsensitiveOption);
+        return rx;
+    }
+
+    const QRegularExpression &mapRx()
+    {
+        static const QRegularExpression rx = []
+        {
+            QStringList escaped;
+            for (const QString &map : RosterTextParser::knownMaps())
+                escaped << QRegularExpression::escape(map);
+            return compiled(escaped.join('|'), QRegularExpression::CaseInsensitiveOption);
+        }();
+        return rx;
+    }
+}
+
+RosterTextParser::RosterTextParser(const QStringList &rankPrefixes)
+{
+    // Lange Ränge zuerst, damit "Obergefreiter" nicht als "Gefreiter" zählt;
+    // nur am Wortanfang, damit "AW" in "Hawk" keinen Namen teilt
+    QStringList ranks;
+    for (const QString &rank : rankPrefixes)
+    {
+        if (!rank.isEmpty())
+            ranks << QRegularExpression::escape(rank);
+    }
+    m_signature = QStringLiteral("%1:%2").arg(Version).arg(ranks.join('|'));
+    if (ranks.isEmpty())
+        return;
+    std::stable_sort(ranks.begin(), ranks.end(), [](const QString &a, const QString &b)
+                     { return a.size() > b.size(); });
+    m_rankRx = compiled(QStringLiteral("\\b(?:%1)").arg(ranks.join('|')),
+                        QRegularExpression::CaseInsensitiveOption | QRegularExpression::UseUnicodePropertiesOption);
+}
+
+const QStringList &RosterTextParser::knownMaps()
+{
+    static const QStringList maps = {"SME", "Carentan", "Foy", "Kursk", "Stalingrad", "Omaha", "Utah",
+                                     "Purple Heart Lane", "Hill 400", "Hurtgen", "Sainte", "SMDM"};
+    return maps;
+}
+
+const QString &RosterTextParser::sectionHeader(int section)
+{
+    static const QString headers[SectionCount] = {QStringLiteral("Akzeptiert"), QStringLiteral("Tank"), QStringLiteral("Abgelehnt")};
+    return headers[section];
+}
+
+int RosterTextParser::sectionOf(const QString &line)
+{
+    const QRegularExpressionMatch header = headerRx().match(line);
+    if (!header.hasMatch())
+        return -1;
+    const QStringView name = header.capturedView(1);
+    for (int s = 0; s < SectionCount; ++s)
+    {
+        if (name.compare(sectionHeader(s), Qt::CaseInsensitive) == 0)
+            return s;
+    }
+    return -1;
+}
+
+QString RosterTextParser::normalizeName(const QString &name)
+{
+    static const QRegularExpression spaceRx = compiled(QStringLiteral("\\s+"));
+    QString c = name;
+    c.replace(spaceRx, QStringLiteral(" "));
+    c = c.trimmed();
+    return isNameLine(c) ? c : QString();
+}
+
+QStringList RosterTextParser::splitAtRanks(const QString &text) const
+{
+    const QString current = text.trimmed();
+    if (current.isEmpty())
+        return {};
+    if (m_rankRx.pattern().isEmpty())
+        return {current};
+    QList<int> starts;
+    QRegularExpressionMatchIterator it = m_rankRx.globalMatch(current);
+    while (it.hasNext())
+        starts << it.next().capturedStart();
+    if (starts.size() <= 1)
+        return {current};
+    // Text vor dem ersten Rang ist meist ein Symbol aus dem Screenshot
+    QStringList segments;
+    for (int i = 0; i < starts.size(); ++i)
+    {
+        const int end = i + 1 < starts.size() ? starts.at(i + 1) : current.size();
+        const QString segment = current.mid(starts.at(i), end - starts.at(i)).trimmed();
+        if (!segment.isEmpty())
+            segments << segment;
+    }
+    return segments;
+}
+
+QStringList RosterTextParser::splitNames(const QString &text) const
+{
+    static const QRegularExpression beforeLower = compiled(QStringLiteral("\\s+(?=[a-zäöüß])"));
+    static const QRegularExpression beforeUpper = compiled(QStringLiteral("\\s+(?=[A-ZÄÖÜ])"));
+    const QStringList ranked = splitAtRanks(text);
+    if (ranked.size() != 1)
+        return ranked;
+    const QString &current = ranked.first();
+
+    // "GefrBuddy eiben" und "Buddy Eiben" (Namen ohne Rang)
+    const QStringList lower = current.split(beforeLower, Qt::SkipEmptyParts);
+    if (lower.size() > 1)
+        return glueRanks(lower);
+    const QStringList upper = current.split(beforeUpper, Qt::SkipEmptyParts);
+    if (upper.size() > 1 && std::all_of(upper.cbegin(), upper.cend(), [](const QString &part)
+                                        { return part.trimmed().size() >= 2; }))
+        return glueRanks(upper);
+    return ranked;
+}
+
+QStringList RosterTextParser::glueRanks(const QStringList &parts) const
+{
+    // Ein allein stehender Rang ("Gefr" aus "Gefr Anton") gehört zum nächsten Teil
+    QStringList glued;
+    QString pending;
+    for (const QString &part : parts)
+    {
+        const QString trimmed = part.trimmed();
+        const QRegularExpressionMatch rank = m_rankRx.pattern().isEmpty()
+                                                 ? QRegularExpressionMatch()
+                                                 : m_rankRx.match(trimmed, 0, QRegularExpression::NormalMatch,
+                                                                  QRegularExpression::AnchorAtOffsetMatchOption);
+        if (rank.hasMatch() && rank.capturedLength() == trimmed.size())
+        {
+            pending += trimmed + QLatin1Char(' ');
+            continue;
+        }
+        glued << pending + trimmed;
+        pending.clear();
+    }
+    if (!pending.isEmpty())
+        glued << pending.trimmed();
+    return glued;
+}
+
+void RosterTextParser::addCandidates(const QString &text, QStringList &out, QSet<QString> &seen) const
+{
+    for (const QString &part : splitNames(text))
+    {
+        const QString name = normalizeName(part);
+        if (name.isEmpty() || seen.contains(name))
+            continue;
+        seen.insert(name);
+        out << name;
+    }
+}
+
+RosterTextParser::Result RosterTextParser::parse(const QStringList &lines) const
+{
+    Result result;
+    result.kinds.reserve(lines.size());
+    if (!lines.isEmpty() && lines.first().size() >= 5 && lines.first().size() <= 80)
+        result.eventName = lines.first();
+
+    QSet<QString> acceptedSeen;
+    QSet<QString> rejectedSeen;
+    int section = -1;
+    for (const QString &line : lines)
+    {
+        // Datum, Map und Training gelten einmal gefunden für den ganzen Text
+        if (!result.date.isValid())
+        {
+            QRegularExpressionMatchIterator it = dateRx().globalMatch(line);
+            while (it.hasNext() && !result.date.isValid())
+            {
+                const QRegularExpressionMatch m = it.next();
+                result.date = QDate(m.capturedView(3).toInt(), m.capturedView(2).toInt(), m.capturedView(1).toInt());
+            }
+        }
+        if (result.map.isEmpty())
+        {
+            const QRegularExpressionMatch m = mapRx().match(line);
+            if (m.hasMatch())
+            {
+                for (const QString &map : knownMaps())
+                {
+                    if (m.capturedView().compare(map, Qt::CaseInsensitive) == 0)
+                    {
+                        result.map = map;
+                        break;
+                    }
+                }
+            }
+        }
+        if (!result.training)
+            result.training = trainingRx().match(line).hasMatch();
+
+        const int header = sectionOf(line);
+        if (header >= 0)
+        {
+            section = header;
+            result.kinds << Header;
+            continue;
+        }
+        if (section < 0)
+        {
+            result.kinds << Preamble;
+            continue;
+        }
+        if (!isNameLine(line))
+        {
+            result.kinds << Noise;
+            continue;
+        }
+        result.kinds << Name;
+        // Tank ist auch eine Zusage
+        QStringList &names = section == Rejected ? result.rejected : result.accepted;
+        QSet<QString> &seen = section == Rejected ? rejectedSeen : acceptedSeen;
+        if (!seen.contains(line))
+        {
+            seen.insert(line);
+            names << line;
+        }
+    }
+
+    // Kandidaten aus den Abschnitten; ergeben sie keinen Namen (keine
+    // Abschnitte oder nur zu kurze Teile wie "Al Bo"), jede Zeile außer den
+    // Überschriften, mit Kommas getrennte Aufzählungen einzeln
+    QSet<QString> seen;
+    for (const QString &name : std::as_const(result.accepted))
+        addCandidates(name, result.candidates, seen);
+    for (const QString &name : std::as_const(result.rejected))
+        addCandidates(name, result.candidates, seen);
+    if (!result.candidates.isEmpty())
+        return result;
+    for (int i = 0; i < lines.size(); ++i)
+    {
+        if (result.kinds.at(i) == Header)
+            continue;
+        const QStringList parts = lines.at(i).split(',', Qt::SkipEmptyParts);
+        for (const QString &part : parts)
+            addCandidates(part, result.candidates, seen);
+    }
+    return result;
+}
+
+RosterTextParser::Result RosterTextParser::parse(const QString &text) const
+{
+    static const QRegularExpression newlineRx = compiled(QStringLiteral("[\\r\\n]+"));
+    QStringList lines;
+    for (const QString &line : text.split(newlineRx, Qt::SkipEmptyParts))
+    {
+        const QString trimmed = line.trimmed();
+        if (!trimmed.isEmpty())
+            lines << trimmed;
+    }
+    return parse(lines);
+}
@@ -0,0 +1,265 @@
+#include "SoldbuchLog.h"
+#include <QDataStream>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+void SoldbuchLog::setPaths(const QString &logPath, const QString &indexPath, const QString &legacyJsonPath)
+{
+    m_log.close();
+    m_index.close();
+    m_logPath = logPath;
+    m_indexPath = indexPath;
+    m_legacyPath = legacyJsonPath;
+}
+
+bool SoldbuchLog::open()
+{
+    m_log.close();
+    m_index.close();
+    m_offsets.clear();
+    m_hydrated.clear();
+    m_error.clear();
+
+    // Übernahme des alten JSON nur beim allerersten Start im neuen Format
+    const bool firstStart = !QFile::exists(m_indexPath);
+    const QFileInfo logInfo(m_logPath);
+    const qint64 logSize = logInfo.exists() ? logInfo.size() : 0;
+    qint64 lastOffset = -1;
+    if (!loadIndex(logSize, lastOffset))
+    {
+        // Kein oder unbrauchbarer Index: aus dem Log neu aufbauen
+        m_offsets.clear();
+        lastOffset = -1;
+        if (!resetIndexFile())
+            return false;
+    }
+    if (!openWriters())
+        return false;
+
+    if (logSize > 0)
+        return indexLogFrom(lastOffset);
+    if (firstStart && !m_legacyPath.isEmpty() && QFile::exists(m_legacyPath))
+        return migrateLegacy();
+    return true;
+}
+
+bool SoldbuchLog::loadIndex(qint64 logSize, qint64 &lastOffset)
+{
+    QFile f(m_indexPath);
+    if (!f.exists() || !f.open(QIODevice::ReadWrite))
+        return false;
+    QDataStream in(&f);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if (in.status() != QDataStream::Ok || magic != IndexMagic || version != IndexVersion)
+        return false;
+
+    qint64 goodEnd = f.pos();
+    while (!in.atEnd())
+    {
+        qint64 offset = -1;
+        QString key;
+        in >> offset >> key;
+        // Abgerissener Datensatz oder Index zeigt hinter das Log
+        if (in.status() != QDataStream::Ok || offset < 0 || offset >= logSize)
+            break;
+        m_offsets[key].append(offset);
+        lastOffset = qMax(lastOffset, offset);
+        goodEnd = f.pos();
+    }
+    if (f.size() > goodEnd)
+        f.resize(goodEnd);
+    return true;
+}
+
+bool SoldbuchLog::resetIndexFile()
+{
+    QFile f(m_indexPath);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        m_error = f.errorString();
+        return false;
+    }
+    QDataStream out(&f);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << IndexMagic << IndexVersion;
+    return out.status() == QDataStream::Ok;
+}
+
+bool SoldbuchLog::openWriters()
+{
+    if (m_logPath.isEmpty() || m_indexPath.isEmpty())
+        return false;
+    if (!m_log.isOpen())
+    {
+        m_log.setFileName(m_logPath);
+        if (!m_log.open(QIODevice::WriteOnly | QIODevice::Append))
+        {
+            m_error = m_log.errorString();
+            return false;
+        }
+    }
+    if (!m_index.isOpen())
+    {
+        m_index.setFileName(m_indexPath);
+        if (!m_index.open(QIODevice::WriteOnly | QIODevice::Append))
+        {
+            m_error = m_index.errorString();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SoldbuchLog::appendIndex(qint64 offset, const QString &playerKey)
+{
+    QDataStream out(&m_index);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << offset << playerKey;
+    if (out.status() != QDataStream::Ok || !m_index.flush())
+    {
+        m_error = m_index.errorString();
+        return false;
+    }
+    return true;
+}
+
+bool SoldbuchLog::indexLogFrom(qint64 lastOffset)
+{
+    QFile f(m_logPath);
+    if (!f.open(QIODevice::ReadOnly))
+    {
+        m_error = f.errorString();
+        return false;
+    }
+    // Bereits indizierte Zeile überspringen
+    if (lastOffset >= 0)
+    {
+        f.seek(lastOffset);
+        f.readLine();
+    }
+    while (!f.atEnd())
+    {
+        const qint64 pos = f.pos();
+        const QByteArray line = f.readLine();
+        if (!line.endsWith('\n'))
+        {
+            // Abgerissener letzter Eintrag
+            f.close();
+            m_log.close();
+            QFile::resize(m_logPath, pos);
+            return openWriters();
+        }
+        const QString key = QJsonDocument::fromJson(line).object().value("player").toString();
+        if (key.isEmpty())
+            continue;
+        m_offsets[key].append(pos);
+        if (!appendIndex(pos, key))
+            return false;
+    }
+    return true;
+}
+
+bool SoldbuchLog::migrateLegacy()
+{
+    QFile f(m_legacyPath);
+    if (!f.open(QIODevice::ReadOnly))
+    {
+        m_error = f.errorString();
+        return false;
+    }
+    const QJsonDocument doc = QJsonDocument::fromJson(f.readAll());
+    f.close();
+    const QJsonObject root = doc.object();
+    for (auto it = root.begin(); it != root.end(); ++it)
+    {
+        if (!it.value().isArray())
+            continue;
+        for (const QJsonValue &val : it.value().toArray())
+        {
+            if (val.isObject() && !append(it.key(), val.toObject()))
+                return false;
+        }
+    }
+    // Übernommen: beiseitelegen, damit ein gelöschter Index oder clear()
+    // es nicht erneut einspielt
+    const QString migrated = m_legacyPath + QStringLiteral(".migrated");
+    QFile::remove(migrated);
+    if (!QFile::rename(m_legacyPath, migrated))
+    {
+        m_error = QStringLiteral("%1 konnte nicht umbenannt werden").arg(m_legacyPath);
+        return false;
+    }
+    return true;
+}
+
+bool SoldbuchLog::append(const QString &playerKey, const QJsonObject &entry)
+{
+    if (playerKey.isEmpty() || !openWriters())
+        return false;
+    QJsonObject line;
+    line.insert("player", playerKey);
+    line.insert("entry", entry);
+    QByteArray bytes = QJsonDocument(line).toJson(QJsonDocument::Compact);
+    bytes.append('\n');
+    const qint64 offset = m_log.size();
+    if (m_log.write(bytes) != bytes.size() || !m_log.flush())
+    {
+        m_error = m_log.errorString();
+        return false;
+    }
+    m_offsets[playerKey].append(offset);
+    return appendIndex(offset, playerKey);
+}
+
+QList<QJsonObject> SoldbuchLog::entriesFor(const QString &playerKey) const
+{
+    QList<QJsonObject> entries;
+    const auto it = m_offsets.constFind(playerKey);
+    if (it == m_offsets.constEnd())
+        return entries;
+    QFile f(m_logPath);
+    if (!f.open(QIODevice::ReadOnly))
+        return entries;
+    m_hydrated.insert(playerKey);
+    entries.reserve(it->size());
+    for (qint64 offset : *it)
+    {
+        if (!f.seek(offset))
+            continue;
+        const QJsonObject line = QJsonDocument::fromJson(f.readLine()).object();
+        if (line.value("player").toString() == playerKey)
+            entries.append(line.value("entry").toObject());
+    }
+    return entries;
+}
+
+int SoldbuchLog::entryCount(const QString &playerKey) const
+{
+    return m_offsets.value(playerKey).size();
+}
+
+bool SoldbuchLog::clear()
+{
+    m_log.close();
+    m_index.close();
+    m_offsets.clear();
+    m_hydrated.clear();
+    QFile log(m_logPath);
+    if (log.exists() && !log.resize(0))
+    {
+        m_error = log.errorString();
+        return false;
+    }
+    // Sonst käme ein nie übernommenes altes JSON beim nächsten open() zurück
+    QFile legacy(m_legacyPath);
+    if (!m_legacyPath.isEmpty() && legacy.exists() && !legacy.remove())
+    {
+        m_error = legacy.errorString();
+        return false;
+    }
+    return resetIndexFile() && openWriters();
+}
@@ -0,0 +1,65 @@
+#include "StringPool.h"
+#include "AttendanceRecord.h"
+
+StringPool &StringPool::instance()
+{
+    static StringPool pool;
+    return pool;
+}
+
+StringPool::StringPool()
+{
+    // Reihenfolge entspricht AttendanceRecord::Type
+    intern(QString());
+    intern(QStringLiteral("training"));
+    intern(QStringLiteral("event"));
+    intern(QStringLiteral("reserve"));
+    Q_ASSERT(find(QStringLiteral("reserve")) == AttendanceRecord::Reserve);
+}
+
+quint32 StringPool::intern(const QString &text)
+{
+    {
+        QReadLocker locker(&m_lock);
+        const auto it = m_ids.constFind(text);
+        if (it != m_ids.constEnd())
+            return it.value();
+    }
+    // Gefaltete Form zuerst, damit jede ID auf eine bestehende zeigt
+    const QString foldedText = text.toCaseFolded();
+    const quint32 foldedId = foldedText == text ? NotFound : intern(foldedText);
+
+    QWriteLocker locker(&m_lock);
+    const auto it = m_ids.constFind(text);
+    if (it != m_ids.constEnd())
+        return it.value();
+    const quint32 id = quint32(m_strings.size());
+    m_strings.push_back(text);
+    m_folded.append(foldedId == NotFound ? id : foldedId);
+    m_ids.insert(text, id);
+    return id;
+}
+
+quint32 StringPool::find(const QString &text) const
+{
+    QReadLocker locker(&m_lock);
+    return m_ids.value(text, NotFound);
+}
+
+const QString &StringPool::text(quint32 id) const
+{
+    QReadLocker locker(&m_lock);
+    return id < m_strings.size() ? m_strings[id] : m_strings.front();
+}
+
+quint32 StringPool::folded(quint32 id) const
+{
+    QReadLocker locker(&m_lock);
+    return id < quint32(m_folded.size()) ? m_folded.at(id) : 0;
+}
+
+int StringPool::size() const
+{
+    QReadLocker locker(&m_lock);
+    return int(m_strings.size());
+}
@@ -0,0 +1,103 @@
+#include <QtTest/QtTest>
+#include "AttendanceHistory.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+
+class TestAttendanceHistory : public QObject
+{
+    Q_OBJECT
+private:
+    static QJsonObject entry(const QString &type, const QString &date)
+    {
+        QJsonObject obj;
+        obj.insert("type", type);
+        obj.insert("date", date);
+        return obj;
+    }
+
+private slots:
+    void test_index_parses_only_touched_players()
+    {
+        const QByteArray json =
+            "\xEF\xBB\xBF{\n"
+            "  \"Alpha\": [{\"type\": \"training\", \"date\": \"2024-01-01\"}, {\"type\": \"event\", \"name\": \"a]b\\\"}\"}],\n"
+            "  \"Br\\u00e4vo\": [],\n"
+            "  \"_journalSeq\": 17\n"
+            "}\n";
+        AttendanceHistory history;
+        QJsonObject scalars;
+        QVERIFY(history.indexJson(json, &scalars));
+        QCOMPARE(history.playerCount(), 2);
+        QVERIFY(history.contains(QString::fromUtf8("Brävo")));
+        QCOMPARE(scalars.value("_journalSeq").toInteger(), qint64(17));
+        QCOMPARE(history.hydratedCount(), 0);
+
+        QCOMPARE(history.entries("Alpha").size(), 2);
+        QCOMPARE(history.entries("Alpha").at(1).name.toString(), QStringLiteral("a]b\"}"));
+        QCOMPARE(history.entries("Alpha").first().date(), QDate(2024, 1, 1));
+        QCOMPARE(history.hydratedCount(), 1);
+        QVERIFY(history.entries("Charlie").isEmpty());
+        QCOMPARE(history.hydratedCount(), 1);
+    }
+
+    void test_append_without_hydration()
+    {
+        AttendanceHistory history;
+        QVERIFY(history.indexJson("{\"Alpha\":[{\"type\":\"training\",\"date\":\"2024-01-01\"}]}"));
+        history.append("Alpha", entry("event", "2024-01-02"));
+        history.append("Bravo", entry("training", "2024-01-03"));
+        QCOMPARE(history.hydratedCount(), 0);
+
+        // Rohbestand und angehängte Einträge in Reihenfolge, ohne zu hydrieren
+        const QJsonArray raw = QJsonDocument::fromJson(history.rawJson("Alpha")).array();
+        QCOMPARE(raw.size(), 2);
+        QCOMPARE(raw.at(1).toObject().value("type").toString(), QStringLiteral("event"));
+        QCOMPARE(history.hydratedCount(), 0);
+
+        QCOMPARE(history.entries("Alpha").size(), 2);
+        QCOMPARE(history.entries("Alpha").first().type.id(), quint32(AttendanceRecord::Training));
+        QVERIFY(history.remove("Alpha"));
+        QCOMPARE(history.hydratedCount(), 0);
+        QCOMPARE(history.playerCount(), 1);
+    }
+
+    void test_session_lookup_ignores_case()
+    {
+        AttendanceHistory history;
+        QJsonObject obj = entry("event", "2024-03-09");
+        obj.insert("name", "Clanwar Nord");
+        obj.insert("timestamp", "2024-03-09T20:15:00");
+        history.append("Alpha", obj);
+        QVERIFY(history.hasSession("Alpha", "Event", "clanwar nord", QDate(2024, 3, 9)));
+        QVERIFY(history.hasSession("Alpha", "event", QString(), QDate(2024, 3, 9)));
+        QVERIFY(!history.hasSession("Alpha", "event", "Clanwar Süd", QDate(2024, 3, 9)));
+        QVERIFY(!history.hasSession("Alpha", "training", QString(), QDate(2024, 3, 9)));
+        QVERIFY(!history.hasSession("Alpha", "event", QString(), QDate(2024, 3, 10)));
+        QVERIFY(!history.hasSession("Bravo", "event", QString(), QDate(2024, 3, 9)));
+
+        // Nach dem Hydrieren wird der Index beim Anhängen mitgeführt
+        QJsonObject later = entry("Training", "2024-03-10");
+        later.insert("name", "Abendrunde");
+        history.append("Alpha", later);
+        QVERIFY(history.hasSession("Alpha", "training", "ABENDRUNDE", QDate(2024, 3, 10)));
+        QVERIFY(history.hasSession("Alpha", "training", QString(), QDate(2024, 3, 10)));
+
+        // JSON-Grenze: Rückweg liefert dieselben Felder
+        const QJsonObject back = history.toJson(history.entries("Alpha").first());
+        QCOMPARE(back.value("name").toString(), QStringLiteral("Clanwar Nord"));
+        QCOMPARE(back.value("timestamp").toString(), QStringLiteral("2024-03-09T20:15:00"));
+        QCOMPARE(back.value("date").toString(), QStringLiteral("2024-03-09"));
+        QVERIFY(!back.contains("map"));
+    }
+
+    void test_rejects_malformed_input()
+    {
+        AttendanceHistory history;
+        QVERIFY(!history.indexJson("[1, 2]"));
+        QVERIFY(!history.indexJson("{\"Alpha\": [1, 2"));
+        QVERIFY(history.isEmpty());
+        QVERIFY(history.indexJson("{}"));
+    }
+};
+QTEST_MAIN(TestAttendanceHistory)
+#include "test_attendancehistory.moc"
@@ -0,0 +1,140 @@
+#include <QtTest/QtTest>
+#include "AttendanceJournal.h"
+#include <QTemporaryDir>
+#include <QDir>
+#include <QFile>
+
+class TestAttendanceJournal : public QObject
+{
+    Q_OBJECT
+private:
+    static QJsonObject entry(const QString &type, const QString &date)
+    {
+        QJsonObject obj;
+        obj.insert("type", type);
+        obj.insert("date", date);
+        return obj;
+    }
+
+private slots:
+    void test_append_and_replay()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        AttendanceJournal journal;
+        journal.setPaths(dir.filePath("log.json"), dir.filePath("log.jsonl"));
+        AttendanceJournal::Records records;
+        QVERIFY(journal.load(records));
+        QVERIFY(records.isEmpty());
+        QVERIFY(journal.append("Alpha", entry("training", "2024-01-01")));
+        QVERIFY(journal.append("Alpha", entry("event", "2024-01-02")));
+        QVERIFY(journal.append("Bravo", entry("training", "2024-01-01")));
+
+        AttendanceJournal reopened;
+        reopened.setPaths(dir.filePath("log.json"), dir.filePath("log.jsonl"));
+        QVERIFY(reopened.load(records));
+        QCOMPARE(reopened.replayedCount(), 3);
+        QCOMPARE(records.value("Alpha").size(), 2);
+        QCOMPARE(records.value("Alpha").at(1).type.toString(), QStringLiteral("event"));
+        QCOMPARE(records.value("Bravo").size(), 1);
+    }
+
+    void test_torn_last_line_is_dropped()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        AttendanceJournal journal;
+        journal.setPaths(dir.filePath("log.json"), dir.filePath("log.jsonl"));
+        AttendanceJournal::Records records;
+        QVERIFY(journal.load(records));
+        QVERIFY(journal.append("Alpha", entry("training", "2024-01-01")));
+        {
+            QFile f(dir.filePath("log.jsonl"));
+            QVERIFY(f.open(QIODevice::WriteOnly | QIODevice::Append));
+            f.write("{\"seq\":2,\"player\":\"Alp");
+        }
+
+        AttendanceJournal reopened;
+        reopened.setPaths(dir.filePath("log.json"), dir.filePath("log.jsonl"));
+        QVERIFY(reopened.load(records));
+        QCOMPARE(reopened.droppedLineCount(), 1);
+        QCOMPARE(records.value("Alpha").size(), 1);
+        // Nach dem Abschneiden hängen neue Zeilen sauber an
+        QVERIFY(reopened.append("Alpha", entry("event", "2024-01-03")));
+        AttendanceJournal third;
+        third.setPaths(dir.filePath("log.json"), dir.filePath("log.jsonl"));
+        QVERIFY(third.load(records));
+        QCOMPARE(third.droppedLineCount(), 0);
+        QCOMPARE(records.value("Alpha").size(), 2);
+    }
+
+    void test_read_only_journal_is_replayed()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        AttendanceJournal journal;
+        journal.setPaths(dir.filePath("log.json"), dir.filePath("log.jsonl"));
+        AttendanceJournal::Records records;
+        QVERIFY(journal.load(records));
+        QVERIFY(journal.append("Alpha", entry("training", "2024-01-01")));
+        QVERIFY(journal.append("Alpha", entry("event", "2024-01-02")));
+        QFile f(dir.filePath("log.jsonl"));
+        QVERIFY(f.setPermissions(QFileDevice::ReadOwner));
+
+        AttendanceJournal reopened;
+        reopened.setPaths(dir.filePath("log.json"), dir.filePath("log.jsonl"));
+        QVERIFY(reopened.load(records));
+        QCOMPARE(records.value("Alpha").size(), 2);
+        QCOMPARE(reopened.nextSequence(), qint64(3));
+        f.setPermissions(QFileDevice::ReadOwner | QFileDevice::WriteOwner);
+    }
+
+    void test_unreadable_journal_blocks_compaction()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        AttendanceJournal journal;
+        // Verzeichnis statt Datei: existiert, lässt sich aber nicht öffnen
+        QVERIFY(QDir(dir.path()).mkdir("log.jsonl"));
+        journal.setPaths(dir.filePath("log.json"), dir.filePath("log.jsonl"));
+        AttendanceJournal::Records records;
+        QVERIFY(!journal.load(records));
+        QVERIFY(!journal.errorString().isEmpty());
+        QVERIFY(!journal.compact(records));
+        QVERIFY(!QFile::exists(dir.filePath("log.json")));
+    }
+
+    void test_compaction_skips_already_snapshotted_lines()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        AttendanceJournal journal;
+        journal.setPaths(dir.filePath("log.json"), dir.filePath("log.jsonl"));
+        AttendanceJournal::Records records;
+        QVERIFY(journal.load(records));
+        QVERIFY(journal.append("Alpha", entry("training", "2024-01-01")));
+        records.append("Alpha", entry("training", "2024-01-01"));
+        const QByteArray before = [&]()
+        {
+            QFile f(dir.filePath("log.jsonl"));
+            return f.open(QIODevice::ReadOnly) ? f.readAll() : QByteArray();
+        }();
+        QVERIFY(journal.compact(records));
+        QCOMPARE(journal.journalLength(), 0);
+
+        // Absturz simulieren: Snapshot geschrieben, Journal nicht geleert
+        {
+            QFile f(dir.filePath("log.jsonl"));
+            QVERIFY(f.open(QIODevice::WriteOnly | QIODevice::Truncate));
+            f.write(before);
+        }
+        AttendanceJournal reopened;
+        reopened.setPaths(dir.filePath("log.json"), dir.filePath("log.jsonl"));
+        QVERIFY(reopened.load(records));
+        QCOMPARE(reopened.replayedCount(), 0);
+        QCOMPARE(records.value("Alpha").size(), 1);
+        QVERIFY(!records.contains("_journalSeq"));
+    }
+};
+QTEST_MAIN(TestAttendanceJournal)
+#include "test_attendancejournal.moc"
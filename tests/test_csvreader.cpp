@@ -0,0 +1,137 @@
+#include <QtTest/QtTest>
+#include "CsvReader.h"
+#include <QTemporaryDir>
+#include <QFile>
+
+class TestCsvReader : public QObject
+{
+    Q_OBJECT
+private:
+    static QString writeFile(const QTemporaryDir &dir, const QByteArray &content)
+    {
+        const QString path = dir.filePath("input.csv");
+        QFile f(path);
+        if (f.open(QIODevice::WriteOnly | QIODevice::Truncate))
+            f.write(content);
+        return path;
+    }
+
+private slots:
+    void test_quotes_bom_and_delimiter()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        // BOM, Semikolon, "" als Escape, Zeilenumbruch im Feld, Leerzeile, CRLF
+        const QString path = writeFile(dir, "\xEF\xBB\xBFName;Kommentar\r\n"
+                                            "Alpha; \"sagt \"\"hallo\"\"\" \r\n"
+                                            "\r\n"
+                                            "\"Bra;vo\";\"zwei\nZeilen\"\n"
+                                            "Jörg;");
+        CsvReader reader;
+        QList<QStringList> rows;
+        QVERIFY(reader.readFile(path, [&](const QStringList &cols)
+                                { rows.append(cols); return true; }));
+        QCOMPARE(reader.delimiter(), ';');
+        QCOMPARE(rows.size(), 4);
+        QCOMPARE(rows.at(0), QStringList({"Name", "Kommentar"}));
+        QCOMPARE(rows.at(1), QStringList({"Alpha", "sagt \"hallo\""}));
+        QCOMPARE(rows.at(2), QStringList({"Bra;vo", "zwei\nZeilen"}));
+        QCOMPARE(rows.at(3), QStringList({QString::fromUtf8("Jörg"), QString()}));
+    }
+
+    void test_stray_quote_stays_in_its_field()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        // " mitten im Feld ist ein Zeichen, kein Quote; die Folgezeilen bleiben eigene Datensätze
+        const QString path = writeFile(dir, "Name;Waffe\n"
+                                            "Anton;12\" Kanone\n"
+                                            "Bert;MG \"42\" schwer\n"
+                                            "Carl; \"a;b\" Rest\n"
+                                            "Dora;Karabiner\n");
+        CsvReader reader;
+        QList<QStringList> rows;
+        QVERIFY(reader.readFile(path, [&](const QStringList &cols)
+                                { rows.append(cols); return true; }));
+        QCOMPARE(rows.size(), 5);
+        QCOMPARE(rows.at(1), QStringList({"Anton", "12\" Kanone"}));
+        QCOMPARE(rows.at(2), QStringList({"Bert", "MG \"42\" schwer"}));
+        QCOMPARE(rows.at(3), QStringList({"Carl", "a;b Rest"}));
+        QCOMPARE(rows.at(4), QStringList({"Dora", "Karabiner"}));
+    }
+
+    void test_player_import_finds_header_and_merges()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString path = writeFile(dir, "Export vom 01.01.2024\n"
+                                            "Spielername\tT17-Name\tGruppe\tLevel\tTrainings gesamt\n"
+                                            "Alpha\talpha#1\tTruppA\t5\t10\n"
+                                            "\t\t\t\t\n"
+                                            "Alpha\talpha#1\tTruppA\t7\t2\n"
+                                            "Bravo\t\tTruppB\t3\t0\n");
+        PlayerList list;
+        CsvImportResult result;
+        PlayerCsvImporter importer;
+        QVERIFY(importer.importFile(path, list, result));
+        QCOMPARE(result.imported, 2);
+        QCOMPARE(result.merged, 1);
+        QCOMPARE(result.skipped, 1);
+        QCOMPARE(result.groups, QStringList({"TruppA", "TruppB"}));
+        QCOMPARE((int)list.players.size(), 2);
+        QCOMPARE(list.findByName("Alpha")->level, 7);
+        QCOMPARE(list.findByName("Alpha")->totalAttendance, 12);
+    }
+
+    void test_header_after_long_preamble()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        QByteArray content;
+        for (int i = 0; i < 25; ++i)
+            content += "# Kommentar " + QByteArray::number(i) + ";\n";
+        content += "Name;Gruppe;Level\nAlpha;TruppA;5\nBravo;TruppB;3\n";
+        const QString path = writeFile(dir, content);
+        PlayerList list;
+        CsvImportResult result;
+        PlayerCsvImporter importer;
+        QVERIFY(importer.importFile(path, list, result));
+        QCOMPARE(result.imported, 2);
+        QCOMPARE(result.skipped, 0);
+        QCOMPARE(list.findByName("Bravo")->level, 3);
+        QCOMPARE(result.groups, QStringList({"TruppA", "TruppB"}));
+    }
+
+    void test_long_file_without_header_uses_first_row()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        // Erste Zeile gilt als Kopf; mehr Zeilen als gepuffert werden
+        QByteArray content = "Nickname;Gruppe\n";
+        for (int i = 0; i < 30; ++i)
+            content += "Spieler" + QByteArray::number(i) + ";TruppA\n";
+        const QString path = writeFile(dir, content);
+        PlayerList list;
+        CsvImportResult result;
+        PlayerCsvImporter importer;
+        QVERIFY(importer.importFile(path, list, result));
+        QCOMPARE(result.imported, 30);
+        QCOMPARE((int)list.players.size(), 30);
+        QVERIFY(list.findByName("Spieler29"));
+    }
+
+    void test_missing_name_column()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString path = writeFile(dir, "Gruppe;Level\nTruppA;5\n");
+        PlayerList list;
+        CsvImportResult result;
+        PlayerCsvImporter importer;
+        QVERIFY(!importer.importFile(path, list, result));
+        QCOMPARE(result.error, CsvImportResult::NoNameColumn);
+        QVERIFY(list.players.empty());
+    }
+};
+QTEST_MAIN(TestCsvReader)
+#include "test_csvreader.moc"
@@ -0,0 +1,102 @@
+#include <QtTest/QtTest>
+#include "DataSnapshot.h"
+#include <QTemporaryDir>
+#include <QFile>
+
+class TestDataSnapshot : public QObject
+{
+    Q_OBJECT
+private:
+    static void writeFile(const QString &path, const QByteArray &bytes)
+    {
+        QFile f(path);
+        QVERIFY(f.open(QIODevice::WriteOnly));
+        f.write(bytes);
+    }
+
+    static DataSnapshot::Contents sampleContents()
+    {
+        DataSnapshot::Contents contents;
+        Player p;
+        p.name = "Alpha";
+        p.t17name = "alpha#1234";
+        p.level = 120;
+        p.group = "Fennek";
+        p.attendance = 3;
+        p.totalAttendance = 7;
+        p.joinDate = QDate(2024, 5, 1);
+        p.rank = "Gefreiter";
+        contents.players.push_back(p);
+        p.name = "Bravo";
+        p.t17name.clear();
+        p.joinDate = QDate();
+        contents.players.push_back(p);
+
+        QJsonObject entry;
+        entry.insert("type", "Training");
+        entry.insert("date", "2024-06-01");
+        entry.insert("map", "Carentan");
+        contents.attendance.append("Alpha", entry);
+        contents.attendanceNextSeq = 42;
+        contents.attendanceJournalLines = 5;
+
+        Training t;
+        t.id = "t1";
+        t.date = QDate(2024, 6, 1);
+        t.title = "Abendtraining";
+        t.maps = QStringList{"Carentan", "Foy"};
+        t.confirmedPlayers = QStringList{"Alpha"};
+        contents.trainings.append(t);
+        return contents;
+    }
+
+private slots:
+    void test_roundtrip()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        writeFile(dir.filePath("players.json"), "[]");
+        DataSnapshot snapshot;
+        snapshot.setPaths(dir.filePath("snap.bin"), {dir.filePath("players.json"), dir.filePath("missing.json")});
+        QVERIFY(snapshot.write(sampleContents()));
+
+        DataSnapshot::Contents loaded;
+        QVERIFY(snapshot.read(loaded));
+        QCOMPARE(int(loaded.players.size()), 2);
+        QCOMPARE(loaded.players[0].t17name, QStringLiteral("alpha#1234"));
+        QCOMPARE(loaded.players[0].totalAttendance, 7);
+        QCOMPARE(loaded.players[0].joinDate, QDate(2024, 5, 1));
+        QVERIFY(!loaded.players[1].joinDate.isValid());
+        QCOMPARE(loaded.attendance.hydratedCount(), 0);
+        QCOMPARE(loaded.attendance.value("Alpha").size(), 1);
+        QCOMPARE(loaded.attendance.value("Alpha").first().map.toString(), QStringLiteral("Carentan"));
+        QCOMPARE(loaded.attendanceNextSeq, qint64(42));
+        QCOMPARE(loaded.attendanceJournalLines, 5);
+        QCOMPARE(loaded.trainings.size(), 1);
+        QCOMPARE(loaded.trainings.first().maps, (QStringList{"Carentan", "Foy"}));
+    }
+
+    void test_stale_or_corrupt_is_rejected()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        writeFile(dir.filePath("players.json"), "[]");
+        DataSnapshot snapshot;
+        snapshot.setPaths(dir.filePath("snap.bin"), {dir.filePath("players.json")});
+        QVERIFY(snapshot.write(sampleContents()));
+
+        // Quelldatei geändert: Snapshot darf nicht mehr verwendet werden
+        writeFile(dir.filePath("players.json"), "[{\"name\":\"Charlie\"}]");
+        DataSnapshot::Contents loaded;
+        QVERIFY(!snapshot.read(loaded));
+        QVERIFY(loaded.players.empty());
+
+        writeFile(dir.filePath("snap.bin"), "kaputt");
+        QVERIFY(!snapshot.read(loaded));
+
+        QVERIFY(snapshot.remove());
+        QVERIFY(!QFile::exists(dir.filePath("snap.bin")));
+    }
+};
+QTEST_MAIN(TestDataSnapshot)
+#include "test_datasnapshot.moc"
@@ -0,0 +1,101 @@
+#include <QtTest/QtTest>
+#include "EditDistance.h"
+#include <QRandomGenerator>
+#include <algorithm>
+
+class TestEditDistance : public QObject
+{
+    Q_OBJECT
+private:
+    // Referenz: volle DP-Matrix wie in der früheren OCR-Hilfsfunktion
+    static int reference(const QString &s1, const QString &s2)
+    {
+        const int m = s1.size(), n = s2.size();
+        QVector<QVector<int>> dp(m + 1, QVector<int>(n + 1));
+        for (int i = 0; i <= m; ++i)
+            dp[i][0] = i;
+        for (int j = 0; j <= n; ++j)
+            dp[0][j] = j;
+        for (int i = 1; i <= m; ++i)
+        {
+            for (int j = 1; j <= n; ++j)
+            {
+                int cost = (s1[i - 1] == s2[j - 1]) ? 0 : 1;
+                dp[i][j] = std::min({dp[i - 1][j] + 1, dp[i][j - 1] + 1, dp[i - 1][j - 1] + cost});
+            }
+        }
+        return dp[m][n];
+    }
+
+    static QString randomName(QRandomGenerator &rng, int maxLength)
+    {
+        static const QString alphabet = QStringLiteral("abcäöü_");
+        QString s;
+        const int length = rng.bounded(maxLength + 1);
+        for (int i = 0; i < length; ++i)
+            s.append(alphabet.at(rng.bounded(alphabet.size())));
+        return s;
+    }
+
+private slots:
+    void test_known_values()
+    {
+        QCOMPARE(EditDistance::distance(u"kitten", u"sitting"), 3);
+        QCOMPARE(EditDistance::distance(u"", u"abc"), 3);
+        QCOMPARE(EditDistance::distance(u"Müller", u"Muller"), 1);
+        QCOMPARE(EditDistance::distance(u"gleich", u"gleich"), 0);
+        // Über der Schwelle: Schwelle + 1
+        QCOMPARE(EditDistance::distance(u"kitten", u"sitting", 2), 3);
+        QCOMPARE(EditDistance::distance(u"a", u"abcdef", 1), 2);
+        QVERIFY(EditDistance::within(u"Kaiser", u"Kaisre", 2));
+        QVERIFY(!EditDistance::within(u"Kaiser", u"Otto", 2));
+    }
+
+    void test_matches_reference()
+    {
+        QRandomGenerator rng(4711);
+        for (int i = 0; i < 3000; ++i)
+        {
+            // Bis 80 Zeichen, damit auch der Pfad ohne Bitvektor läuft
+            const QString a = randomName(rng, (i % 10 == 0) ? 80 : 20);
+            const QString b = randomName(rng, (i % 10 == 0) ? 80 : 20);
+            const int expected = reference(a, b);
+            QCOMPARE(EditDistance::distance(a, b), expected);
+            const int limit = rng.bounded(4);
+            QCOMPARE(EditDistance::distance(a, b, limit), qMin(expected, limit + 1));
+        }
+    }
+
+    void test_roster_batch()
+    {
+        const QStringList names = {"kaiser", "kaiserin", "otto", "bruno", "käiser"};
+        EditDistance::Roster roster(names);
+        QCOMPARE(roster.size(), 5);
+        QCOMPARE(roster.name(2).toString(), QStringLiteral("otto"));
+
+        QVector<int> out;
+        roster.distances(u"kaiser", 2, out);
+        QCOMPARE(out, QVector<int>({0, 2, 3, 3, 1}));
+        QCOMPARE(roster.firstWithin(u"kaisr", 1), 0);
+        QCOMPARE(roster.firstWithin(u"brunno", 1), 3);
+        QCOMPARE(roster.firstWithin(u"ludwig", 2), -1);
+
+        roster.append(u"ludwig");
+        QCOMPARE(roster.firstWithin(u"ludwik", 1), 5);
+    }
+
+    void benchmark_roster_against_candidate()
+    {
+        QRandomGenerator rng(17);
+        EditDistance::Roster roster;
+        for (int i = 0; i < 500; ++i)
+            roster.append(randomName(rng, 16));
+        QVector<int> out;
+        QBENCHMARK
+        {
+            roster.distances(u"oberfeldwebel_x", 2, out);
+        }
+    }
+};
+QTEST_MAIN(TestEditDistance)
+#include "test_editdistance.moc"
@@ -0,0 +1,122 @@
+#include <QtTest/QtTest>
+#include "EligibilityEngine.h"
+
+class TestEligibilityEngine : public QObject
+{
+    Q_OBJECT
+private:
+    static Player player()
+    {
+        Player p;
+        p.name = "Kaiser";
+        p.rank = Symbol("Gefreiter");
+        p.level = 30;
+        p.joinDate = QDate(2026, 1, 15);
+        p.attendance = 5;
+        p.events = 2;
+        p.reserve = 1;
+        return p;
+    }
+
+    static RankRequirement requirement()
+    {
+        RankRequirement req;
+        req.minMonths = 3;
+        req.minLevel = 25;
+        req.minCombined = 8;
+        return req;
+    }
+
+private slots:
+    void test_unchanged_inputs_reuse_result()
+    {
+        EligibilityEngine engine;
+        const QDate today(2026, 6, 1);
+        bool changed = false;
+        QVERIFY(engine.evaluate(player(), requirement(), today, &changed).eligible);
+        QVERIFY(changed);
+        QCOMPARE(engine.evaluationCount(), 1);
+
+        for (int i = 0; i < 3; ++i)
+        {
+            QVERIFY(engine.evaluate(player(), requirement(), today, &changed).eligible);
+            QVERIFY(!changed);
+        }
+        QCOMPARE(engine.evaluationCount(), 1);
+    }
+
+    void test_rank_change_recomputes()
+    {
+        EligibilityEngine engine;
+        const QDate today(2026, 6, 1);
+        Player p = player();
+        engine.evaluate(p, requirement(), today);
+        p.rank = Symbol("Obergefreiter");
+        bool changed = true;
+        // Gleiches Ergebnis, aber neu berechnet
+        QVERIFY(engine.evaluate(p, requirement(), today, &changed).eligible);
+        QVERIFY(!changed);
+        QCOMPARE(engine.evaluationCount(), 2);
+        engine.evaluate(p, requirement(), today);
+        QCOMPARE(engine.evaluationCount(), 2);
+    }
+
+    void test_level_change_recomputes()
+    {
+        EligibilityEngine engine;
+        const QDate today(2026, 6, 1);
+        Player p = player();
+        QVERIFY(engine.evaluate(p, requirement(), today).eligible);
+        p.level = 20;
+        bool changed = false;
+        const EligibilityResult &result = engine.evaluate(p, requirement(), today, &changed);
+        QVERIFY(changed);
+        QVERIFY(!result.eligible);
+        QCOMPARE(result.reasons, QStringList({"Level 20/25"}));
+        QCOMPARE(engine.evaluationCount(), 2);
+    }
+
+    void test_requirements_version_bump_recomputes()
+    {
+        EligibilityEngine engine;
+        const QDate today(2026, 6, 1);
+        QVERIFY(engine.evaluate(player(), requirement(), today).eligible);
+
+        // Neue Anforderung ohne Versionssprung: der Cache bleibt gültig
+        RankRequirement stricter = requirement();
+        stricter.minCombined = 20;
+        QVERIFY(engine.evaluate(player(), stricter, today).eligible);
+        QCOMPARE(engine.evaluationCount(), 1);
+
+        engine.bumpRequirementsVersion();
+        bool changed = false;
+        const EligibilityResult &result = engine.evaluate(player(), stricter, today, &changed);
+        QVERIFY(changed);
+        QVERIFY(!result.eligible);
+        QCOMPARE(result.reasons, QStringList({"T+E+R: 8/20"}));
+        QCOMPARE(engine.evaluationCount(), 2);
+    }
+
+    void test_dirty_and_remove_recompute()
+    {
+        EligibilityEngine engine;
+        const QDate today(2026, 6, 1);
+        engine.evaluate(player(), requirement(), today);
+        engine.markDirty("Kaiser");
+        engine.evaluate(player(), requirement(), today);
+        QCOMPARE(engine.evaluationCount(), 2);
+        engine.markAllDirty();
+        engine.evaluate(player(), requirement(), today);
+        QCOMPARE(engine.evaluationCount(), 3);
+        engine.remove("Kaiser");
+        bool changed = false;
+        engine.evaluate(player(), requirement(), today, &changed);
+        QVERIFY(changed);
+        QCOMPARE(engine.evaluationCount(), 4);
+        // Anderer Stichtag
+        engine.evaluate(player(), requirement(), today.addDays(1));
+        QCOMPARE(engine.evaluationCount(), 5);
+    }
+};
+QTEST_MAIN(TestEligibilityEngine)
+#include "test_eligibilityengine.moc"
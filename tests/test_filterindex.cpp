@@ -0,0 +1,81 @@
+#include <QtTest/QtTest>
+#include "PlayerFilterIndex.h"
+
+class TestFilterIndex : public QObject
+{
+    Q_OBJECT
+private:
+    static PlayerFilterIndex::Row row(const QString &name, const QString &t17, const QString &group, quint32 groupId, quint32 rankId)
+    {
+        PlayerFilterIndex::Row r;
+        r.name = name;
+        r.t17name = t17;
+        r.group = group;
+        r.groupId = groupId;
+        r.rankId = rankId;
+        return r;
+    }
+
+    static QList<int> rows(const QBitArray &bits)
+    {
+        QList<int> out;
+        for (int i = 0; i < bits.size(); ++i)
+        {
+            if (bits.testBit(i))
+                out << i;
+        }
+        return out;
+    }
+
+private slots:
+    void test_text_search_matches_linear_scan()
+    {
+        PlayerFilterIndex index;
+        index.reset(4);
+        index.setRow(0, row("Kaiser", "kaiser#1", "Fennek", 1, 10));
+        index.setRow(1, row("Kaiserin", "", "Panther", 2, 11));
+        index.setRow(2, row("Bruno", "bru#7", "KAISERGARDE", 3, 10));
+        index.setRow(3, row("Otto", "ot", "Fennek", 1, 12));
+
+        QCOMPARE(rows(index.matchText("kaise")), QList<int>({0, 1, 2}));
+        QCOMPARE(rows(index.matchText("SERIN")), QList<int>({1}));
+        QCOMPARE(rows(index.matchText("ot")), QList<int>({3}));
+        QCOMPARE(rows(index.matchText("xyz")), QList<int>());
+        QCOMPARE(rows(index.matchText(QString())), QList<int>({0, 1, 2, 3}));
+        // "ot" + "fen" aus zwei Feldern ergibt keinen Treffer
+        QCOMPARE(rows(index.matchText("ofen")), QList<int>());
+        QVERIFY(index.matchText("kaiserin").count(true) == 1);
+        QVERIFY(index.lastCandidateCount() <= 2);
+    }
+
+    void test_group_and_rank_bitsets_combine()
+    {
+        PlayerFilterIndex index;
+        index.reset(3);
+        index.setRow(0, row("A", "", "Fennek", 1, 10));
+        index.setRow(1, row("B", "", "Fennek", 1, 11));
+        index.setRow(2, row("C", "", "Panther", 2, 11));
+
+        QCOMPARE(rows(index.matchGroup(1)), QList<int>({0, 1}));
+        QCOMPARE(rows(index.matchRanks({11})), QList<int>({1, 2}));
+        QCOMPARE(rows(index.matchGroup(1) & index.matchRanks({11})), QList<int>({1}));
+        QCOMPARE(rows(index.matchGroup(99)), QList<int>());
+    }
+
+    void test_set_row_updates_all_indexes()
+    {
+        PlayerFilterIndex index;
+        index.reset(2);
+        index.setRow(0, row("Kaiser", "", "Fennek", 1, 10));
+        index.setRow(1, row("Otto", "", "Panther", 2, 10));
+        index.setRow(0, row("Ludwig", "", "Panther", 2, 11));
+
+        QCOMPARE(rows(index.matchText("kai")), QList<int>());
+        QCOMPARE(rows(index.matchText("ludw")), QList<int>({0}));
+        QCOMPARE(rows(index.matchGroup(1)), QList<int>());
+        QCOMPARE(rows(index.matchGroup(2)), QList<int>({0, 1}));
+        QCOMPARE(rows(index.matchRanks({10})), QList<int>({1}));
+    }
+};
+QTEST_MAIN(TestFilterIndex)
+#include "test_filterindex.moc"
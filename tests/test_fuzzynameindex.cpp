@@ -0,0 +1,146 @@
+#include <QtTest/QtTest>
+#include "FuzzyNameIndex.h"
+#include "EditDistance.h"
+#include "PlayerList.h"
+#include "CsvReader.h"
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+#include <QFile>
+
+class TestFuzzyNameIndex : public QObject
+{
+    Q_OBJECT
+private:
+    static QString randomName(QRandomGenerator &rng)
+    {
+        static const QString alphabet = QStringLiteral("abcdefghijklmnopqrstuvwxyz_0123456789");
+        QString s;
+        const int length = 4 + rng.bounded(10);
+        for (int i = 0; i < length; ++i)
+            s.append(alphabet.at(rng.bounded(alphabet.size())));
+        return s;
+    }
+
+private slots:
+    void test_within_matches_linear_scan()
+    {
+        QRandomGenerator rng(99);
+        FuzzyNameIndex index;
+        QStringList keys;
+        for (int i = 0; i < 2000; ++i)
+        {
+            const QString key = randomName(rng);
+            keys << key;
+            index.insert(key, key.toUpper());
+        }
+        for (int q = 0; q < 50; ++q)
+        {
+            // Gestörte Varianten vorhandener Schlüssel plus reine Zufallsanfragen
+            QString query = keys.at(rng.bounded(keys.size()));
+            if (q % 2 == 0)
+                query[rng.bounded(query.size())] = QChar(u'x');
+            else
+                query = randomName(rng);
+            for (int k = 0; k <= 2; ++k)
+            {
+                QSet<QString> expected;
+                for (const QString &key : std::as_const(keys))
+                {
+                    if (EditDistance::within(query, key, k))
+                        expected.insert(key);
+                }
+                QSet<QString> found;
+                for (const FuzzyNameIndex::Match &m : index.within(query, k))
+                {
+                    QCOMPARE(m.distance, EditDistance::distance(query, m.key));
+                    QCOMPARE(m.value, m.key.toUpper());
+                    found.insert(m.key);
+                }
+                QCOMPARE(found, expected);
+                if (k == 1)
+                    QVERIFY(index.lastComparisonCount() < keys.size() / 2);
+            }
+        }
+    }
+
+    void test_remove_and_reinsert()
+    {
+        FuzzyNameIndex index;
+        index.insert("kaiser", "Kaiser");
+        index.insert("kaiserin", "Kaiserin");
+        index.insert("kaiser", "Kaiser2");
+        QCOMPARE(index.size(), 2);
+        QCOMPARE(index.value("kaiser"), QStringLiteral("Kaiser"));
+
+        index.remove("kaiser", "Kaiser");
+        QCOMPARE(index.value("kaiser"), QStringLiteral("Kaiser2"));
+        index.remove("kaiser", "Kaiser2");
+        QVERIFY(!index.contains("kaiser"));
+        QCOMPARE(index.size(), 1);
+
+        FuzzyNameIndex::Match m;
+        QVERIFY(index.nearest("kaisr", 2, &m));
+        QCOMPARE(m.key, QStringLiteral("kaiserin"));
+        index.insert("kaiser", "Kaiser");
+        QVERIFY(index.nearest("kaisr", 2, &m));
+        QCOMPARE(m.key, QStringLiteral("kaiser"));
+        QCOMPARE(m.distance, 1);
+    }
+
+    void test_player_list_keeps_index_current()
+    {
+        PlayerList list;
+        Player a;
+        a.name = "Kaiser";
+        a.t17name = "kaiser#17";
+        list.append(a);
+        QCOMPARE(list.fuzzyIndex().size(), 2);
+
+        Player b;
+        b.name = "Ludwig";
+        list.append(b);
+        QCOMPARE(list.indexOfNameFuzzy("ludwik", 1), 1);
+        QCOMPARE(list.indexOfNameFuzzy("KAISER#71", 2), 0);
+
+        QVERIFY(list.rename("Ludwig", "Otto"));
+        QCOMPARE(list.indexOfNameFuzzy("ludwik", 1), -1);
+        QCOMPARE(list.indexOfNameFuzzy("oto", 1), 1);
+
+        list.removeAt(0);
+        QVERIFY(!list.fuzzyIndex().contains("kaiser"));
+        QCOMPARE(list.indexOfNameFuzzy("oto", 1), 0);
+
+        // Zwei ähnliche Spieler: mehrdeutig
+        Player c;
+        c.name = "Otta";
+        list.append(c);
+        QCOMPARE(list.indexOfNameFuzzy("ott", 1), -1);
+    }
+
+    void test_csv_fuzzy_merge_is_opt_in()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString path = dir.filePath("input.csv");
+        QFile f(path);
+        QVERIFY(f.open(QIODevice::WriteOnly));
+        f.write("Name;Level\nKaiser;5\nKaisre;7\n");
+        f.close();
+
+        PlayerList plain;
+        CsvImportResult result;
+        PlayerCsvImporter importer;
+        QVERIFY(importer.importFile(path, plain, result));
+        QCOMPARE(result.imported, 2);
+
+        PlayerList fuzzy;
+        importer.setFuzzyMergeDistance(2);
+        QVERIFY(importer.importFile(path, fuzzy, result));
+        QCOMPARE(result.imported, 1);
+        QCOMPARE(result.merged, 1);
+        QCOMPARE((int)fuzzy.players.size(), 1);
+        QCOMPARE(fuzzy.findByName("Kaiser")->level, 7);
+    }
+};
+QTEST_MAIN(TestFuzzyNameIndex)
+#include "test_fuzzynameindex.moc"
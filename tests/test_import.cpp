@@ -40,6 +40,72 @@ private slots:
         }
         QCOMPARE(alphaCount, 1);
     }
+
+    void test_async_import()
+    {
+        QStandardPaths::setTestModeEnabled(true);
+        MainWindow w;
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        QString path = dir.filePath("players_async.csv");
+        QFile f(path);
+        QVERIFY(f.open(QIODevice::WriteOnly | QIODevice::Text));
+        QTextStream ts(&f);
+        ts << "Name;Gruppe;Level\n";
+        for (int i = 0; i < 5000; ++i)
+            ts << "Async" << i << ";TruppAsync;" << (i % 50) << "\n";
+        f.close();
+
+        QSignalSpy finished(&w, &MainWindow::csvImportFinished);
+        QVERIFY(w.importCsvFileAsync(path));
+        QVERIFY(!w.importCsvFileAsync(path)); // nur ein Import gleichzeitig
+        QVERIFY(finished.wait(10000));
+        QCOMPARE(finished.first().first().toBool(), true);
+        QCOMPARE(w.lastCsvImportResult().imported + w.lastCsvImportResult().merged, 5000);
+        QCOMPARE(w.groupingSnapshot().value("TruppAsync").size(), 5000);
+        QVERIFY(!w.isCsvImportRunning());
+    }
+
+    void test_async_import_keeps_changes_made_while_reading()
+    {
+        QStandardPaths::setTestModeEnabled(true);
+        MainWindow w;
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        QString path = dir.filePath("players_concurrent.csv");
+        QFile f(path);
+        QVERIFY(f.open(QIODevice::WriteOnly | QIODevice::Text));
+        QTextStream ts(&f);
+        ts << "Name;Gruppe;Level\n";
+        for (int i = 0; i < 1000; ++i)
+            ts << "Parallel" << i << ";TruppParallel;5\n";
+        ts << "Bestand;TruppParallel;9\n";
+        f.close();
+
+        Player existing;
+        existing.name = "Bestand";
+        existing.group = "TruppParallel";
+        existing.level = 1;
+        w.testAddPlayer(existing);
+
+        QSignalSpy finished(&w, &MainWindow::csvImportFinished);
+        QVERIFY(w.importCsvFileAsync(path));
+        // Während der Worker liest, legt z. B. die OCR einen Spieler an
+        Player created;
+        created.name = "OcrNeu";
+        created.group = "Nicht zugewiesen";
+        w.testAddPlayer(created);
+        QVERIFY(finished.wait(10000));
+        QCOMPARE(finished.first().first().toBool(), true);
+
+        const QMap<QString, QStringList> grouped = w.groupingSnapshot();
+        QCOMPARE(grouped.value("Nicht zugewiesen"), QStringList({"OcrNeu"}));
+        QCOMPARE(grouped.value("TruppParallel").size(), 1001);
+        QCOMPARE(grouped.value("TruppParallel").count("Bestand"), 1);
+        // Bestand wird gemergt; Spieler aus früheren Läufen (Testdaten) ebenso
+        QVERIFY(w.lastCsvImportResult().merged >= 1);
+        QCOMPARE(w.lastCsvImportResult().imported + w.lastCsvImportResult().merged, 1001);
+    }
 };
 QTEST_MAIN(TestImport)
 #include "test_import.moc"
@@ -0,0 +1,136 @@
+#include <QtTest/QtTest>
+#include "OcrCache.h"
+#include <QTemporaryDir>
+#include <QFile>
+
+class TestOcrCache : public QObject
+{
+    Q_OBJECT
+private:
+    static OcrResult sample(const QString &name)
+    {
+        OcrResult r;
+        r.text = QStringLiteral("Training 12.03.2027\nAkzeptiert (1)\n%1").arg(name);
+        r.lines = r.text.split('\n');
+        r.confidence = {90, -1, 80};
+        r.roster = RosterTextParser().parse(r.lines);
+        r.roster.map = QStringLiteral("Foy");
+        r.roster.rejected = QStringList({"Ludwig"});
+        return r;
+    }
+
+private slots:
+    void test_roundtrip_keeps_metadata()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        OcrCache cache(dir.filePath("cache"));
+        const QString key = OcrCache::key(QByteArray("bild"), "deu", "tesseract 5.3.0");
+        OcrResult miss;
+        QVERIFY(!cache.lookup(key, miss));
+        QVERIFY(cache.store(key, sample("Kaiser")));
+
+        OcrResult hit;
+        hit.job = 7;
+        hit.imagePath = "upload.png";
+        QVERIFY(cache.lookup(key, hit));
+        QVERIFY(hit.fromCache);
+        QCOMPARE(hit.job, quint64(7));
+        QCOMPARE(hit.imagePath, QStringLiteral("upload.png"));
+        const OcrResult expected = sample("Kaiser");
+        QCOMPARE(hit.text, expected.text);
+        QCOMPARE(hit.lines, expected.lines);
+        QCOMPARE(hit.confidence, expected.confidence);
+        QCOMPARE(hit.roster.eventName, QStringLiteral("Training 12.03.2027"));
+        QCOMPARE(hit.roster.date, QDate(2027, 3, 12));
+        QCOMPARE(hit.roster.map, expected.roster.map);
+        QVERIFY(hit.roster.training);
+        QCOMPARE(hit.roster.accepted, QStringList({"Kaiser"}));
+        QCOMPARE(hit.roster.rejected, expected.roster.rejected);
+        QCOMPARE(hit.roster.candidates, expected.roster.candidates);
+        QCOMPARE(hit.roster.kinds, expected.roster.kinds);
+
+        // Fehlgeschlagene Erkennungen werden nicht gespeichert
+        OcrResult failed = sample("Otto");
+        failed.error = OcrResult::Failed;
+        QVERIFY(!cache.store(OcrCache::key(QByteArray("x"), "deu", "v"), failed));
+        QCOMPARE(cache.count(), 1);
+    }
+
+    void test_key_covers_content_language_and_version()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString a = dir.filePath("a.png");
+        const QString b = dir.filePath("b.png");
+        for (const QString &path : {a, b})
+        {
+            QFile f(path);
+            QVERIFY(f.open(QIODevice::WriteOnly));
+            f.write("gleicher Inhalt");
+        }
+        QCOMPARE(OcrCache::imageHash(a), OcrCache::imageHash(b));
+        QVERIFY(OcrCache::imageHash(dir.filePath("fehlt.png")).isEmpty());
+
+        const QByteArray hash = OcrCache::imageHash(a);
+        const QString base = OcrCache::key(hash, "deu", "5.3.0");
+        QVERIFY(base != OcrCache::key(hash, "eng", "5.3.0"));
+        QVERIFY(base != OcrCache::key(hash, "deu", "5.4.0"));
+        QVERIFY(base != OcrCache::key(QByteArray("anders"), "deu", "5.3.0"));
+        QCOMPARE(base, OcrCache::key(hash, "deu", "5.3.0"));
+    }
+
+    void test_lru_eviction_and_reload()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const QString path = dir.filePath("cache");
+        const QString a = OcrCache::key("a", "deu", "v");
+        const QString b = OcrCache::key("b", "deu", "v");
+        const QString c = OcrCache::key("c", "deu", "v");
+        {
+            OcrCache cache(path);
+            QVERIFY(cache.store(a, sample("Anna")));
+            const qint64 entry = cache.sizeBytes();
+            QVERIFY(entry > 0);
+            cache.setMaxBytes(entry * 2 + entry / 2);
+            QVERIFY(cache.store(b, sample("Bert")));
+            OcrResult r;
+            QVERIFY(cache.lookup(a, r)); // a ist jetzt jünger als b
+            QVERIFY(cache.store(c, sample("Carl")));
+            QCOMPARE(cache.count(), 2);
+            QVERIFY(cache.sizeBytes() <= cache.maxBytes());
+            QVERIFY(!cache.lookup(b, r));
+            QVERIFY(cache.lookup(a, r));
+            QVERIFY(cache.lookup(c, r));
+        }
+        // Nach einem Neustart liegt der Index wieder aus den Dateien vor
+        OcrCache reopened(path);
+        QCOMPARE(reopened.count(), 2);
+        OcrResult r;
+        QVERIFY(reopened.lookup(c, r));
+        QCOMPARE(r.roster.accepted, QStringList({"Carl"}));
+        reopened.clear();
+        QCOMPARE(reopened.count(), 0);
+        QCOMPARE(reopened.sizeBytes(), qint64(0));
+    }
+
+    void test_corrupt_entry_is_dropped()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        OcrCache cache(dir.path());
+        const QString key = OcrCache::key("a", "deu", "v");
+        QVERIFY(cache.store(key, sample("Anna")));
+        QFile f(dir.filePath(key + ".ocr"));
+        QVERIFY(f.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        f.write("kaputt");
+        f.close();
+        OcrResult r;
+        QVERIFY(!cache.lookup(key, r));
+        QVERIFY(!QFile::exists(dir.filePath(key + ".ocr")));
+        QCOMPARE(cache.count(), 0);
+    }
+};
+QTEST_MAIN(TestOcrCache)
+#include "test_ocrcache.moc"
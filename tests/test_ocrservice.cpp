@@ -0,0 +1,309 @@
+#include <QtTest/QtTest>
+#include "OcrService.h"
+#include "OcrCache.h"
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <QFile>
+
+class TestOcrService : public QObject
+{
+    Q_OBJECT
+private:
+    QTemporaryDir m_dir;
+    QString m_program;
+
+    QString touch(const QString &name)
+    {
+        const QString path = m_dir.filePath(name);
+        QFile f(path);
+        if (f.open(QIODevice::WriteOnly))
+            f.write("png");
+        return path;
+    }
+
+    // Bild, zu dem das Ersatzprogramm TSV mit den angegebenen Zeilen ausgibt;
+    // Wörter einer Zeile teilen sich deren Konfidenz
+    QString page(const QString &name, const QList<QPair<QString, int>> &lines)
+    {
+        const QString path = touch(name);
+        QFile f(path + ".tsv");
+        if (f.open(QIODevice::WriteOnly))
+        {
+            f.write("level\tpage_num\tblock_num\tpar_num\tline_num\tword_num\tleft\ttop\twidth\theight\tconf\ttext\n");
+            for (int l = 0; l < lines.size(); ++l)
+            {
+                f.write(QStringLiteral("4\t1\t1\t1\t%1\t0\t0\t0\t10\t10\t-1\t\n").arg(l + 1).toUtf8());
+                const QStringList words = lines.at(l).first.split(' ');
+                for (int w = 0; w < words.size(); ++w)
+                {
+                    f.write(QStringLiteral("5\t1\t1\t1\t%1\t%2\t0\t0\t10\t10\t%3\t%4\n")
+                                .arg(l + 1)
+                                .arg(w + 1)
+                                .arg(lines.at(l).second)
+                                .arg(words.at(w))
+                                .toUtf8());
+                }
+            }
+        }
+        return path;
+    }
+
+    // Sucht das Ergebnis zu job unter den bisherigen und neuen Signalen
+    static OcrResult waitForResult(QSignalSpy &spy, quint64 job)
+    {
+        for (int attempt = 0; attempt < 100; ++attempt)
+        {
+            for (int i = 0; i < spy.size(); ++i)
+            {
+                const OcrResult result = spy.at(i).first().value<OcrResult>();
+                if (result.job == job)
+                    return result;
+            }
+            spy.wait(200);
+        }
+        return OcrResult();
+    }
+
+private slots:
+    void initTestCase()
+    {
+#ifdef Q_OS_WIN
+        QSKIP("Ersatzprogramm ist ein Shell-Skript");
+#endif
+        if (OcrService::hasInProcessEngine())
+            QSKIP("Mit libtesseract wird kein externes Programm gestartet");
+        QVERIFY(m_dir.isValid());
+        // Ersatz für tesseract: Sprachliste, langsame Bilder und eine feste Liste
+        m_program = m_dir.filePath("fake-tesseract");
+        QFile script(m_program);
+        QVERIFY(script.open(QIODevice::WriteOnly));
+        script.write("#!/bin/sh\n"
+                     "if [ \"$1\" = \"--list-langs\" ]; then\n"
+                     "  echo 'List of available languages (2):'\n"
+                     "  echo deu\n"
+                     "  echo eng\n"
+                     "  exit 0\n"
+                     "fi\n"
+                     "if [ \"$1\" = \"--version\" ]; then echo 'tesseract 5.3.0'; exit 0; fi\n"
+                     "echo \"$OMP_THREAD_LIMIT\" > \"$0.omp\"\n"
+                     "echo \"$1\" >> \"$0.calls\"\n"
+                     "case \"$1\" in *slow*) sleep 10 ;; esac\n"
+                     "if [ -f \"$1.tsv\" ]; then cat \"$1.tsv\"; exit 0; fi\n"
+                     "printf 'Zusagen\\n\\nKaiser\\nOtto\\nab\\n'\n");
+        script.close();
+        script.setPermissions(script.permissions() | QFileDevice::ExeOwner);
+    }
+
+    void test_result_arrives_by_signal()
+    {
+        OcrService service;
+        service.setProgram(m_program);
+        QSignalSpy finished(&service, &OcrService::finished);
+        const quint64 job = service.recognize(touch("list.png"));
+        QVERIFY(job != 0);
+        QCOMPARE(service.pendingCount(), 1);
+        QVERIFY(finished.isEmpty());
+
+        const OcrResult result = waitForResult(finished, job);
+        QCOMPARE(result.job, job);
+        QVERIFY2(result.ok(), qPrintable(result.errorString));
+        QCOMPARE(result.lines, QStringList({"Zusagen", "Kaiser", "Otto", "ab"}));
+        QCOMPARE(service.pendingCount(), 0);
+
+        // Parallele Prozesse ohne eigene OpenMP-Threads
+        QFile omp(m_program + ".omp");
+        QVERIFY(omp.open(QIODevice::ReadOnly));
+        QCOMPARE(omp.readAll().trimmed(), QByteArray("1"));
+    }
+
+    void test_cancel_stops_running_job()
+    {
+        OcrService service;
+        service.setProgram(m_program);
+        QSignalSpy finished(&service, &OcrService::finished);
+        const quint64 slow = service.recognize(touch("slow.png"));
+        const quint64 queued = service.recognize(touch("list.png"));
+        QTest::qWait(300);
+        QElapsedTimer timer;
+        timer.start();
+        service.cancel(slow);
+        const OcrResult first = waitForResult(finished, slow);
+        QCOMPARE(first.error, OcrResult::Canceled);
+        QVERIFY(timer.elapsed() < 5000);
+        // Der nächste Auftrag läuft danach normal
+        QVERIFY(waitForResult(finished, queued).ok());
+    }
+
+    void test_missing_language_and_program()
+    {
+        OcrService service;
+        service.setProgram(m_program);
+        QSignalSpy finished(&service, &OcrService::finished);
+        service.setLanguage("klingon");
+        QCOMPARE(waitForResult(finished, service.recognize(touch("list.png"))).error, OcrResult::LanguageMissing);
+
+        service.setLanguage("deu+eng");
+        QVERIFY(waitForResult(finished, service.recognize(touch("list.png"))).ok());
+
+        service.setProgram(m_dir.filePath("gibt-es-nicht"));
+        QCOMPARE(waitForResult(finished, service.recognize(touch("list.png"))).error, OcrResult::EngineMissing);
+        QCOMPARE(waitForResult(finished, service.recognize(m_dir.filePath("fehlt.png"))).error, OcrResult::ImageUnreadable);
+    }
+
+    void test_tsv_lines_carry_confidence()
+    {
+        OcrService service;
+        service.setProgram(m_program);
+        QSignalSpy finished(&service, &OcrService::finished);
+        const QString path = page("tsv.png", {{"Training Freitag", 88}, {"Kaiser", 91}});
+        const OcrResult result = waitForResult(finished, service.recognize(path));
+        QVERIFY2(result.ok(), qPrintable(result.errorString));
+        QCOMPARE(result.lines, QStringList({"Training Freitag", "Kaiser"}));
+        QCOMPARE(result.confidence, QList<int>({88, 91}));
+        QCOMPARE(result.text, QStringLiteral("Training Freitag\nKaiser"));
+    }
+
+    void test_batch_merges_pages_by_confidence()
+    {
+        OcrService service;
+        service.setProgram(m_program);
+        QVERIFY(service.workerCount() >= 1);
+        QSignalSpy finished(&service, &OcrService::finished);
+        const QString first = page("batch1.png", {{"Training 12.03.2027", 90},
+                                                  {"Akzeptiert (2)", 90},
+                                                  {"Kaiser", 90},
+                                                  {"Otto", 40}});
+        // Folgeseite: Kopf wiederholt, Tank-Abschnitt, Otto hier sicherer erkannt
+        const QString second = page("batch2.png", {{"Training 12.03.2027", 90},
+                                                   {"Tank (1)", 90},
+                                                   {"Otto", 95},
+                                                   {"Abgelehnt (2)", 90},
+                                                   {"KAISER", 50},
+                                                   {"Ludwig", 80}});
+        const QString missing = m_dir.filePath("batch3.png");
+        const quint64 batch = service.recognizeBatch({first, second, missing});
+
+        const OcrResult merged = waitForResult(finished, batch);
+        QVERIFY2(merged.ok(), qPrintable(merged.errorString));
+        QCOMPARE(merged.lines, QStringList({"Training 12.03.2027", "Akzeptiert (1)", "Kaiser", "Tank (1)", "Otto",
+                                            "Abgelehnt (1)", "Ludwig"}));
+        QCOMPARE(merged.confidence, QList<int>({90, -1, 90, -1, 95, -1, 80}));
+        // Die fehlende Seite bricht den Stapel nicht ab, wird aber gemeldet
+        QVERIFY(merged.errorString.contains("batch3.png"));
+        QCOMPARE(service.pendingCount(), 0);
+    }
+
+    void test_batch_cancel_and_failure()
+    {
+        OcrService service;
+        service.setProgram(m_program);
+        QSignalSpy finished(&service, &OcrService::finished);
+        const quint64 batch = service.recognizeBatch({touch("slow1.png"), touch("slow2.png")});
+        QTest::qWait(300);
+        service.cancel(batch);
+        QCOMPARE(waitForResult(finished, batch).error, OcrResult::Canceled);
+
+        // Keine Seite lesbar: der Fehler der ersten Seite gilt für den Stapel
+        const quint64 broken = service.recognizeBatch({m_dir.filePath("weg1.png"), m_dir.filePath("weg2.png")});
+        QCOMPARE(waitForResult(finished, broken).error, OcrResult::ImageUnreadable);
+    }
+
+    void test_metadata_and_cache_hit()
+    {
+        QTemporaryDir cacheDir;
+        QVERIFY(cacheDir.isValid());
+        OcrService service;
+        service.setProgram(m_program);
+        service.setCache(std::make_shared<OcrCache>(cacheDir.path()));
+        QSignalSpy finished(&service, &OcrService::finished);
+        const QString path = page("cached.png", {{"Training Foy 12.03.2027", 90},
+                                                 {"Akzeptiert (2)", 90},
+                                                 {"Kaiser", 90},
+                                                 {"ab", 90},
+                                                 {"Tank (1)", 90},
+                                                 {"Otto", 90},
+                                                 {"Abgelehnt (1)", 90},
+                                                 {"Ludwig", 90}});
+        QFile calls(m_program + ".calls");
+        calls.remove();
+
+        const OcrResult first = waitForResult(finished, service.recognize(path));
+        QVERIFY2(first.ok(), qPrintable(first.errorString));
+        QVERIFY(!first.fromCache);
+        QCOMPARE(first.roster.eventName, QStringLiteral("Training Foy 12.03.2027"));
+        QCOMPARE(first.roster.date, QDate(2027, 3, 12));
+        QCOMPARE(first.roster.map, QStringLiteral("Foy"));
+        QVERIFY(first.roster.training);
+        QCOMPARE(first.roster.accepted, QStringList({"Kaiser", "Otto"}));
+        QCOMPARE(first.roster.rejected, QStringList({"Ludwig"}));
+        QCOMPARE(first.roster.candidates, QStringList({"Kaiser", "Otto", "Ludwig"}));
+
+        // Gleicher Inhalt unter anderem Namen: Treffer ohne Tesseract-Lauf
+        const QString copy = m_dir.filePath("cached-copy.png");
+        QFile::remove(copy);
+        QVERIFY(QFile::copy(path, copy));
+        const OcrResult second = waitForResult(finished, service.recognize(copy));
+        QVERIFY(second.ok());
+        QVERIFY(second.fromCache);
+        QCOMPARE(second.imagePath, copy);
+        QCOMPARE(second.lines, first.lines);
+        QCOMPARE(second.roster.accepted, first.roster.accepted);
+        QCOMPARE(second.roster.kinds, first.roster.kinds);
+        QVERIFY(calls.open(QIODevice::ReadOnly));
+        QCOMPARE(calls.readAll().count('\n'), 1);
+        calls.close();
+
+        // Andere Ränge, andere Auswertung: neuer Schlüssel
+        service.setRosterParser(std::make_shared<const RosterTextParser>(QStringList({"Gefr"})));
+        QVERIFY(!waitForResult(finished, service.recognize(copy)).fromCache);
+        QVERIFY(waitForResult(finished, service.recognize(copy)).fromCache);
+
+        // Andere Sprache, anderer Schlüssel
+        service.setLanguage("eng");
+        QVERIFY(!waitForResult(finished, service.recognize(copy)).fromCache);
+    }
+
+    void test_preprocessed_image_is_passed_to_program()
+    {
+        OcrService service;
+        service.setProgram(m_program);
+        service.setPreprocessing(true);
+        QSignalSpy finished(&service, &OcrService::finished);
+        QFile calls(m_program + ".calls");
+        const auto lastCall = [&calls]()
+        {
+            if (!calls.open(QIODevice::ReadOnly))
+                return QString();
+            const QStringList lines = QString::fromUtf8(calls.readAll()).split('\n', Qt::SkipEmptyParts);
+            calls.close();
+            return lines.isEmpty() ? QString() : lines.last();
+        };
+
+        QImage image(200, 100, QImage::Format_RGB32);
+        image.fill(Qt::white);
+        const QString real = m_dir.filePath("real.png");
+        QVERIFY(image.save(real));
+        QVERIFY(waitForResult(finished, service.recognize(real)).ok());
+        QVERIFY2(lastCall().endsWith(".pgm"), qPrintable(lastCall()));
+
+        // Kein Bild für Qt: Tesseract bekommt die Datei unverändert
+        const QString raw = touch("raw.png");
+        QVERIFY(waitForResult(finished, service.recognize(raw)).ok());
+        QCOMPARE(lastCall(), raw);
+    }
+
+    void test_merge_without_sections_deduplicates()
+    {
+        OcrResult a;
+        a.lines = QStringList({"Kaiser", "Otto"});
+        OcrResult b;
+        b.lines = QStringList({"otto", "Ludwig"});
+        const OcrResult merged = OcrService::mergePages({a, b});
+        QVERIFY(merged.ok());
+        QCOMPARE(merged.lines, QStringList({"Kaiser", "Otto", "Ludwig"}));
+        QCOMPARE(merged.confidence, QList<int>({-1, -1, -1}));
+        QCOMPARE(merged.roster.candidates, QStringList({"Kaiser", "Otto", "Ludwig"}));
+    }
+};
+QTEST_MAIN(TestOcrService)
+#include "test_ocrservice.moc"
@@ -0,0 +1,82 @@
+#include <QtTest/QtTest>
+#include "PersistenceScheduler.h"
+#include "MainWindow.h"
+#include <QTemporaryDir>
+#include <QFile>
+#include <QTextStream>
+
+class TestPersistence : public QObject
+{
+    Q_OBJECT
+private slots:
+    void test_marks_coalesce_per_event_loop_turn()
+    {
+        PersistenceScheduler scheduler;
+        int writes = 0;
+        scheduler.registerStore("players", [&writes]()
+                                { ++writes; });
+        for (int i = 0; i < 60; ++i)
+            scheduler.markDirty("players");
+        QVERIFY(scheduler.isDirty("players"));
+        QCOMPARE(writes, 0);
+        QTRY_COMPARE(writes, 1);
+        QCOMPARE(scheduler.markCount("players"), 60);
+        QCOMPARE(scheduler.flushCount("players"), 1);
+        QVERIFY(!scheduler.hasPending());
+        QVERIFY(scheduler.totalFlushNsecs("players") >= scheduler.lastFlushNsecs("players"));
+    }
+
+    void test_debounce_window_and_explicit_flush()
+    {
+        PersistenceScheduler scheduler;
+        scheduler.setDebounceInterval(10000);
+        int writes = 0;
+        scheduler.registerStore("attendance", [&writes]()
+                                { ++writes; });
+        scheduler.markDirty("attendance");
+        QTest::qWait(20);
+        QCOMPARE(writes, 0);
+        scheduler.flush("attendance");
+        QCOMPARE(writes, 1);
+        scheduler.flush("attendance"); // nichts vorgemerkt
+        QCOMPARE(writes, 1);
+    }
+
+    void test_flush_on_destruction()
+    {
+        int writes = 0;
+        {
+            PersistenceScheduler scheduler;
+            scheduler.setDebounceInterval(10000);
+            scheduler.registerStore("soldbuch", [&writes]()
+                                    { ++writes; });
+            scheduler.markDirty("soldbuch");
+        }
+        QCOMPARE(writes, 1);
+    }
+
+    void test_main_window_saves_once_per_turn()
+    {
+        QStandardPaths::setTestModeEnabled(true);
+        MainWindow w;
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        QString path = dir.filePath("players.csv");
+        QFile f(path);
+        QVERIFY(f.open(QIODevice::WriteOnly | QIODevice::Text));
+        QTextStream ts(&f);
+        ts << "Name;Gruppe;Level\n";
+        ts << "Persist1;TruppP;5\n";
+        f.close();
+
+        PersistenceScheduler &scheduler = w.persistenceScheduler();
+        QCoreApplication::processEvents();
+        scheduler.resetStats();
+        QVERIFY(w.importCsvFile(path));
+        QVERIFY(w.importCsvFile(path));
+        QCOMPARE(scheduler.flushCount(MainWindow::PlayersStore), 0);
+        QTRY_COMPARE(scheduler.flushCount(MainWindow::PlayersStore), 1);
+    }
+};
+QTEST_MAIN(TestPersistence)
+#include "test_persistence.moc"
@@ -0,0 +1,47 @@
+#include <QtTest/QtTest>
+#include "PlayerList.h"
+
+class TestPlayerList : public QObject
+{
+    Q_OBJECT
+private slots:
+    void test_lookup_and_merge()
+    {
+        PlayerList list;
+        Player a; a.name = "Alpha"; a.t17name = "alpha#1"; a.level = 5;
+        Player b; b.name = "Bravo"; b.level = 3;
+        list.addOrMerge(a);
+        list.addOrMerge(b);
+        QCOMPARE(list.indexOfName("Alpha"), 0);
+        QCOMPARE(list.indexOfT17("alpha#1"), 0);
+        QCOMPARE(list.indexOfNameInsensitive("  bravo "), 1);
+
+        // Merge über T17-Namen, auch wenn der Anzeigename abweicht
+        Player a2; a2.name = "Alpha2"; a2.t17name = "alpha#1"; a2.level = 9;
+        list.addOrMerge(a2);
+        QCOMPARE((int)list.players.size(), 2);
+        QCOMPARE(list.findByName("Alpha")->level, 9);
+    }
+
+    void test_rename_and_remove_keep_index()
+    {
+        PlayerList list;
+        for (const char *n : {"Alpha", "Bravo", "Charlie"})
+        {
+            Player p; p.name = n;
+            list.append(p);
+        }
+        QVERIFY(list.rename("Bravo", "Delta"));
+        QCOMPARE(list.indexOfName("Bravo"), -1);
+        QCOMPARE(list.indexOfName("Delta"), 1);
+        QCOMPARE(list.indexOfNameInsensitive("DELTA"), 1);
+
+        QVERIFY(list.removeByName("Alpha"));
+        QCOMPARE(list.indexOfName("Alpha"), -1);
+        QCOMPARE(list.indexOfName("Delta"), 0);
+        QCOMPARE(list.indexOfName("Charlie"), 1);
+        QVERIFY(!list.removeByName("Alpha"));
+    }
+};
+QTEST_MAIN(TestPlayerList)
+#include "test_playerlist.moc"
@@ -0,0 +1,169 @@
+#include <QtTest/QtTest>
+#include "OcrPreprocessor.h"
+#include <QPainter>
+#include <QRandomGenerator>
+#include <cstdlib>
+#include <vector>
+
+class TestPreprocessor : public QObject
+{
+    Q_OBJECT
+private:
+    // Dunkles Design wie in Discord: Seitenleiste links, Liste in der Mitte.
+    // "Schrift" sind 2 px breite Striche im Abstand von 4 px.
+    static QImage screenshot(int width, int height, int lineHeight)
+    {
+        QImage image(width, height, QImage::Format_RGB32);
+        image.fill(QColor(0x36, 0x39, 0x3f));
+        QPainter p(&image);
+        p.fillRect(0, 0, width, 40, QColor(0x20, 0x22, 0x25)); // Titelleiste ohne Schrift
+        const int listLeft = width * 3 / 8;
+        const int listRight = width * 3 / 4;
+        for (int line = 0; line < 12; ++line)
+        {
+            const int y = 100 + line * lineHeight * 2;
+            if (y + lineHeight >= height)
+                break;
+            for (int x = listLeft; x < listRight; x += 4)
+                p.fillRect(x, y, 2, lineHeight, QColor(0xdc, 0xdd, 0xde));
+            if (line < 3)
+            {
+                for (int x = 10; x < 60; x += 4)
+                    p.fillRect(x, y, 2, lineHeight, QColor(0x8e, 0x92, 0x97));
+            }
+        }
+        return image;
+    }
+
+private slots:
+    void test_kernels_match_scalar_reference()
+    {
+        QRandomGenerator rng(7);
+        for (int round = 0; round < 200; ++round)
+        {
+            const int n = rng.bounded(0, 100);
+            std::vector<quint32> argb(n);
+            std::vector<quint8> gray(n + 1, 0xab);
+            for (quint32 &px : argb)
+                px = rng.generate();
+            OcrPreprocessor::toGray(argb.data(), gray.data(), n);
+            for (int i = 0; i < n; ++i)
+            {
+                const quint32 px = argb[i];
+                const int expected = (77 * ((px >> 16) & 0xff) + 150 * ((px >> 8) & 0xff) + 29 * (px & 0xff) + 128) >> 8;
+                QCOMPARE(int(gray[i]), expected);
+            }
+            QCOMPARE(int(gray[n]), 0xab); // kein Schreiben über das Ende
+
+            std::vector<quint8> src(n);
+            for (quint8 &v : src)
+                v = quint8(rng.bounded(256));
+            const quint8 level = quint8(rng.bounded(256));
+            const bool invert = round % 2;
+            std::vector<quint8> dst(n);
+            OcrPreprocessor::threshold(src.data(), dst.data(), n, level, invert);
+            for (int i = 0; i < n; ++i)
+                QCOMPARE(int(dst[i]), (src[i] > level) != invert ? 255 : 0);
+
+            std::vector<quint8> mask(n + 1, 7);
+            const quint8 delta = quint8(rng.bounded(256));
+            int expectedCount = 0;
+            const int count = OcrPreprocessor::edgeMask(src.data(), mask.data(), n, delta);
+            for (int i = 0; i + 1 < n; ++i)
+            {
+                const int edge = std::abs(int(src[i + 1]) - int(src[i])) > delta ? 1 : 0;
+                QCOMPARE(int(mask[i]), edge);
+                expectedCount += edge;
+            }
+            QCOMPARE(count, expectedCount);
+            if (n > 0)
+                QCOMPARE(int(mask[n - 1]), 0);
+
+            quint32 hist[256] = {};
+            OcrPreprocessor::histogram(src.data(), n, hist);
+            OcrPreprocessor::histogram(src.data(), n, hist);
+            quint32 expectedHist[256] = {};
+            for (quint8 v : src)
+                expectedHist[v] += 2;
+            for (int v = 0; v < 256; ++v)
+                QCOMPARE(hist[v], expectedHist[v]);
+        }
+    }
+
+    void test_otsu_splits_bimodal_histogram()
+    {
+        quint32 hist[256] = {};
+        hist[40] = 700;
+        hist[45] = 100;
+        hist[200] = 300;
+        const int level = OcrPreprocessor::otsuThreshold(hist);
+        QVERIFY(level >= 45 && level < 200);
+        quint32 empty[256] = {};
+        QCOMPARE(OcrPreprocessor::otsuThreshold(empty), 127);
+    }
+
+    void test_crops_scales_and_binarizes_dark_screenshot()
+    {
+        const QImage source = screenshot(800, 600, 10);
+        const OcrPreprocessor::Result result = OcrPreprocessor::process(source);
+
+        // Liste liegt bei x 300..597, y 100..329; Seitenleiste fällt weg
+        QVERIFY(result.region.contains(QRect(300, 100, 298, 230)));
+        QVERIFY(result.region.left() > 60);
+        QVERIFY(result.region.top() > 40);
+        QVERIFY(result.region.width() < 400);
+        QCOMPARE(result.textHeight, 10);
+        QCOMPARE(result.scale, 3.2);
+        QCOMPARE(result.image.format(), QImage::Format_Grayscale8);
+        QCOMPARE(result.image.width(), qRound(result.region.width() * 3.2));
+
+        // Dunkler Grund wird weiß, helle Schrift schwarz
+        QVERIFY(result.inverted);
+        QCOMPARE(qGray(result.image.pixel(0, 0)), 255);
+        const QPoint stroke(qRound((300 - result.region.left()) * 3.2 + 3), qRound((105 - result.region.top()) * 3.2));
+        QCOMPARE(qGray(result.image.pixel(stroke)), 0);
+        for (int y = 0; y < result.image.height(); y += 7)
+        {
+            const quint8 *line = result.image.constScanLine(y);
+            for (int x = 0; x < result.image.width(); ++x)
+                QVERIFY(line[x] == 0 || line[x] == 255);
+        }
+    }
+
+    void test_large_text_and_blank_images_stay_unscaled()
+    {
+        const OcrPreprocessor::Result large = OcrPreprocessor::process(screenshot(1600, 1200, 24));
+        QCOMPARE(large.textHeight, 24);
+        QCOMPARE(large.scale, 1.0);
+
+        QImage blank(300, 200, QImage::Format_RGB32);
+        blank.fill(Qt::white);
+        const OcrPreprocessor::Result empty = OcrPreprocessor::process(blank);
+        QCOMPARE(empty.region, blank.rect());
+        QCOMPARE(empty.textHeight, 0);
+        QCOMPARE(empty.image.size(), blank.size());
+
+        QVERIFY(OcrPreprocessor::process(QImage()).image.isNull());
+
+        OcrPreprocessor::Options keep;
+        keep.crop = false;
+        keep.binarize = false;
+        const OcrPreprocessor::Result plain = OcrPreprocessor::process(screenshot(800, 600, 24), keep);
+        QCOMPARE(plain.region, QRect(0, 0, 800, 600));
+        QCOMPARE(plain.threshold, -1);
+    }
+
+    void benchmark_full_hd_screenshot()
+    {
+        const QImage source = screenshot(1920, 1080, 12);
+        OcrPreprocessor::Result result;
+        QBENCHMARK
+        {
+            result = OcrPreprocessor::process(source);
+        }
+        // Ausschnitt ist deutlich kleiner als das Bild
+        QVERIFY(qint64(result.region.width()) * result.region.height() < qint64(source.width()) * source.height() / 2);
+    }
+};
+QTEST_MAIN(TestPreprocessor)
+#include "test_preprocessor.moc"
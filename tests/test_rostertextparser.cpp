@@ -0,0 +1,160 @@
+#include <QtTest/QtTest>
+#include "RosterTextParser.h"
+
+class TestRosterTextParser : public QObject
+{
+    Q_OBJECT
+private:
+    static QStringList ranks()
+    {
+        return {"AW", "Gefreiter", "Gefr", "Obergefreiter", "OGefr", "Uffz", "Fähnrich"};
+    }
+
+    // Erkannter Text eines Event-Screenshots wie aus Tesseract
+    static QStringList screenshot(int index, int names)
+    {
+        static const QStringList rankNames = {"Gefr", "Uffz", "OGefr", "Fähnrich", "Obergefreiter"};
+        QStringList lines;
+        lines << QStringLiteral("Clanabend %1 gegen Team %2").arg(index).arg(index % 7);
+        lines << QStringLiteral("Sonntag, %1.03.2027 20:00").arg(1 + index % 28);
+        lines << QStringLiteral("Map: %1").arg(index % 2 ? "Carentan" : "Hill 400");
+        const int accepted = names * 2 / 3;
+        lines << QStringLiteral("Akzeptiert (%1)").arg(accepted);
+        for (int i = 0; i < names; ++i)
+        {
+            if (i == accepted)
+                lines << QStringLiteral("Abgelehnt (%1)").arg(names - accepted);
+            const QString name = QStringLiteral("%1 Spieler%2x%3").arg(rankNames.at(i % rankNames.size())).arg(index).arg(i);
+            // Jede fünfte Zeile enthält zwei Namen, die OCR zusammengezogen hat
+            if (i % 5 == 4)
+                lines << name + QStringLiteral("  Uffz Nachbar%1").arg(i);
+            else
+                lines << name;
+            if (i % 11 == 0)
+                lines << QStringLiteral("•");
+        }
+        return lines;
+    }
+
+private slots:
+    void test_sections_and_metadata_in_one_pass()
+    {
+        const QStringList lines = {
+            "Freitagstraining Infanterie",
+            "12.03.2027 um 20:00, Map carentan",
+            "Akzeptiert (2)",
+            "Gefr Anton",
+            "Uffz Bert",
+            "Tank (1)",
+            "Carl",
+            "Gefr Anton",
+            "Abgelehnt (1)",
+            "Dora",
+            "x",
+        };
+        const RosterTextParser parser(ranks());
+        const RosterTextParser::Result r = parser.parse(lines);
+        QCOMPARE(r.eventName, QStringLiteral("Freitagstraining Infanterie"));
+        QCOMPARE(r.date, QDate(2027, 3, 12));
+        QCOMPARE(r.map, QStringLiteral("Carentan"));
+        QVERIFY(r.training);
+        QCOMPARE(r.accepted, QStringList({"Gefr Anton", "Uffz Bert", "Carl"}));
+        QCOMPARE(r.rejected, QStringList({"Dora"}));
+        QCOMPARE(r.candidates, QStringList({"Gefr Anton", "Uffz Bert", "Carl", "Dora"}));
+
+        using K = RosterTextParser::LineKind;
+        const QList<K> kinds = {K::Preamble, K::Preamble, K::Header, K::Name, K::Name, K::Header,
+                                K::Name, K::Name, K::Header, K::Name, K::Noise};
+        QCOMPARE(r.kinds, kinds);
+    }
+
+    void test_event_type_date_and_map_fallbacks()
+    {
+        const RosterTextParser parser;
+        const RosterTextParser::Result event = parser.parse(QStringList({"Event vs Clan X", "31.02.2027 oder 01.03.2027"}));
+        QVERIFY(!event.training);
+        QCOMPARE(event.date, QDate(2027, 3, 1)); // ungültiges Datum übersprungen
+        QVERIFY(event.map.isEmpty());
+
+        QVERIFY(parser.parse(QStringList({"ÜBUNG am Abend"})).training);
+        QCOMPARE(parser.parse(QStringList({"Abend"})).eventName, QStringLiteral("Abend"));
+        QVERIFY(parser.parse(QStringList({"Foy"})).eventName.isEmpty()); // zu kurz für einen Titel
+        QCOMPARE(parser.parse(QStringList({"Hill 400 / SME"})).map, QStringLiteral("Hill 400"));
+        QVERIFY(parser.parse(QStringList()).candidates.isEmpty());
+    }
+
+    void test_rank_splitting()
+    {
+        const RosterTextParser parser(ranks());
+        QCOMPARE(parser.splitAtRanks("Gefr Anton Uffz Bert"), QStringList({"Gefr Anton", "Uffz Bert"}));
+        QCOMPARE(parser.splitAtRanks("  GefrAnton UffzBert OGefr Carl "), QStringList({"GefrAnton", "UffzBert", "OGefr Carl"}));
+        // Längster Rang gewinnt, nur am Wortanfang
+        QCOMPARE(parser.splitAtRanks("Obergefreiter Max"), QStringList({"Obergefreiter Max"}));
+        QCOMPARE(parser.splitAtRanks("Obergefreiter Max Gefreiter Otto"), QStringList({"Obergefreiter Max", "Gefreiter Otto"}));
+        QCOMPARE(parser.splitAtRanks("Hawk Gefr Otto"), QStringList({"Hawk Gefr Otto"}));
+        QCOMPARE(parser.splitAtRanks("fähnrich Anna Fähnrich Berta"), QStringList({"fähnrich Anna", "Fähnrich Berta"}));
+        QVERIFY(parser.splitAtRanks("   ").isEmpty());
+
+        QCOMPARE(parser.splitNames("GefrBuddy eiben"), QStringList({"GefrBuddy", "eiben"}));
+        QCOMPARE(parser.splitNames("Buddy Eiben"), QStringList({"Buddy", "Eiben"}));
+        QCOMPARE(parser.splitNames("Max A"), QStringList({"Max A"}));
+        // Ein einzelner Rang bleibt am Namen
+        QCOMPARE(parser.splitNames("Gefr Anton"), QStringList({"Gefr Anton"}));
+        QCOMPARE(parser.splitNames("Gefr Anton Bert"), QStringList({"Gefr Anton", "Bert"}));
+
+        // Ohne Ränge wird nur am Leerraum getrennt
+        const RosterTextParser plain;
+        QCOMPARE(plain.splitAtRanks("Gefr Anton Uffz Bert"), QStringList({"Gefr Anton Uffz Bert"}));
+    }
+
+    void test_candidate_normalization_and_fallback()
+    {
+        QCOMPARE(RosterTextParser::normalizeName("  Anton\t\tBerg  "), QStringLiteral("Anton Berg"));
+        QVERIFY(RosterTextParser::normalizeName(" ab ").isEmpty());
+        QVERIFY(RosterTextParser::normalizeName(QString(49, QLatin1Char('x'))).isEmpty());
+        QCOMPARE(RosterTextParser::normalizeName(QString(48, QLatin1Char('x'))).size(), 48);
+
+        // Ohne Abschnitte zählt jede Zeile, Aufzählungen mit Komma einzeln
+        const RosterTextParser parser(ranks());
+        const RosterTextParser::Result r = parser.parse(QStringLiteral("Anton, Bert,Carl\r\n\r\n  Gefr Dora Uffz Emil \nAnton\n"));
+        QCOMPARE(r.candidates, QStringList({"Anton", "Bert", "Carl", "Gefr Dora", "Uffz Emil"}));
+        QVERIFY(r.accepted.isEmpty());
+        QCOMPARE(r.kinds.size(), 3);
+
+        // Abschnitte ohne brauchbaren Namen ("Al", "Bo" zu kurz): alle Zeilen
+        const RosterTextParser::Result shortNames = parser.parse(QStringList({"Anton", "Akzeptiert (1)", "Al Bo"}));
+        QCOMPARE(shortNames.accepted, QStringList({"Al Bo"}));
+        QCOMPARE(shortNames.candidates, QStringList({"Anton"}));
+    }
+
+    void test_headers_are_case_insensitive()
+    {
+        QCOMPARE(RosterTextParser::sectionOf("AKZEPTIERT (3)"), int(RosterTextParser::Accepted));
+        QCOMPARE(RosterTextParser::sectionOf("✅ Tank(1)"), int(RosterTextParser::Tank));
+        QCOMPARE(RosterTextParser::sectionOf("abgelehnt ( 2)"), -1);
+        QCOMPARE(RosterTextParser::sectionOf("Abgelehnt"), -1);
+        QCOMPARE(RosterTextParser::sectionHeader(RosterTextParser::Rejected), QStringLiteral("Abgelehnt"));
+    }
+
+    void benchmark_corpus()
+    {
+        QList<QStringList> corpus;
+        int expected = 0;
+        for (int i = 0; i < 200; ++i)
+        {
+            corpus << screenshot(i, 60);
+            expected += 60 + 60 / 5;
+        }
+        const RosterTextParser parser(ranks());
+        int candidates = 0;
+        QBENCHMARK
+        {
+            candidates = 0;
+            for (const QStringList &lines : std::as_const(corpus))
+                candidates += parser.parse(lines).candidates.size();
+        }
+        QCOMPARE(candidates, expected);
+    }
+};
+QTEST_MAIN(TestRosterTextParser)
+#include "test_rostertextparser.moc"
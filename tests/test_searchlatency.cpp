@@ -0,0 +1,105 @@
+#include <QtTest/QtTest>
+#include "MainWindow.h"
+#include <QLineEdit>
+#include <QTableView>
+
+class TestSearchLatency : public QObject
+{
+    Q_OBJECT
+private:
+    static void fill(MainWindow &w, int count)
+    {
+        const QStringList stems = {"Kaiser", "Kaiserin", "Kai", "Otto", "Bruno", "Ludwig"};
+        for (int i = 0; i < count; ++i)
+        {
+            Player p;
+            p.name = QStringLiteral("%1_%2").arg(stems.at(i % stems.size())).arg(i);
+            p.t17name = QStringLiteral("t17_%1").arg(i);
+            p.group = (i % 3 == 0) ? "Fennek" : "Panther";
+            w.testAddPlayer(p);
+        }
+        w.testRebuildModel();
+    }
+
+    // Ein Tastendruck bis zum fertig gezeichneten Viewport
+    static void typeAndPaint(MainWindow &w, QLineEdit *edit, QTableView *view, char key)
+    {
+        QTest::keyClick(edit, key);
+        w.flushPendingSearch();
+        view->viewport()->repaint();
+    }
+
+private slots:
+    void initTestCase()
+    {
+        QStandardPaths::setTestModeEnabled(true);
+    }
+
+    void test_refinement_matches_full_pass()
+    {
+        MainWindow w;
+        fill(w, 600);
+        QLineEdit *edit = w.findChild<QLineEdit *>("searchEdit");
+        QVERIFY(edit);
+        const int all = w.visiblePlayerCount();
+
+        QTest::keyClicks(edit, "kai");
+        w.flushPendingSearch();
+        QCOMPARE(w.visiblePlayerCount(), 300);
+        QTest::keyClicks(edit, "ser");
+        w.flushPendingSearch();
+        QCOMPARE(w.visiblePlayerCount(), 200);
+        QTest::keyClicks(edit, "in");
+        w.flushPendingSearch();
+        QCOMPARE(w.visiblePlayerCount(), 100);
+
+        // Kein Verlängern: voller Durchlauf
+        edit->setText("otto");
+        w.flushPendingSearch();
+        QCOMPARE(w.visiblePlayerCount(), 100);
+        edit->clear();
+        QCOMPARE(w.visiblePlayerCount(), all);
+    }
+
+    void test_keystrokes_are_debounced()
+    {
+        MainWindow w;
+        fill(w, 60);
+        w.setSearchDebounceInterval(10000);
+        QLineEdit *edit = w.findChild<QLineEdit *>("searchEdit");
+        QVERIFY(edit);
+        const int all = w.visiblePlayerCount();
+
+        QTest::keyClicks(edit, "bruno");
+        QCOMPARE(w.visiblePlayerCount(), all);
+        w.flushPendingSearch();
+        QCOMPARE(w.visiblePlayerCount(), 10);
+
+        w.setSearchDebounceInterval(0);
+        QTest::keyClick(edit, '_');
+        QTRY_COMPARE(w.visiblePlayerCount(), 10);
+    }
+
+    void benchmark_keystroke_to_paint()
+    {
+        MainWindow w;
+        fill(w, 3000);
+        w.show();
+        QVERIFY(QTest::qWaitForWindowExposed(&w));
+        QLineEdit *edit = w.findChild<QLineEdit *>("searchEdit");
+        QTableView *view = w.findChild<QTableView *>("playerTable");
+        QVERIFY(edit && view);
+
+        // Tipp-Pause ausgeklammert: gemessen wird Filtern plus Zeichnen
+        QBENCHMARK
+        {
+            for (char key : QByteArray("kaiser"))
+                typeAndPaint(w, edit, view, key);
+            edit->clear();
+            view->viewport()->repaint();
+        }
+        QCOMPARE(w.visiblePlayerCount(), 3000);
+    }
+};
+QTEST_MAIN(TestSearchLatency)
+#include "test_searchlatency.moc"
@@ -0,0 +1,117 @@
+#include <QtTest/QtTest>
+#include "SoldbuchLog.h"
+#include <QTemporaryDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+class TestSoldbuchLog : public QObject
+{
+    Q_OBJECT
+private:
+    static QJsonObject entry(const QString &kind, int value)
+    {
+        QJsonObject obj;
+        obj.insert("kind", kind);
+        obj.insert("value", value);
+        return obj;
+    }
+
+private slots:
+    void test_append_reopen_and_slice()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        SoldbuchLog log;
+        log.setPaths(dir.filePath("sb.jsonl"), dir.filePath("sb.idx"));
+        QVERIFY(log.open());
+        QVERIFY(log.append("Alpha", entry("Comment", 1)));
+        QVERIFY(log.append("Bravo", entry("Comment", 2)));
+        QVERIFY(log.append("Alpha", entry("Promotion", 3)));
+
+        SoldbuchLog reopened;
+        reopened.setPaths(dir.filePath("sb.jsonl"), dir.filePath("sb.idx"));
+        QVERIFY(reopened.open());
+        QCOMPARE(reopened.playerCount(), 2);
+        QCOMPARE(reopened.entryCount("Alpha"), 2);
+        const QList<QJsonObject> alpha = reopened.entriesFor("Alpha");
+        QCOMPARE(alpha.size(), 2);
+        QCOMPARE(alpha.at(0).value("value").toInt(), 1);
+        QCOMPARE(alpha.at(1).value("kind").toString(), QStringLiteral("Promotion"));
+        QVERIFY(reopened.entriesFor("Charlie").isEmpty());
+    }
+
+    void test_rebuilds_missing_index_and_drops_torn_line()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        {
+            SoldbuchLog log;
+            log.setPaths(dir.filePath("sb.jsonl"), dir.filePath("sb.idx"));
+            QVERIFY(log.open());
+            QVERIFY(log.append("Alpha", entry("Comment", 1)));
+            QVERIFY(log.append("Bravo", entry("Comment", 2)));
+        }
+        QVERIFY(QFile::remove(dir.filePath("sb.idx")));
+        {
+            QFile f(dir.filePath("sb.jsonl"));
+            QVERIFY(f.open(QIODevice::WriteOnly | QIODevice::Append));
+            f.write("{\"player\":\"Alpha\",\"entry\":{\"ki");
+        }
+
+        SoldbuchLog log;
+        log.setPaths(dir.filePath("sb.jsonl"), dir.filePath("sb.idx"));
+        QVERIFY(log.open());
+        QCOMPARE(log.entryCount("Alpha"), 1);
+        QCOMPARE(log.entryCount("Bravo"), 1);
+        QVERIFY(log.append("Alpha", entry("Comment", 4)));
+        QCOMPARE(log.entriesFor("Alpha").last().value("value").toInt(), 4);
+    }
+
+    void test_migrates_legacy_json_once()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        QJsonObject root;
+        root.insert("Alpha", QJsonArray{entry("Comment", 1), entry("Comment", 2)});
+        {
+            QFile f(dir.filePath("legacy.json"));
+            QVERIFY(f.open(QIODevice::WriteOnly));
+            f.write(QJsonDocument(root).toJson());
+        }
+        SoldbuchLog log;
+        log.setPaths(dir.filePath("sb.jsonl"), dir.filePath("sb.idx"), dir.filePath("legacy.json"));
+        QVERIFY(log.open());
+        QCOMPARE(log.entryCount("Alpha"), 2);
+        QVERIFY(!QFile::exists(dir.filePath("legacy.json")));
+        QVERIFY(QFile::exists(dir.filePath("legacy.json.migrated")));
+
+        // Nach clear() und ohne Index darf das alte JSON nicht erneut kommen
+        QVERIFY(log.clear());
+        QVERIFY(QFile::remove(dir.filePath("sb.idx")));
+        QVERIFY(log.open());
+        QCOMPARE(log.playerCount(), 0);
+    }
+
+    void test_clear_removes_unmigrated_legacy_json()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        SoldbuchLog log;
+        log.setPaths(dir.filePath("sb.jsonl"), dir.filePath("sb.idx"), dir.filePath("legacy.json"));
+        QVERIFY(log.open());
+        // Erscheint erst nach dem ersten Start, wird also nie übernommen
+        {
+            QFile f(dir.filePath("legacy.json"));
+            QVERIFY(f.open(QIODevice::WriteOnly));
+            f.write(QJsonDocument(QJsonObject{{"Alpha", QJsonArray{entry("Comment", 1)}}}).toJson());
+        }
+        QVERIFY(log.clear());
+        QVERIFY(!QFile::exists(dir.filePath("legacy.json")));
+        QVERIFY(QFile::remove(dir.filePath("sb.idx")));
+        QVERIFY(log.open());
+        QCOMPARE(log.playerCount(), 0);
+    }
+};
+QTEST_MAIN(TestSoldbuchLog)
+#include "test_soldbuchlog.moc"
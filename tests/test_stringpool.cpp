@@ -0,0 +1,63 @@
+#include <QtTest/QtTest>
+#include "StringPool.h"
+#include "AttendanceRecord.h"
+#include "Player.h"
+#include <QtConcurrent/QtConcurrentRun>
+
+class TestStringPool : public QObject
+{
+    Q_OBJECT
+private slots:
+    void test_same_text_same_id()
+    {
+        Player a;
+        Player b;
+        a.group = "Fennek";
+        b.group = QStringLiteral("Fen") + QStringLiteral("nek");
+        QCOMPARE(a.group.id(), b.group.id());
+        QVERIFY(a.group == b.group);
+        QCOMPARE(a.group.toString(), QStringLiteral("Fennek"));
+
+        b.group = "Fenriswolf";
+        QVERIFY(a.group != b.group);
+        QVERIFY(Symbol().isEmpty());
+        QCOMPARE(Symbol(QString()).id(), 0u);
+    }
+
+    void test_case_folding()
+    {
+        const Symbol upper("Gefreiter");
+        const Symbol lower("gefreiter");
+        QVERIFY(upper != lower);
+        QVERIFY(upper.equalsIgnoreCase(lower));
+        QVERIFY(!upper.equalsIgnoreCase(Symbol("Obergefreiter")));
+        QCOMPARE(StringPool::instance().find(QStringLiteral("kein-solcher-text-xyz")), StringPool::NotFound);
+    }
+
+    void test_fixed_attendance_types()
+    {
+        QCOMPARE(Symbol("training").id(), quint32(AttendanceRecord::Training));
+        QCOMPARE(Symbol("event").id(), quint32(AttendanceRecord::Event));
+        QCOMPARE(Symbol("reserve").id(), quint32(AttendanceRecord::Reserve));
+    }
+
+    void test_concurrent_interning()
+    {
+        auto work = [](int offset)
+        {
+            QVector<quint32> ids;
+            for (int i = 0; i < 500; ++i)
+                ids.append(Symbol(QStringLiteral("Trupp%1").arg((i + offset) % 50)).id());
+            return ids;
+        };
+        QFuture<QVector<quint32>> f1 = QtConcurrent::run(work, 0);
+        QFuture<QVector<quint32>> f2 = QtConcurrent::run(work, 25);
+        const QVector<quint32> a = f1.result();
+        const QVector<quint32> b = f2.result();
+        for (int i = 0; i < 50; ++i)
+            QCOMPARE(Symbol(QStringLiteral("Trupp%1").arg(i)).id(), a.at(i));
+        QCOMPARE(a.at(25), b.at(0));
+    }
+};
+QTEST_MAIN(TestStringPool)
+#include "test_stringpool.moc"